@@ -1,2273 +1,2627 @@
-#include <iostream>         // cout, cerr
-#include <cstdlib>          // EXIT_FAILURE
-#include <GL/glew.h>        // GLEW library
-#include <GLFW/glfw3.h>     // GLFW library
-
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"   // Image loading Utility functions
-
-// GLM Math Header inclusions
-#include <glm/glm.hpp>
-#include <glm/gtx/transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include <../learnOpengl/camera.h>
-
-using namespace std; // Uses the standard namespace
-
-/*Shader program Macro*/
-#ifndef GLSL
-#define GLSL(Version, Source) "#version " #Version " core \n" #Source
-#endif
-
-// Unnamed namespace
-namespace
-{
-	const char* const WINDOW_TITLE = "Lighting Test"; // Macro for window title
-
-	// Variables for window width and height
-	const int WINDOW_WIDTH = 1800;
-	const int WINDOW_HEIGHT = 900;
-
-
-	const double M_PI = 3.14159265358979323846f;
-	const double M_PI_2 = 1.571428571428571;
-	// Stores the GL data relative to a given mesh
-	struct GLMesh
-	{
-		GLuint vao;
-		GLuint vbo; // Handle for the vertex array object
-		GLuint vbos[2];     // Handles for the vertex buffer objects
-		GLuint nVertices;   // Number of vertices of the mesh
-		GLuint nIndices;
-	};
-
-	// Main GLFW window
-	GLFWwindow* gWindow = nullptr;
-	// Triangle mesh data
-	GLMesh gTablePlaneMesh; // for plane
-	GLMesh gPyramidMesh; // for Lights 
-	GLMesh gCubeAMesh; // Cube A for Handle 
-	GLMesh gCubeBMesh; // for carving fork 
-	GLMesh gCuttingBoardMesh; // for Cutting Board
-	GLMesh gPrismAMesh;
-	GLMesh gProngBMesh; // For Carving Fork 
-	GLMesh gProngCMesh; // FOr Carving Fork 
-	GLMesh gBowlMesh; // For Bowl
-	GLMesh gCubeCMesh; // For Bowl
-	GLMesh gSauceMesh; // For Sauce
-	GLMesh gTurkeyAMesh; // for turkey body 
-	
-
-	// Shader program
-	GLuint gProgramId;
-	GLuint gSurfaceProgramId;
-	GLuint gLightProgramId;
-	Camera gCameraFront(glm::vec3(-0.5f, 3.5f, 9.0f));
-	Camera* g_pCurrentCamera = NULL;
-	// Texture
-	GLuint gTableTextureId, gPyramidTextureId, gCubeATextureId, gCubeBTextureId, gCuttingBoardTextureId, gPrismATextureId, 
-		gProngBTextureId, gProngCTextureId, gBowlTextureId, gCubeCTextureId, gSauceTextureId, gTurkeyATextureId;
-	glm::vec2 gUVScale(1.0f, 1.0f);
-	GLint gTexWrapMode = GL_REPEAT;
-	
-
-	float gLastX = WINDOW_WIDTH / 2.0f;
-	float gLastY = WINDOW_HEIGHT / 2.0f;
-	float gDeltaTime = 0.0f;
-	float gLastFrame = 0.0f;
-	bool perspective = false; 
-	bool gFirstMouse = true;
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////
-/* Surface Vertex Shader Source Code*/
-const GLchar* surfaceVertexShaderSource = GLSL(440,
-
-	layout(location = 0) in vec3 vertexPosition; // VAP position 0 for vertex position data
-layout(location = 1) in vec3 vertexNormal; // VAP position 1 for normals
-layout(location = 2) in vec2 textureCoordinate;
-
-out vec3 vertexFragmentNormal; // For outgoing normals to fragment shader
-out vec3 vertexFragmentPos; // For outgoing color / pixels to fragment shader
-out vec2 vertexTextureCoordinate;
-
-//Uniform / Global variables for the  transform matrices
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-	gl_Position = projection * view * model * vec4(vertexPosition, 1.0f); // Transforms vertices into clip coordinates
-
-	vertexFragmentPos = vec3(model * vec4(vertexPosition, 1.0f)); // Gets fragment / pixel position in world space only (exclude view and projection)
-
-	vertexFragmentNormal = mat3(transpose(inverse(model))) * vertexNormal; // get normal vectors in world space only and exclude normal translation properties
-	vertexTextureCoordinate = textureCoordinate;
-}
-);
-////////////////////////////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////////////
-/* Surface Fragment Shader Source Code*/
-const GLchar* surfaceFragmentShaderSource = GLSL(440,
-
-	in vec3 vertexFragmentNormal; // For incoming normals
-in vec3 vertexFragmentPos; // For incoming fragment position
-in vec2 vertexTextureCoordinate;
-
-out vec4 fragmentColor; // For outgoing cube color to the GPU
-
-// Uniform / Global variables for object color, light color, light position, and camera/view position
-uniform vec3 objectColor;
-uniform vec3 ambientColor;
-uniform vec3 light1Color;
-uniform vec3 light1Position;
-uniform vec3 light2Color;
-uniform vec3 light2Position;
-uniform vec3 viewPosition;
-uniform sampler2D uTexture; // Useful when working with multiple textures
-uniform vec2 uvScale;
-uniform float ambientStrength = 0.05f; // Set ambient or global lighting strength
-uniform float specularIntensity = 0.1f;
-uniform float highlightSize = 16.0f;
-
-void main()
-{
-	/*Phong lighting model calculations to generate ambient, diffuse, and specular components*/
-
-	//Calculate Ambient lighting
-	vec3 ambient = ambientStrength * ambientColor; // Generate ambient light color
-
-	//**Calculate Diffuse lighting**
-	vec3 norm = normalize(vertexFragmentNormal); // Normalize vectors to 1 unit
-	vec3 light1Direction = normalize(light1Position - vertexFragmentPos); // Calculate distance (light direction) between light source and fragments/pixels on cube
-	float impact1 = max(dot(norm, light1Direction), -.9);// Calculate diffuse impact by generating dot product of normal and light
-	vec3 diffuse1 = impact1 * light1Color; // Generate diffuse light color
-	vec3 light2Direction = normalize(light2Position - vertexFragmentPos); // Calculate distance (light direction) between light source and fragments/pixels on cube
-	float impact2 = max(dot(norm, light2Direction), .3);// Calculate diffuse impact by generating dot product of normal and light
-	vec3 diffuse2 = impact2 * light2Color; // Generate diffuse light color
-
-	//**Calculate Specular lighting**
-	vec3 viewDir = normalize(viewPosition - vertexFragmentPos); // Calculate view direction
-	vec3 reflectDir1 = reflect(-light1Direction, norm);// Calculate reflection vector
-	//Calculate specular component
-	float specularComponent1 = pow(max(dot(viewDir, reflectDir1), 0.4), highlightSize);
-	vec3 specular1 = specularIntensity * specularComponent1 * light1Color;
-	vec3 reflectDir2 = reflect(-light2Direction, norm);// Calculate reflection vector
-	//Calculate specular component
-	float specularComponent2 = pow(max(dot(viewDir, reflectDir2), 0.1), highlightSize);
-	vec3 specular2 = specularIntensity * specularComponent2 * light2Color;
-
-	//**Calculate phong result**
-	//Texture holds the color to be used for all three components
-	vec4 textureColor = texture(uTexture, vertexTextureCoordinate * uvScale);
-	vec3 phong1 = (ambient + diffuse1 + specular1) * textureColor.xyz; //objectColor;
-	vec3 phong2 = (ambient + diffuse2 + specular2) * textureColor.xyz; //objectColor;
-
-	fragmentColor = vec4(phong1 + phong2, 8.0); // Send lighting results to GPU
-}
-);
-/////////////////////////////////////////////////////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////////////////////
-/* Light Object Shader Source Code*/
-const GLchar* lightVertexShaderSource = GLSL(330,
-	layout(location = 0) in vec3 aPos;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-	gl_Position = projection * view * model * vec4(aPos, 1.0);
-}
-);
-/////////////////////////////////////////////////////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////////////////////
-/* Light Object Shader Source Code*/
-const GLchar* lightFragmentShaderSource = GLSL(330,
-	out vec4 FragColor;
-
-void main()
-{
-	FragColor = vec4(0.4); // set all 4 vector values to 1.0
-}
-);
-/////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-/* User-defined Function prototypes to:
- * initialize the program, set the window size,
- * redraw graphics on the window when resized,
- * and render graphics on the screen
- */
-bool UInitialize(int, char* [], GLFWwindow** window);
-void UResizeWindow(GLFWwindow* window, int width, int height);
-void UProcessInput(GLFWwindow* window);
-void UMousePositionCallBack(GLFWwindow* window, double xpos, double ypos);
-void UMouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
-void UMouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
-void UCreateTablePlaneMesh(GLMesh& mesh);
-void UCreatePyramidMesh(GLMesh& mesh);
-void UCreateCubeMesh(GLMesh& mesh); 
-void UCreatePrismMesh(GLMesh& mesh);
-void UCreatePyramidsMesh(GLMesh& mesh); 
-void UCreateTorusMesh(GLMesh& mesh);
-void UCreateSphereMesh(GLMesh& mesh);
-void URender();
-void UDestroyMesh(GLMesh& mesh);
-bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId);
-void UDestroyShaderProgram(GLuint programId);
-bool UCreateTexture(const char* filename, GLuint& textureId);
-void UDestroyTexture(GLuint textureId);
-
-// main function. Entry point to the OpenGL program
-int main(int argc, char* argv[])
-{
-	if (!UInitialize(argc, argv, &gWindow))
-		return EXIT_FAILURE;
-
-	// Create the mesh
-	UCreateTablePlaneMesh(gTablePlaneMesh); // Calls the function to create the Vertex Buffer Object
-	UCreatePyramidMesh(gPyramidMesh);
-	UCreateCubeMesh(gCubeAMesh);
-	UCreateCubeMesh(gCubeBMesh); 
-	UCreateCubeMesh(gCuttingBoardMesh);
-	UCreatePrismMesh(gPrismAMesh);
-	UCreatePrismMesh(gProngBMesh);
-	UCreatePrismMesh(gProngCMesh);
-	UCreateTorusMesh(gBowlMesh);
-	UCreateCubeMesh(gCubeCMesh); 
-	UCreateSphereMesh(gSauceMesh); 
-	UCreateSphereMesh(gTurkeyAMesh); 
-	
-	
-
-
-	// Create the shader program
-	if (!UCreateShaderProgram(surfaceVertexShaderSource, surfaceFragmentShaderSource, gSurfaceProgramId))
-		return EXIT_FAILURE;
-
-	if (!UCreateShaderProgram(lightVertexShaderSource, lightFragmentShaderSource, gLightProgramId))
-		return EXIT_FAILURE;
-
-	// Load texture
-	const char* texFilename = "tablePlane.png";
-	if (!UCreateTexture(texFilename, gTableTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-		return EXIT_FAILURE;
-	}
-	texFilename = "wood.png"; 
-	if (!UCreateTexture(texFilename, gCubeATextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-		return EXIT_FAILURE;
-	}
-	texFilename = "this.png"; 
-	if (!UCreateTexture(texFilename, gCubeBTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-		return EXIT_FAILURE;
-	}
-	texFilename = "stone.png";
-	if (!UCreateTexture(texFilename, gCuttingBoardTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-		return EXIT_FAILURE;
-	}
-	texFilename = "this.png"; 
-	if (!UCreateTexture(texFilename, gPrismATextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-		return EXIT_FAILURE;
-	}
-	texFilename = "this.png"; 
-	if (!UCreateTexture(texFilename, gProngBTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-		return EXIT_FAILURE;
-	}
-	texFilename = "this.png";
-	if (!UCreateTexture(texFilename, gProngCTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-		return EXIT_FAILURE;
-	}
-	texFilename = "clay.png";
-	if (!UCreateTexture(texFilename, gBowlTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-		return EXIT_FAILURE;
-	}
-	texFilename = "handle.png";
-	if (!UCreateTexture(texFilename, gCubeCTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-		return EXIT_FAILURE;
-	}
-	texFilename = "sauce.png";
-	if (!UCreateTexture(texFilename, gSauceTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-		return EXIT_FAILURE;
-	}
-	texFilename = "tbskin.png"; 
-	if (!UCreateTexture(texFilename, gTurkeyATextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-		return EXIT_FAILURE;
-	}
-	
-	
-	
-	// tell opengl for each sampler to which texture unit it belongs to (only has to be done once)
-	glUseProgram(gSurfaceProgramId);
-	// We set the texture as texture unit 0
-
-
-	// Sets the background color of the window to black (it will be implicitely used by glClear)
-	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-
-	gCameraFront.Front = glm::vec3(0.0, -1.0, -1.0f);
-	gCameraFront.Up = glm::vec3(0.0, 0.0, 0.0);
-	g_pCurrentCamera = &gCameraFront;
-
-	// render loop
-	// -----------
-	while (!glfwWindowShouldClose(gWindow))
-	{
-		// per-frame timing
-		// --------------------
-		float currentFrame = glfwGetTime();
-		gDeltaTime = currentFrame - gLastFrame;
-		gLastFrame = currentFrame;
-
-		// Texture
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, gTableTextureId); 
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, gCubeATextureId);
-		glActiveTexture(GL_TEXTURE2);
-		glBindTexture(GL_TEXTURE_2D, gCubeBTextureId);
-		glActiveTexture(GL_TEXTURE3);
-		glBindTexture(GL_TEXTURE_2D, gCuttingBoardTextureId);
-		glActiveTexture(GL_TEXTURE4);
-		glBindTexture(GL_TEXTURE_2D, gPrismATextureId);
-		glActiveTexture(GL_TEXTURE5);
-		glBindTexture(GL_TEXTURE_2D, gProngBTextureId);
-		glActiveTexture(GL_TEXTURE6);
-		glBindTexture(GL_TEXTURE_2D, gProngCTextureId);
-		glActiveTexture(GL_TEXTURE7);
-		glBindTexture(GL_TEXTURE_2D, gBowlTextureId);
-		glActiveTexture(GL_TEXTURE8);
-		glBindTexture(GL_TEXTURE_2D, gCubeCTextureId);
-		glActiveTexture(GL_TEXTURE9);
-		glBindTexture(GL_TEXTURE_2D, gSauceTextureId);
-		glActiveTexture(GL_TEXTURE11);
-		glBindTexture(GL_TEXTURE_2D, gTurkeyATextureId);
-		
-		
-		
-		
-		
-		
-
-		// input
-		// -----
-		UProcessInput(gWindow);
-
-		URender();
-
-		glfwPollEvents();
-	}
-
-	// Release mesh data
-	UDestroyMesh(gTablePlaneMesh);
-	UDestroyMesh(gPyramidMesh);
-	UDestroyMesh(gCubeAMesh);
-	UDestroyMesh(gCubeBMesh);
-	UDestroyMesh(gCuttingBoardMesh);
-	UDestroyMesh(gPrismAMesh);
-	UDestroyMesh(gProngBMesh);
-	UDestroyMesh(gProngCMesh);
-	UDestroyMesh(gBowlMesh);
-	UDestroyMesh(gCubeCMesh);
-	UDestroyMesh(gSauceMesh);
-	UDestroyMesh(gTurkeyAMesh);
-	
-	
-	
-	
-	
-	
-
-	UDestroyShaderProgram(gSurfaceProgramId);
-	UDestroyShaderProgram(gLightProgramId);
-	
-
-	exit(EXIT_SUCCESS); // Terminates the program successfully
-}
-
-
-// Initialize GLFW, GLEW, and create a window
-bool UInitialize(int argc, char* argv[], GLFWwindow** window)
-{
-	// GLFW: initialize and configure
-	// ------------------------------
-	glfwInit();
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-#ifdef __APPLE__
-	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
-
-	// GLFW: window creation
-	// ---------------------
-	* window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE, NULL, NULL);
-	if (*window == NULL)
-	{
-		std::cout << "Failed to create GLFW window" << std::endl;
-		glfwTerminate();
-		return false;
-	}
-	glfwMakeContextCurrent(*window);  // Make context current for calling thread
-	glfwSetFramebufferSizeCallback(*window, UResizeWindow);
-	glfwSetCursorPosCallback(*window, UMousePositionCallBack);
-	glfwSetScrollCallback(*window, UMouseScrollCallback);
-	glfwSetInputMode(*window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-
-	// GLEW: initialize
-	// ----------------
-	// Note: if using GLEW version 1.13 or earlier
-	glewExperimental = GL_TRUE;
-	GLenum GlewInitResult = glewInit();
-
-	if (GLEW_OK != GlewInitResult)
-	{
-		std::cerr << glewGetErrorString(GlewInitResult) << std::endl;
-		return false;
-	}
-
-	// Displays GPU OpenGL version
-	cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << endl;
-
-	return true;
-}
-
-
-// process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
-void UProcessInput(GLFWwindow* window)
-{
-	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-		glfwSetWindowShouldClose(window, true);
-
-	if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-		g_pCurrentCamera->ProcessKeyboard(FORWARD, gDeltaTime);
-	if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-		g_pCurrentCamera->ProcessKeyboard(BACKWARD, gDeltaTime);
-	if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-		g_pCurrentCamera->ProcessKeyboard(LEFT, gDeltaTime);
-	if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-		g_pCurrentCamera->ProcessKeyboard(RIGHT, gDeltaTime);
-
-	float velocity = g_pCurrentCamera->MovementSpeed * gDeltaTime;
-	if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS)
-		g_pCurrentCamera->Position -= g_pCurrentCamera->Up * velocity;
-	if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS)
-		g_pCurrentCamera->Position += g_pCurrentCamera->Up * velocity;
-}
-
-
-// glfw: whenever the window size changed (by OS or user resize) this callback function executes
-void UResizeWindow(GLFWwindow* window, int width, int height)
-{
-	glViewport(0, 0, width, height);
-}
-void UMousePositionCallBack(GLFWwindow* window, double xpos, double ypos)
-{
-	if (gFirstMouse)
-	{
-		gLastX = xpos;
-		gLastY = ypos;
-		gFirstMouse = false;
-	}
-
-	float xoffset = xpos - gLastX;
-	float yoffset = gLastY - ypos; // reversed since y-coordinates go from bottom to top
-
-	gLastX = xpos;
-	gLastY = ypos;
-
-	g_pCurrentCamera->ProcessMouseMovement(xoffset, yoffset);
-}
-
-void UMouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset)
-{
-	g_pCurrentCamera->ProcessMouseScroll(yoffset);
-}
-
-
-
-void URender()
-{
-	GLint modelLoc;
-	GLint viewLoc;
-	GLint projLoc;
-	GLint viewPosLoc;
-	GLint ambStrLoc;
-	GLint ambColLoc;
-	GLint light1ColLoc;
-	GLint light1PosLoc;
-	GLint light2ColLoc;
-	GLint light2PosLoc;
-	GLint objColLoc;
-	GLint specIntLoc;
-	GLint highlghtSzLoc;
-	glm::mat4 scale;
-	glm::mat4 rotation;
-	glm::mat4 translation;
-	glm::mat4 model;
-	glm::mat4 view;
-	glm::mat4 projection;
-
-	// Clear the background
-	glEnable(GL_DEPTH_TEST);
-	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-	view = g_pCurrentCamera->GetViewMatrix();
-	projection = glm::perspective(glm::radians(g_pCurrentCamera->Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
-
-	// Set the shader to be used
-	glUseProgram(gSurfaceProgramId);
-
-	// Retrieves and passes transform matrices to the Shader program
-	modelLoc = glGetUniformLocation(gSurfaceProgramId, "model");
-	viewLoc = glGetUniformLocation(gSurfaceProgramId, "view");
-	projLoc = glGetUniformLocation(gSurfaceProgramId, "projection");
-	viewPosLoc = glGetUniformLocation(gSurfaceProgramId, "viewPosition");
-	ambStrLoc = glGetUniformLocation(gSurfaceProgramId, "ambientStrength");
-	ambColLoc = glGetUniformLocation(gSurfaceProgramId, "ambientColor");
-	light1ColLoc = glGetUniformLocation(gSurfaceProgramId, "light1Color");
-	light1PosLoc = glGetUniformLocation(gSurfaceProgramId, "light1Position");
-	light2ColLoc = glGetUniformLocation(gSurfaceProgramId, "light2Color");
-	light2PosLoc = glGetUniformLocation(gSurfaceProgramId, "light2Position");
-	objColLoc = glGetUniformLocation(gSurfaceProgramId, "objectColor");
-	specIntLoc = glGetUniformLocation(gSurfaceProgramId, "specularIntensity");
-	highlghtSzLoc = glGetUniformLocation(gSurfaceProgramId, "highlightSize");
-
-	glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-	glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-
-	//set the camera view location
-	glUniform3f(viewPosLoc, g_pCurrentCamera->Position.x, g_pCurrentCamera->Position.y, g_pCurrentCamera->Position.z);
-	//set ambient lighting strength
-	glUniform1f(ambStrLoc, 0.3f);
-	//set ambient color
-	//AMB COLLOC BROWN
-	glUniform3f(ambColLoc,  0.5f, 0.5f, 0.5f); //
-	//brown
-	glUniform3f(light1ColLoc, 0.5f, 0.5f, 0.5f); //brown
-	glUniform3f(light1PosLoc, 1.5f, 1.0f, 1.0f); // white light from the left
-	glUniform3f(light2ColLoc, 1.0f, 1.0f, 1.0f); //  white
-	glUniform3f(light2PosLoc, 0.5f, 1.0f, 1.0f); 
-	//set specular intensity
-	glUniform1f(specIntLoc, 0.1f); //  
-	//set specular highlight size
-	glUniform1f(highlghtSzLoc, 4.0f);
-	glUniform2f(glGetUniformLocation(gSurfaceProgramId, "uvScale"), gUVScale.x, gUVScale.y);
-	////////////////////////////////////////////////////////////////////////////////////
-	//-----------------------Table Surface--------------------------------------------------//
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(gTablePlaneMesh.vao);
-	// 1. Scales the object by 2
-	scale = glm::scale(glm::vec3(5.0f, 2.5f, 5.0f));
-	// 2. Rotates shape by 15 degrees in the x axis
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Place object at the origin
-	translation = glm::translate(glm::vec3(0.0f, 0.0f, 0.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 0);
-	glBindTexture(GL_TEXTURE_2D, gTableTextureId);
-	glUniform3f(objColLoc, 0.5f, 0.5f, 0.5f);
-	glDrawArrays(GL_TRIANGLES, 0, gTablePlaneMesh.nVertices);
-	glBindVertexArray(0);
-	//--------------------------------------Cube A-----------------------------------------------//
-	glBindVertexArray(gCubeAMesh.vao); 
-
-	scale = glm::scale(glm::vec3(0.9f, .9f, 2.5f));
-	rotation = glm::rotate(0.0f, glm::vec3(1.7, 1.0f, 1.0f));
-	translation = glm::translate(glm::vec3(4.5f, 0.53f, 3.7f)); //
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE1);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 1);
-	glBindTexture(GL_TEXTURE_2D, gCubeATextureId);
-	glUniform3f(objColLoc, 1.0f, 1.0f, 1.0f); // white
-	glDrawArrays(GL_TRIANGLES, 0, gCubeAMesh.nVertices);
-	glBindVertexArray(0);
-
-	//--------------------------------------Cube B-----------------------------------------------//
-	glBindVertexArray(gCubeBMesh.vao);
-	scale = glm::scale(glm::vec3(0.9f, .3f, 2.5f));
-	rotation = glm::rotate(0.0f, glm::vec3(1.7, 1.0f, 1.0f));
-	translation = glm::translate(glm::vec3(4.5f, 0.4f, 1.3f)); //
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE2);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 2);
-	glBindTexture(GL_TEXTURE_2D, gCubeBTextureId);
-	glUniform3f(objColLoc, 1.0f, 1.0f, .8f); // white
-	glDrawArrays(GL_TRIANGLES, 0, gCubeBMesh.nVertices);
-	glBindVertexArray(0);
-	
-	// -------------------- Prisim A for carving fork-------------------------//
-	glBindVertexArray(gPrismAMesh.vao);
-	scale = glm::scale(glm::vec3(4.99f, 5.5f, 1.3f));
-	rotation = glm::rotate(10.5f, glm::vec3(1.0f, 1.0f, 1.0f));
-	translation = glm::translate(glm::vec3(9.49f, 1.47f, -1.54f)); //
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE4);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 4);
-	glBindTexture(GL_TEXTURE_2D, gPrismATextureId);
-	glUniform3f(objColLoc, 1.0f, 1.0f, 0.8f); // white
-	glDrawArrays(GL_TRIANGLES, 0, gPrismAMesh.nVertices);
-	glBindVertexArray(0);
-
-
-	//------------------------------prong A  ---------------------------------------////// 
-	glBindVertexArray(gProngBMesh.vao);
-	scale = glm::scale(glm::vec3(10.0, 1.4f, 0.8f));
-	rotation = glm::rotate(180.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	translation = glm::translate(glm::vec3(6.3f, 0.7f, -3.8f));
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE5);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 5);
-	glBindTexture(GL_TEXTURE_2D, gProngBTextureId);
-	glUniform3f(objColLoc, 1.0f, 1.0f, 0.8f); // white
-	glDrawArrays(GL_TRIANGLES, 0, gProngBMesh.nVertices);
-	glBindVertexArray(0);
-
-	//------------------------------Prong B---------------------------------------//////
-	glBindVertexArray(gProngCMesh.vao);
-	scale = glm::scale(glm::vec3(10.0, 1.4f, 0.8f));
-	rotation = glm::rotate(180.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	translation = glm::translate(glm::vec3(5.8f, 0.7f, -3.8f)); 
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE6);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 6);
-	glBindTexture(GL_TEXTURE_2D, gProngCTextureId);
-	glUniform3f(objColLoc, 1.0f, 1.0f, 0.6f); // white
-	glDrawArrays(GL_TRIANGLES, 0, gProngCMesh.nVertices);
-	glBindVertexArray(0);
-	
-	//----------------------------Sauce Bowl ---------------------------------------//
-	glBindVertexArray(gBowlMesh.vao);
-	scale = glm::scale(glm::vec3(1.0f, 1.0f, 4.0f));
-	rotation = glm::rotate(-4.0f, glm::vec3(-5.0f, -6.0f, -6.0f));
-	translation = glm::translate(glm::vec3(-3.0f, 0.5f, 3.0f)); //
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE7);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 7);
-	glBindTexture(GL_TEXTURE_2D, gBowlTextureId);
-	glUniform3f(objColLoc, 1.0f, 1.0f, 0.6f); // white
-	glDrawArrays(GL_TRIANGLES, 0, gBowlMesh.nVertices);
-	glBindVertexArray(0);
-	
-	//----------------------------Spoon -----------------------------------------//  
-	glBindVertexArray(gCubeCMesh.vao);
-	scale = glm::scale(glm::vec3(0.2f, 2.0f, 0.2f));
-	rotation = glm::rotate(-0.2f, glm::vec3(1.3f, 1.0f, 1.0f));
-	translation = glm::translate(glm::vec3(-3.0f, 1.3f, 3.0f)); //
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE8);
-	//BROWN
-	glUniform3f(objColLoc, 1.0f, 1.0f, 1.f); // 
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 8);
-	glBindTexture(GL_TEXTURE_2D, gCubeCTextureId);
-	glDrawArrays(GL_TRIANGLES, 0, gCubeCMesh.nVertices);
-	glBindVertexArray(0);
-	
-	//----------------------------Sauce ------------------------------------// 
-	glBindVertexArray(gSauceMesh.vao);
-	scale = glm::scale(glm::vec3(1.0f, 0.2f, 1.0f));
-	rotation = glm::rotate(-0.2f, glm::vec3(1.3f, 1.0f, 1.0f));
-	translation = glm::translate(glm::vec3(-3.0f, 0.6f, 3.0f)); //
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE9);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 9);
-	glBindTexture(GL_TEXTURE_2D, gSauceTextureId);
-	//RED
-	glUniform3f(objColLoc, 1.0f, 0.0f, 0.0f); // red
-	glDrawArrays(GL_TRIANGLES, 0, gSauceMesh.nVertices);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);    // bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36); // top 
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146); //sides
-	
-	glDrawElements(GL_TRIANGLES, gSauceMesh.nIndices, GL_UNSIGNED_INT, 0);
-	
-
-	glBindVertexArray(0);
-	
-	//-------------------------Turkey ------------------------------------//
-	glBindVertexArray(gTurkeyAMesh.vao);
-	scale = glm::scale(glm::vec3(2.0f, 1.5f, 6.0f));
-	rotation = glm::rotate(-0.2f, glm::vec3(1.3f, 1.0f, 1.0f));
-	translation = glm::translate(glm::vec3(2.0f, 0.6f, -2.2f)); //
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE10);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 10);
-	glBindTexture(GL_TEXTURE_2D, gTurkeyATextureId);
-	glUniform3f(objColLoc, 1.0f, 1.0f, 0.6f); // white
-	glDrawArrays(GL_TRIANGLES, 0, gTurkeyAMesh.nVertices);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);    // bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36); // top 
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146); //sides
-
-	glDrawElements(GL_TRIANGLES, gTurkeyAMesh.nIndices, GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
-	
-	//-------------------------Turkey ------------------------------------//
-	glBindVertexArray(gTurkeyAMesh.vao);
-	scale = glm::scale(glm::vec3(2.0f, 1.5f, 4.0f));
-	rotation = glm::rotate(-0.2f, glm::vec3(1.3f, 1.0f,-1.7f));
-	translation = glm::translate(glm::vec3(2.0f, 0.9f, -2.0f)); //
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE11);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 11);
-	glBindTexture(GL_TEXTURE_2D, gTurkeyATextureId);
-	glUniform3f(objColLoc, 1.0f, 1.0f, 0.6f); // white
-	glDrawArrays(GL_TRIANGLES, 0, gTurkeyAMesh.nVertices);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);    // bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36); // top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146); //sides
-		
-	glDrawElements(GL_TRIANGLES, gTurkeyAMesh.nIndices, GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
-
-	//------------------------TURKEY--------------------------// 
-	glBindVertexArray(gTurkeyAMesh.vao);
-	scale = glm::scale(glm::vec3(2.0f, 0.7f, 0.5f));
-	rotation = glm::rotate(0.9f, glm::vec3(-2.3f, -2.0f, 0.3f));
-	translation = glm::translate(glm::vec3(2.0f, 1.9f, -.3f)); //
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE12);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 11);
-	glBindTexture(GL_TEXTURE_2D, gTurkeyATextureId);
-	glUniform3f(objColLoc, 1.0f, 1.0f, 0.6f); // white
-	glDrawArrays(GL_TRIANGLES, 0, gTurkeyAMesh.nVertices);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);    // bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36); // top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146); //sides
-	
-	glDrawElements(GL_TRIANGLES, gTurkeyAMesh.nIndices, GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
-	//--------------------------------TURKEY---------------------------------//
-	glBindVertexArray(gTurkeyAMesh.vao);
-	scale = glm::scale(glm::vec3(2.0f, 0.7f, 0.5f));
-	rotation = glm::rotate(0.9f, glm::vec3(-2.3f, -2.0f, 0.3f));
-	translation = glm::translate(glm::vec3(3.0f, 0.6f, -.3f)); //
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE12);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 11);
-	glBindTexture(GL_TEXTURE_2D, gTurkeyATextureId);
-	glUniform3f(objColLoc, 1.0f, 1.0f, 0.6f); // white
-	glDrawArrays(GL_TRIANGLES, 0, gTurkeyAMesh.nVertices);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);    // bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36); // top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146); //sides
-
-	glDrawElements(GL_TRIANGLES, gTurkeyAMesh.nIndices, GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
-	
-	
-
-	
-	
-	
-
-	
-	// --------------------------------------Cutting Board ---------------------------------------// 
-	glBindVertexArray(gCuttingBoardMesh.vao);
-	scale = glm::scale(glm::vec3(5.9f, .1f, 8.0f));
-	rotation = glm::rotate(0.0f, glm::vec3(1.7, 1.0f, 1.0f));
-	translation = glm::translate(glm::vec3(2.0f, 0.0f, 0.7f)); //
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glActiveTexture(GL_TEXTURE3);
-	glUniform1i(glGetUniformLocation(gSurfaceProgramId, "uTexture"), 3);
-	glBindTexture(GL_TEXTURE_2D, gCuttingBoardTextureId);
-	glUniform3f(objColLoc, 1.0f, 0.0f, 1.0f); // white
-	glDrawArrays(GL_TRIANGLES, 0, gCuttingBoardMesh.nVertices);
-	glBindVertexArray(0);
-	
-
-	///////////////////////////////////////////////////////////////////////////////////////////
-	// Set the shader to be used
-	glUseProgram(gLightProgramId);
-
-	// Retrieves and passes transform matrices to the Shader program
-	modelLoc = glGetUniformLocation(gLightProgramId, "model");
-	viewLoc = glGetUniformLocation(gLightProgramId, "view");
-	projLoc = glGetUniformLocation(gLightProgramId, "projection");
-
-	glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-	glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-	//////////////////////////LIGHTS/////////////////////////////////////////////////////
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(gPyramidMesh.vao);
-	// 1. Scales the object by 2
-	scale = glm::scale(glm::vec3(1.0f, .1f, 1.0f));
-	// 2. Rotates shape by 15 degrees in the x axis
-	rotation = glm::rotate(-0.2f, glm::vec3(1.0, 0.0f, 0.0f));
-	// 3. Place object at the origin
-	translation = glm::translate(glm::vec3(.4f, 9.0f, -2.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-
-	//glDrawArrays(GL_TRIANGLES, 0, gPyramidMesh.nVertices);
-	glDrawElements(GL_TRIANGLES, gPyramidMesh.nIndices, GL_UNSIGNED_INT, NULL);
-
-	// 1. Scales the object by 2
-	scale = glm::scale(glm::vec3(2.0f, 2.0f, 2.0f));
-	// 2. Rotates shape by 15 degrees in the x axis
-	rotation = glm::rotate(-0.5f, glm::vec3(1.0, 0.0f, 0.0f));
-	// 3. Place object at the origin
-	translation = glm::translate(glm::vec3(0.9f, 9.0f, -1.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-
-	//glDrawArrays(GL_TRIANGLES, 0, gPyramidMesh.nVertices);
-	glDrawElements(GL_TRIANGLES, gPyramidMesh.nIndices, GL_UNSIGNED_INT, NULL);
-
-	glBindVertexArray(0);
-
-	glUseProgram(0);
-
-	// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
-	glfwSwapBuffers(gWindow);    // Flips the the back buffer with the front buffer every frame.
-}
-
-// Implements the UCreateMesh function
-void UCreateTablePlaneMesh(GLMesh& mesh)
-{
-	// Specifies Normalized Device Coordinates for triangle vertices
-	GLfloat verts[] =
-	{
-		//Vertex coords			//Normals				//Texture coords
-		-1.0f,  0.0f, -1.0f,	0.0f,  1.0f,  0.0f,		0.0f, 1.0f,
-		-1.0f, 0.0f, 1.0f,		0.0f,  1.0f,  0.0f,		0.0f, 0.0f,
-		1.0f, 0.0f, 1.0f,		0.0f,  1.0f,  0.0f,		1.0f, 0.0f,
-		-1.0f,  0.0f, -1.0f,	0.0f,  1.0f,  0.0f,		0.0f, 1.0f,
-		1.0f,  0.0f, -1.0f,		0.0f,  1.0f,  0.0f,		1.0f, 1.0f,
-		1.0f, 0.0f, 1.0f,		0.0f,  1.0f,  0.0f,		1.0f, 0.0f,
-		-1.0f, 0.0f, 1.0f,		0.0f,  1.0f,  0.0f,		0.0f, 0.0f
-	};
-
-	const int floatsPerVertex = 3;
-	const int floatsPerNormal = 3;
-	const int floatsPerUV = 2;
-
-	mesh.nVertices = mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex));
-
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glGenBuffers(1, mesh.vbos); // Creates 1 buffer
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	// Strides between vertex coordinates
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
-
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
-}
-
-void UCreateCubeMesh(GLMesh& mesh) {
-	GLfloat verts[] =
-	{
-		//Vertex coords			//Normals				//Texture coords
-
-		//
-		-0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  1.0f,		0.0f, 0.0f, 
-		0.5f, -0.5f, -0.5f,		1.0f,  0.0f,  1.0f,		1.0f, 0.0f,
-		0.5f,  0.5f, -0.5f,		1.0f,  0.0f,  1.0f,		1.0f, 1.0f,
-		0.5f,  0.5f, -0.5f,		1.0f,  0.0f,  1.0f,		1.0f, 1.0f,
-		-0.5f,  0.5f, -0.5f,	1.0f,  0.0f,  1.0f,		0.0f, 1.0f,
-		-0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  1.0f,		0.0f, 0.0f,
-
-		-0.5f, -0.5f,  0.5f,	1.0f,  0.0f,  -1.0f,	0.0f, 0.0f,
-		0.5f, -0.5f,  0.5f,		1.0f,  0.0f,  -1.0f,	1.0f, 0.0f,
-		0.5f,  0.5f,  0.5f,		1.0f,  0.0f,  -1.0f,	1.0f, 1.0f,
-		0.5f,  0.5f,  0.5f,		1.0f,  0.0f,  -1.0f,	1.0f, 1.0f,
-		-0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  -1.0f,	0.0f, 1.0f,
-		-0.5f, -0.5f,  0.5f,	1.0f,  0.0f,  -1.0f,	0.0f, 0.0f,
-
-		-0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
-		-0.5f,  0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 0.0f,
-		-0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
-		-0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
-		-0.5f, -0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 1.0f,
-		-0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
-
-		0.5f,  0.5f,  0.5f,		1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
-		0.5f,  0.5f, -0.5f,		1.0f,  0.0f,  0.0f,		1.0f, 0.0f,
-		0.5f, -0.5f, -0.5f,		1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
-		0.5f, -0.5f, -0.5f,		1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
-		0.5f, -0.5f,  0.5f,		1.0f,  0.0f,  0.0f,		0.0f, 1.0f,
-		0.5f,  0.5f,  0.5f,		1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
-
-		-0.5f, -0.5f, -0.5f,	0.0f,  1.0f,  0.0f,		0.0f, 0.0f,
-		0.5f, -0.5f, -0.5f,		0.0f,  1.0f,  0.0f,		1.0f, 0.0f,
-		0.5f, -0.5f,  0.5f,		0.0f,  1.0f,  0.0f,		1.0f, 1.0f,
-		0.5f, -0.5f,  0.5f,		0.0f,  1.0f,  0.0f,		1.0f, 1.0f,
-		-0.5f, -0.5f,  0.5f,	0.0f,  1.0f,  0.0f,		0.0f, 1.0f,
-		-0.5f, -0.5f, -0.5f,	0.0f,  1.0f,  0.0f,		0.0f, 0.0f,
-
-		-0.5f,  0.5f, -0.5f,	0.0f,  -1.0f,  0.0f,	0.0f, 0.0f,
-		0.5f,  0.5f, -0.5f,		0.0f,  -1.0f,  0.0f,	1.0f, 0.0f,
-		0.5f,  0.5f,  0.5f,		0.0f,  -1.0f,  0.0f,	1.0f, 1.0f,
-		0.5f,  0.5f,  0.5f,		0.0f,  -1.0f,  0.0f,	1.0f, 0.0f,
-		-0.5f,  0.5f,  0.5f,	0.0f,  -1.0f,  0.0f,	0.0f, 1.0f,
-		-0.5f,  0.5f, -0.5f,	0.0f,  -1.0f,  0.0f,	1.0f, 1.0f
-		
-		
-
-	};
-
-
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
-
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex +floatsPerUV));
-
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(mesh.vao);
-
-	// Create 2 buffers: first one for the vertex data; second one for the indices
-	glGenBuffers(1, &mesh.vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	// Strides between vertex coordinates is 6 (x, y, z, r, g, b, a). A tightly packed stride is 0.
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);// The number of floats before each
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
-
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
-}
-void UCreatePrismMesh(GLMesh& mesh)
-{
-	GLfloat verts[] = {
-		 0.15f, -0.85f, -0.85f, 	0.0f, 0.0f, 1.0f,   0.0f, 0.0f, // 4
-		0.15f, -0.85f, -0.6f, 	0.0f, 0.0f, 1.0f,   1.0f, 0.0f, // 5
-		0.15f, -0.98f, -0.85f, 	0.0f, 0.0f, 1.0f,   1.0f, 1.0f, // 6
-		0.15f, -0.85f, -0.6f, 	0.0f, 0.0f, 1.0f,   1.0f, 0.0f, // 5
-		0.15f, -0.98f, -0.6f, 	0.0f, 0.0f, 1.0f,   0.0f, 1.0f, // 7
-		0.15f, -0.98f, -0.85f, 	0.0f, 0.0f, 1.0f,   1.0f, 1.0f, // 6
-
-		// Back face
-		0.33f, -1.0f, -0.85f, 	0.0f, 0.0f, -1.0f,   0.0f, 0.0f, // 0
-		0.33f, -1.0f, -0.6f, 	0.0f, 0.0f, -1.0f,   1.0f, 0.0f, // 1
-		0.33f, -0.83f, -0.85f, 	0.0f, 0.0f, -1.0f,   1.0f, 1.0f, // 2
-		0.33f, -1.0f, -0.6f, 	0.0f, 0.0f, -1.0f,   1.0f, 0.0f, // 1
-		0.33f, -0.83f, -0.6f, 	0.0f, 0.0f, -1.0f,   0.0f, 1.0f, // 3
-		0.33f, -0.83f, -0.85f, 	0.0f, 0.0f, -1.0f,   1.0f, 1.0f, // 2
-
-		// Left face
-		0.15f, -0.85f, -0.85f, 	-1.0f, 0.0f, 0.0f,   0.0f, 0.0f, // 4
-		0.15f, -0.85f, -0.6f, 	-1.0f, 0.0f, 0.0f,   1.0f, 0.0f, // 5
-		0.33f, -0.83f, -0.85f, 	-1.0f, 0.0f, 0.0f,   1.0f, 1.0f, // 2
-		0.15f, -0.85f, -0.6f, 	-1.0f, 0.0f, 0.0f,   1.0f, 0.0f, // 5
-		0.33f, -0.83f, -0.6f, 	-1.0f, 0.0f, 0.0f,   0.0f, 1.0f, // 3
-		0.33f, -0.83f, -0.85f, 	-1.0f, 0.0f, 0.0f,   1.0f, 1.0f, // 2
-
-		// Right face
-		0.15f, -0.98f, -0.85f, 	1.0f, 0.0f, 0.0f,   0.0f, 0.0f, // 6
-		0.15f, -0.98f, -0.6f, 	1.0f, 0.0f, 0.0f,   1.0f, 0.0f, // 7
-		0.33f, -1.0f, -0.85f, 	1.0f, 0.0f, 0.0f,   1.0f, 1.0f, // 0
-		0.15f, -0.98f, -0.6f, 	1.0f, 0.0f, 0.0f,   1.0f, 0.0f, // 7
-		0.33f, -1.0f, -0.6f, 	1.0f, 0.0f, 0.0f,   0.0f, 1.0f, // 1
-		0.33f, -1.0f, -0.85f, 	1.0f, 0.0f, 0.0f,   1.0f, 1.0f, // 0
-
-		// Top face
-		0.15f, -0.85f, -0.6f, 	0.0f, 1.0f, 0.0f,   0.0f, 0.0f, // 5
-		0.33f, -0.83f, -0.6f, 	0.0f, 1.0f, 0.0f,   1.0f, 0.0f, // 3
-		0.15f, -0.98f, -0.6f, 	0.0f, 1.0f, 0.0f,   1.0f, 1.0f, // 7
-		0.33, -0.83f, -0.6f, 	0.0f, 1.0f, 0.0f,   1.0f, 0.0f, // 3
-		0.33f, -1.0f, -0.6f, 	0.0f, 1.0f, 0.0f,   0.0f, 1.0f, // 1
-		0.15f, -0.98f, -0.6f, 	0.0f, 1.0f, 0.0f,   1.0f, 1.0f, // 7
-
-		// Bottom face
-		0.15f, -0.85f, -0.85f, 	0.0f, -1.0f, 0.0f,   0.0f, 0.0f, // 4
-		0.33f, -0.83f, -0.85f, 	0.0f, -1.0f, 0.0f,   1.0f, 0.0f, // 2
-		0.15f, -0.98f, -0.85f, 	0.0f, -1.0f, 0.0f,   1.0f, 1.0f, // 6
-		0.33, -0.83f, -0.85f, 	0.0f, -1.0f, 0.0f,   1.0f, 0.0f, // 2
-		0.33f, -1.0f, -0.85f, 	0.0f, -1.0f, 0.0f,   0.0f, 1.0f, // 0
-		0.15f, -0.98f, -0.85f, 	0.0f, -1.0f, 0.0f,   1.0f, 1.0f, // 6
-	};
-
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
-
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(mesh.vao);
-
-	// Create 2 buffers: first one for the vertex data; second one for the indices
-	glGenBuffers(1, mesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	// Strides between vertex coordinates is 6 (x, y, z, r, g, b, a). A tightly packed stride is 0.
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);// The number of floats before each
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
-
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
-}
-
-void UCreateSphereMesh(GLMesh& mesh){
-	GLfloat verts[] = {
-	// vertex data					// index
-	// top center point
-	0.0f, 1.0f, 0.0f,				//0
-	// ring 1
-	0.0f, 0.9808f, 0.1951f,			//1
-	0.0747f, 0.9808f, 0.1802f,		//2
-	0.1379f, 0.9808f, 0.1379f,		//3
-	0.1802f, 0.9808f, 0.0747f,		//4
-	0.1951f, 0.9808, 0.0f,			//5
-	0.1802f, 0.9808f, -0.0747f,		//6
-	0.1379f, 0.9808f, -0.1379f,		//7
-	0.0747f, 0.9808f, -0.1802f,		//8
-	0.0f, 0.9808f, -0.1951f,		//9
-	-0.0747f, 0.9808f, -0.1802f,	//10
-	-0.1379f, 0.9808f, -0.1379f,	//11
-	-0.1802f, 0.9808f, -0.0747f,	//12
-	-0.1951f, 0.9808, 0.0f,			//13
-	-0.1802f, 0.9808f, 0.0747f,		//14
-	-0.1379f, 0.9808f, 0.1379f,		//15
-	-0.0747f, 0.9808f, 0.1802f,		//16
-	// ring 2
-	0.0f, 0.9239f, 0.3827f,			//17
-	0.1464f, 0.9239f, 0.3536f,		//18
-	0.2706f, 0.9239f, 0.2706f,		//19
-	0.3536f, 0.9239f, 0.1464f,		//20
-	0.3827f, 0.9239f, 0.0f,			//21
-	0.3536f, 0.9239f, -0.1464f,		//22
-	0.2706f, 0.9239f, -0.2706f,		//23
-	0.1464f, 0.9239f, -0.3536f,		//24
-	0.0f, 0.9239f, -0.3827f,		//25
-	-0.1464f, 0.9239f, -0.3536f,	//26
-	-0.2706f, 0.9239f, -0.2706f,	//27
-	-0.3536f, 0.9239f, -0.1464f,	//28
-	-0.3827f, 0.9239f, 0.0f,		//29
-	-0.3536f, 0.9239f, 0.1464f,		//30
-	-0.2706f, 0.9239f, 0.2706f,		//31
-	-0.1464f, 0.9239f, 0.3536f,		//32
-	// ring 3
-	0.0f, 0.8315f, 0.5556f,			//33
-	0.2126f, 0.8315f, 0.5133f,		//34
-	0.3928f, 0.8315f, 0.3928f,		//35
-	0.5133f, 0.8315f, 0.2126f,		//36
-	0.5556f, 0.8315f, 0.0f,			//37
-	0.5133f, 0.8315f, -0.2126f,		//38
-	0.3928f, 0.8315f, -0.3928f,		//39
-	0.2126f, 0.8315f, -0.5133f,		//40
-	0.0f, 0.8315f, -0.5556f,		//41
-	-0.2126f, 0.8315f, -0.5133f,	//42
-	-0.3928f, 0.8315f, -0.3928f,	//43
-	-0.5133f, 0.8315f, -0.2126f,	//44
-	-0.5556f, 0.8315f, 0.0f,		//45
-	-0.5133f, 0.8315f, 0.2126f,		//46
-	-0.3928f, 0.8315f, 0.3928f,		//47
-	-0.2126f, 0.8315f, 0.5133f,		//48
-	// ring 4
-	0.0f, 0.7071f, 0.7071f,			//49
-	0.2706f, 0.7071f, 0.6533f,		//50
-	0.5f, 0.7071f, 0.5f,			//51
-	0.6533f, 0.7071f, 0.2706f,		//52
-	0.7071f, 0.7071f, 0.0f,			//53
-	0.6533f, 0.7071f, -0.2706f,		//54
-	0.5f, 0.7071f, -0.5f,			//55
-	0.2706f, 0.7071f, -0.6533f,		//56
-	0.0f, 0.7071f, -0.7071f,		//57
-	-0.2706f, 0.7071f, -0.6533f,	//58
-	-0.5f, 0.7071f, -0.5f,			//59
-	-0.6533f, 0.7071f, -0.2706f,	//60
-	-0.7071f, 0.7071f, 0.0f,		//61
-	-0.6533f, 0.7071f, 0.2706f,		//62
-	-0.5f, 0.7071f, 0.5f,			//63
-	-0.2706f, 0.7071f, 0.6533f,		//64
-	// ring 5
-	0.0f, 0.5556f, 0.8315f,			//65
-	0.3182f, 0.5556f, 0.7682f,		//66
-	0.5879f, 0.5556f, 0.5879f,		//67
-	0.7682f, 0.5556f, 0.3182f,		//68
-	0.8315f, 0.5556f, 0.0f,			//69
-	0.7682f, 0.5556f, -0.3182f,		//70
-	0.5879f, 0.5556f, -0.5879f,		//71
-	0.3182f, 0.5556f, -0.7682f,		//72
-	0.0f, 0.5556f, -0.8315f,		//73
-	-0.3182f, 0.5556f, -0.7682f,	//74
-	-0.5879f, 0.5556f, -0.5879f,	//75
-	-0.7682f, 0.5556f, -0.3182f,	//76
-	-0.8315f, 0.5556f, 0.0f,		//77
-	-0.7682f, 0.5556f, 0.3182f,		//78
-	-0.5879f, 0.5556f, 0.5879f,		//79
-	-0.3182f, 0.5556f, 0.7682f,		//80
-	//ring 6
-	0.0f, 0.3827f, 0.9239f,			//81
-	0.3536f, 0.3827f, 0.8536f,		//82
-	0.6533f, 0.3827f, 0.6533f,		//83
-	0.8536f, 0.3827f, 0.3536f,		//84
-	0.9239f, 0.3827f, 0.0f,			//85
-	0.8536f, 0.3827f, -0.3536f,		//86
-	0.6533f, 0.3827f, -0.6533f,		//87
-	0.3536f, 0.3827f, -0.8536f,		//88
-	0.0f, 0.3827f, -0.9239f,		//89
-	-0.3536f, 0.3827f, -0.8536f,	//90
-	-0.6533f, 0.3827f, -0.6533f,	//91
-	-0.8536f, 0.3827f, -0.3536f,	//92
-	-0.9239f, 0.3827f, 0.0f,		//93
-	-0.8536f, 0.3827f, 0.3536f,		//94
-	-0.6533f, 0.3827f, 0.6533f,		//95
-	-0.3536f, 0.3827f, 0.8536f,		//96
-	// ring 7
-	0.0f, 0.1951f, 0.9808f,			//97
-	0.3753f, 0.1915f, 0.9061f,		//98
-	0.6935f, 0.1915f, 0.6935f,		//99
-	0.9061f, 0.1915f, 0.3753f,		//100
-	0.9808f, 0.1915f, 0.0f,			//101
-	0.9061f, 0.1915f, -0.3753f,		//102
-	0.6935f, 0.1915f, -0.6935f,		//103
-	0.3753f, 0.1915f, -0.9061f,		//104
-	0.0f, 0.1915f, -0.9808f,		//105
-	-0.3753f, 0.1915f, -0.9061f,	//106
-	-0.6935f, 0.1915f, -0.6935f,	//107
-	-0.9061f, 0.1915f, -0.3753f,	//108
-	-0.9808f, 0.1915f, 0.0f,		//109
-	-0.9061f, 0.1915f, 0.3753f,		//110
-	-0.6935f, 0.1915f, 0.6935f,		//111
-	-0.3753f, 0.1915f, 0.9061f,		//112
-	// ring 8
-	0.0f, 0.0f, 1.0f,				//113
-	0.3827f, 0.0f, 0.9239f,			//114
-	0.7071f, 0.0f, 0.7071f,			//115
-	0.9239f, 0.0f, 0.3827f,			//116
-	1.0f, 0.0f, 0.0f,				//117
-	0.9239f, 0.0f, -0.3827f,		//118
-	0.7071f, 0.0f, -0.7071f,		//119
-	0.3827f, 0.0f, -0.9239f,		//120
-	0.0f, 0.0f, -1.0f,				//121
-	-0.3827f, 0.0f, -0.9239f,		//122
-	-0.7071f, 0.0f, -0.7071f,		//123
-	-0.9239f, 0.0f, -0.3827f,		//124
-	-1.0f, 0.0f, 0.0f,				//125
-	-0.9239f, 0.0f, 0.3827f,		//126
-	-0.7071, 0.0, 0.7071f,			//127
-	-0.3827f, 0.0f, 0.9239f,		//128
-	// ring 9
-	0.0f, -0.1915f, 0.9808f,		//129
-	0.3753f, -0.1915f, 0.9061f,		//130
-	0.6935f, -0.1915f, 0.6935f,		//131
-	0.9061f, -0.1915f, 0.3753f,		//132
-	0.9808f, -0.1915f, 0.0f,		//133
-	0.9061f, -0.1915f, -0.3753f,	//134
-	0.6935f, -0.1915f, -0.6935f,	//135
-	0.3753f, -0.1915f, -0.9061f,	//136
-	0.0f, -0.1915f, -0.9808f,		//137
-	-0.3753f, -0.1915f, -0.9061f,	//138
-	-0.6935f, -0.1915f, -0.6935f,	//139
-	-0.9061f, -0.1915f, -0.3753f,	//140
-	-0.9808f, -0.1915f, 0.0f,		//141
-	-0.9061f, -0.1915f, 0.3753f,	//142
-	-0.6935f, -0.1915f, 0.6935f,	//143
-	-0.3753f, -0.1915f, 0.9061f,	//144
-	// ring 10
-	0.0f, -0.3827f, 0.9239f,		//145
-	0.3536f, -0.3827f, 0.8536f,		//146
-	0.6533f, -0.3827f, 0.6533f,		//147
-	0.8536f, -0.3827f, 0.3536f,		//148
-	0.9239f, -0.3827f, 0.0f,		//149
-	0.8536f, -0.3827f, -0.3536f,	//150
-	0.6533f, -0.3827f, -0.6533f,	//151
-	0.3536f, -0.3827f, -0.8536f,	//152
-	0.0f, -0.3827f, -0.9239f,		//153
-	-0.3536f, -0.3827f, -0.8536f,	//154
-	-0.6533f, -0.3827f, -0.6533f,	//155
-	-0.8536f, -0.3827f, -0.3536f,	//156
-	-0.9239f, -0.3827f, 0.0f,		//157
-	-0.8536f, -0.3827f, 0.3536f,	//158
-	-0.6533f, -0.3827f, 0.6533f,	//159
-	-0.3536f, -0.3827f, 0.8536f,	//160
-	// ring 11
-	0.0f, -0.5556f, 0.8315f,		//161
-	0.3182f, -0.5556f, 0.7682f,		//162
-	0.5879f, -0.5556f, 0.5879f,		//163
-	0.7682f, -0.5556f, 0.3182f,		//164
-	0.8315f, -0.5556f, 0.0f,		//165
-	0.7682f, -0.5556f, -0.3182f,	//166
-	0.5879f, -0.5556f, -0.5879f,	//167
-	0.3182f, -0.5556f, -0.7682f,	//168
-	0.0f, -0.5556f, -0.8315f,		//169
-	-0.3182f, -0.5556f, -0.7682f,	//170
-	-0.5879f, 0.5556f, -0.5879f,	//171
-	-0.7682f, -0.5556f, -0.3182f,	//172
-	-0.8315f, -0.5556f, 0.0f,		//173
-	-0.7682f, -0.5556f, 0.3182f,	//174
-	-0.5879f, -0.5556f, 0.5879f,	//175
-	-0.3182f, -0.5556f, 0.7682f,	//176
-	// ring 12
-	0.0f, -0.7071f, 0.7071f,		//177
-	0.2706f, -0.7071f, 0.6533f,		//178
-	0.5f, -0.7071f, 0.5f,			//179
-	0.6533f, -0.7071f, 0.2706f,		//180
-	0.7071f, -0.7071f, 0.0f,		//181
-	0.6533f, -0.7071f, -0.2706f,	//182
-	0.5f, -0.7071f, -0.5f,			//183
-	0.2706f, -0.7071f, -0.6533f,	//184
-	0.0f, -0.7071f, -0.7071f,		//185
-	-0.2706f, -0.7071f, -0.6533f,	//186
-	-0.5f, -0.7071f, -0.5f,			//187
-	-0.6533f, -0.7071f, -0.2706f,	//188
-	-0.7071f, -0.7071f, 0.0f,		//189
-	-0.6533f, -0.7071f, 0.2706f,	//190
-	-0.5f, -0.7071f, 0.5f,			//191
-	-0.2706f, -0.7071f, 0.6533f,	//192
-	// ring 13
-	0.0f, -0.8315f, 0.5556f,		//193
-	0.2126f, -0.8315f, 0.5133f,		//194
-	0.3928f, -0.8315f, 0.3928f,		//195
-	0.5133f, -0.8315f, 0.2126f,		//196
-	0.5556f, -0.8315f, 0.0f,		//197
-	0.5133f, -0.8315f, -0.2126f,	//198
-	0.3928f, -0.8315f, -0.3928f,	//199
-	0.2126f, -0.8315f, -0.5133f,	//200
-	0.0f, -0.8315f, -0.5556f,		//201
-	-0.2126f, -0.8315f, -0.5133f,	//202
-	-0.3928f, -0.8315f, -0.3928f,	//203
-	-0.5133f, -0.8315f, -0.2126f,	//204
-	-0.5556f, -0.8315f, 0.0f,		//205
-	-0.5133f, -0.8315f, 0.2126f,	//206
-	-0.3928f, -0.8315f, 0.3928f,	//207
-	-0.2126f, -0.8315f, 0.5133f,	//208
-	// ring 14
-	0.0f, -0.9239f, 0.3827f,		//209
-	0.1464f, -0.9239f, 0.3536f,		//210
-	0.2706f, -0.9239f, 0.2706f,		//211
-	0.3536f, -0.9239f, 0.1464f,		//212
-	0.3827f, -0.9239f, 0.0f,		//213
-	0.3536f, -0.9239f, -0.1464f,	//214
-	0.2706f, -0.9239f, -0.2706f,	//215
-	0.1464f, -0.9239f, -0.3536f,	//216
-	0.0f, -0.9239f, -0.3827f,		//217
-	-0.1464f, -0.9239f, -0.3536f,	//218
-	-0.2706f, -0.9239f, -0.2706f,	//219
-	-0.3536f, -0.9239f, -0.1464f,	//220
-	-0.3827f, -0.9239f, 0.0f,		//221
-	-0.3536f, -0.9239f, 0.1464f,	//222
-	-0.2706f, -0.9239f, 0.2706f,	//223
-	-0.1464f, -0.9239f, 0.3536f,	//224
-	// ring 15
-	0.0f, -0.9808f, 0.1951f,		//225
-	0.0747f, -0.9808f, 0.1802f,		//226
-	0.1379f, -0.9808f, 0.1379f,		//227
-	0.1802f, -0.9808f, 0.0747f,		//228
-	0.1951f, -0.9808, 0.0f,			//229
-	0.1802f, -0.9808f, -0.0747f,	//230
-	0.1379f, -0.9808f, -0.1379f,	//231
-	0.0747f, -0.9808f, -0.1802f,	//232
-	0.0f, -0.9808f, -0.1951f,		//233
-	-0.0747f, -0.9808f, -0.1802f,	//234
-	-0.1379f, -0.9808f, -0.1379f,	//235
-	-0.1802f, -0.9808f, -0.0747f,	//236
-	-0.1951f, -0.9808, 0.0f,		//237
-	-0.1802f, -0.9808f, 0.0747f,	//238
-	-0.1379f, -0.9808f, 0.1379f,	//239
-	-0.0747f, -0.9808f, 0.1802f,	//240
-	// bottom center point
-	0.0f, -1.0f, 0.0f,				//241
-};
-
-// index data
-GLuint indices[] = {
-	//ring 1 - top
-	0,1,2,
-	0,2,3,
-	0,3,4,
-	0,4,5,
-	0,5,6,
-	0,6,7,
-	0,7,8,
-	0,8,9,
-	0,9,10,
-	0,10,11,
-	0,11,12,
-	0,12,13,
-	0,13,14,
-	0,14,15,
-	0,15,16,
-	0,16,1,
-
-	// ring 1 to ring 2
-	1,17,18,
-	1,2,18,
-	2,18,19,
-	2,3,19,
-	3,19,20,
-	3,4,20,
-	4,20,21,
-	4,5,21,
-	5,21,22,
-	5,6,22,
-	6,22,23,
-	6,7,23,
-	7,23,24,
-	7,8,24,
-	8,24,25,
-	8,9,25,
-	9,25,26,
-	9,10,26,
-	10,26,27,
-	10,11,27,
-	11,27,28,
-	11,12,28,
-	12,28,29,
-	12,13,29,
-	13,29,30,
-	13,14,30,
-	14,30,31,
-	14,15,31,
-	15,31,32,
-	15,16,32,
-	16,32,17,
-	16,1,17,
-
-	// ring 2 to ring 3
-	17,33,34,
-	17,18,34,
-	18,34,35,
-	18,19,35,
-	19,35,36,
-	19,20,36,
-	20,36,37,
-	20,21,37,
-	21,37,38,
-	21,22,38,
-	22,38,39,
-	22,23,39,
-	23,39,40,
-	23,24,40,
-	24,40,41,
-	24,25,41,
-	25,41,42,
-	25,26,42,
-	26,42,43,
-	26,27,43,
-	27,43,44,
-	27,28,44,
-	28,44,45,
-	28,29,45,
-	29,45,46,
-	29,30,46,
-	30,46,47,
-	30,31,47,
-	31,47,48,
-	31,32,48,
-	32,48,33,
-	32,17,33,
-
-	// ring 3 to ring 4
-	33,49,50,
-	33,34,50,
-	34,50,51,
-	34,35,51,
-	35,51,52,
-	35,36,52,
-	36,52,53,
-	36,37,53,
-	37,53,54,
-	37,38,54,
-	38,54,55,
-	38,39,55,
-	39,55,56,
-	39,40,56,
-	40,56,57,
-	40,41,57,
-	41,57,58,
-	41,42,58,
-	42,58,59,
-	42,43,59,
-	43,59,60,
-	43,44,60,
-	44,60,61,
-	44,45,61,
-	45,61,62,
-	45,46,62,
-	46,62,63,
-	46,47,63,
-	47,63,64,
-	47,48,64,
-	48,64,49,
-	48,33,49,
-
-	// ring 4 to ring 5
-	49,65,66,
-	49,50,66,
-	50,66,67,
-	50,51,67,
-	51,67,68,
-	51,52,68,
-	52,68,69,
-	52,53,69,
-	53,69,70,
-	53,54,70,
-	54,70,71,
-	54,55,71,
-	55,71,72,
-	55,56,72,
-	56,72,73,
-	56,57,73,
-	57,73,74,
-	57,58,74,
-	58,74,75,
-	58,59,75,
-	59,75,76,
-	59,60,76,
-	60,76,77,
-	60,61,77,
-	61,77,78,
-	61,62,78,
-	62,78,79,
-	62,63,79,
-	63,79,80,
-	63,64,80,
-	64,80,65,
-	64,49,65,
-
-	// ring 5 to ring 6
-	65,81,82,
-	65,66,82,
-	66,82,83,
-	66,67,83,
-	67,83,84,
-	67,68,84,
-	68,84,85,
-	68,69,85,
-	69,85,86,
-	69,70,86,
-	70,86,87,
-	70,71,87,
-	71,87,88,
-	71,72,88,
-	72,88,89,
-	72,73,89,
-	73,89,90,
-	73,74,90,
-	74,90,91,
-	74,75,91,
-	75,91,92,
-	75,76,92,
-	76,92,93,
-	76,77,93,
-	77,93,94,
-	77,78,94,
-	78,94,95,
-	78,79,95,
-	79,95,96,
-	79,80,96,
-	80,96,81,
-	80,65,81,
-
-	// ring 6 to ring 7
-	81,97,98,
-	81,82,98,
-	82,98,99,
-	82,83,99,
-	83,99,100,
-	83,84,100,
-	84,100,101,
-	84,85,101,
-	85,101,102,
-	85,86,102,
-	86,102,103,
-	86,87,103,
-	87,103,104,
-	87,88,104,
-	88,104,105,
-	88,89,105,
-	89,105,106,
-	89,90,106,
-	90,106,107,
-	90,91,107,
-	91,107,108,
-	91,92,108,
-	92,108,109,
-	92,93,109,
-	93,109,110,
-	93,94,110,
-	94,110,111,
-	94,95,111,
-	95,111,112,
-	95,96,112,
-	96,112,97,
-	96,81,97,
-
-	// ring 7 to ring 8
-	97,113,114,
-	97,98,114,
-	98,114,115,
-	98,99,115,
-	99,115,116,
-	99,100,116,
-	100,116,117,
-	100,101,117,
-	101,117,118,
-	101,102,118,
-	102,118,119,
-	102,103,119,
-	103,119,120,
-	103,104,120,
-	104,120,121,
-	104,105,121,
-	105,121,122,
-	105,106,122,
-	106,122,123,
-	106,107,123,
-	107,123,124,
-	107,108,124,
-	108,124,125,
-	108,109,125,
-	109,125,126,
-	109,110,126,
-	110,126,127,
-	110,111,127,
-	111,127,128,
-	111,112,128,
-	112,128,113,
-	112,97,113,
-
-	// ring 8 to ring 9
-	113,129,130,
-	113,114,130,
-	114,130,131,
-	114,115,131,
-	115,131,132,
-	115,116,132,
-	116,132,133,
-	116,117,133,
-	117,133,134,
-	117,118,134,
-	118,134,135,
-	118,119,135,
-	119,135,136,
-	119,120,136,
-	120,136,137,
-	120,121,137,
-	121,137,138,
-	121,122,138,
-	122,138,139,
-	122,123,139,
-	123,139,140,
-	123,124,140,
-	124,140,141,
-	124,125,141,
-	125,141,142,
-	125,126,142,
-	126,142,143,
-	126,127,143,
-	127,143,144,
-	127,128,144,
-	128,144,129,
-	128,113,129,
-
-	// ring 9 to ring 10
-	129,145,146,
-	129,130,146,
-	130,146,147,
-	130,131,147,
-	131,147,148,
-	131,132,148,
-	132,148,149,
-	132,133,149,
-	133,149,150,
-	133,134,150,
-	134,150,151,
-	134,135,151,
-	135,151,152,
-	135,136,152,
-	136,152,153,
-	136,137,153,
-	137,153,154,
-	137,138,154,
-	138,154,155,
-	138,139,155,
-	139,155,156,
-	139,140,156,
-	140,156,157,
-	140,141,157,
-	141,157,158,
-	141,142,158,
-	142,158,159,
-	142,143,159,
-	143,159,160,
-	143,144,160,
-	144,160,145,
-	144,129,145,
-
-	// ring 10 to ring 11
-	145,161,162,
-	145,146,162,
-	146,162,163,
-	146,147,163,
-	147,163,164,
-	147,148,164,
-	148,164,165,
-	148,149,165,
-	149,165,166,
-	149,150,166,
-	150,166,167,
-	150,151,167,
-	151,167,168,
-	151,152,168,
-	152,168,169,
-	152,153,169,
-	153,169,170,
-	153,154,170,
-	154,170,171,
-	154,155,171,
-	155,171,172,
-	155,156,172,
-	156,172,173,
-	156,157,173,
-	157,173,174,
-	157,158,174,
-	158,174,175,
-	158,159,175,
-	159,175,176,
-	159,160,176,
-	160,176,161,
-	160,145,161,
-
-	// ring 11 to ring 12
-	161,177,178,
-	161,162,178,
-	162,178,179,
-	162,163,179,
-	163,179,180,
-	163,164,180,
-	164,180,181,
-	164,165,181,
-	165,181,182,
-	165,166,182,
-	166,182,183,
-	166,167,183,
-	167,183,184,
-	167,168,184,
-	168,184,185,
-	168,169,185,
-	169,185,186,
-	169,170,186,
-	170,186,187,
-	170,171,187,
-	171,187,188,
-	171,172,188,
-	172,188,189,
-	172,173,189,
-	173,189,190,
-	173,174,190,
-	174,190,191,
-	174,175,191,
-	175,191,192,
-	175,176,192,
-	176,192,177,
-	176, 161,177,
-
-	// ring 12 to ring 13
-	177,193,194,
-	177,178,194,
-	178,194,195,
-	178,179,195,
-	179,195,196,
-	179,180,196,
-	180,196,197,
-	180,181,197,
-	181,197,198,
-	181,182,198,
-	182,198,199,
-	182,183,199,
-	183,199,200,
-	183,184,200,
-	184,200,201,
-	184,185,201,
-	185,201,202,
-	185,186,202,
-	186,202,203,
-	186,187,203,
-	187,203,204,
-	187,188,204,
-	188,204,205,
-	188,189,205,
-	189,205,206,
-	189,190,206,
-	190,206,207,
-	190,191,207,
-	191,207,208,
-	191,192,208,
-	192,208,193,
-	192,177,193,
-
-	// ring 13 to ring 14
-	193,209,210,
-	193,194,210,
-	194,210,211,
-	194,195,211,
-	195,211,212,
-	195,196,212,
-	196,212,213,
-	196,197,213,
-	197,213,214,
-	197,198,214,
-	198,214,215,
-	198,199,215,
-	199,215,216,
-	199,200,216,
-	200,216,217,
-	200,201,217,
-	201,217,218,
-	201,202,218,
-	202,218,219,
-	202,203,219,
-	203,219,220,
-	203,204,220,
-	204,220,221,
-	204,205,221,
-	205,221,222,
-	205,206,222,
-	206,222,223,
-	206,207,223,
-	207,223,224,
-	207,208,224,
-	208,224,209,
-	208,193,209,
-
-	// ring 14 to ring 15
-	209,225,226,
-	209,210,226,
-	210,226,227,
-	210,211,227,
-	211,227,228,
-	211,212,228,
-	212,228,229,
-	212,213,229,
-	213,229,230,
-	213,214,230,
-	214,230,231,
-	214,215,231,
-	215,231,232,
-	215,216,232,
-	216,232,233,
-	216,217,233,
-	217,233,234,
-	217,218,234,
-	218,234,235,
-	218,219,235,
-	219,235,236,
-	219,220,236,
-	220,236,237,
-	220,221,237,
-	221,237,238,
-	221,222,238,
-	222,238,239,
-	222,223,239,
-	223,239,240,
-	223,224,240,
-	224,240,225,
-	224,209,225,
-
-	// ring 15 - bottom
-	225,226,241,
-	226,227,241,
-	227,228,241,
-	228,229,241,
-	229,239,241,
-	230,231,241,
-	231,232,241,
-	232,233,241,
-	233,234,241,
-	234,235,241,
-	235,236,241,
-	236,237,241,
-	237,238,241,
-	238,239,241,
-	239,240,241,
-	240,225,241
-};
-
-// total float values per each type
-const GLuint floatsPerVertex = 3;
-const GLuint floatsPerNormal = 3;
-const GLuint floatsPerUV = 2;
-
-// store vertex and index count
-mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex));
-mesh.nIndices = sizeof(indices) / (sizeof(indices[0]));
-
-glm::vec3 normal;
-glm::vec3 vert;
-glm::vec3 center(0.0f, 0.0f, 0.0f);
-float u, v;
-std::vector<GLfloat> combined_values;
-
-// combine interleaved vertices, normals, and texture coords
-for (int i = 0; i < sizeof(verts) / (sizeof(verts[0])); i += 3)
-{
-	vert = glm::vec3(verts[i], verts[i + 1], verts[i + 2]);
-	normal = normalize(vert - center);
-	u = atan2(normal.x, normal.z) / (2 * M_PI) + 0.5;
-	v = normal.y * 0.5 + 0.5;
-	combined_values.push_back(vert.x);
-	combined_values.push_back(vert.y);
-	combined_values.push_back(vert.z);
-	combined_values.push_back(normal.x);
-	combined_values.push_back(normal.y);
-	combined_values.push_back(normal.z);
-	combined_values.push_back(u);
-	combined_values.push_back(v);
-}
-
-// Create VAO
-glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-glBindVertexArray(mesh.vao);
-
-// Create VBOs
-glGenBuffers(2, mesh.vbos);
-glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the vertex buffer
-glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * combined_values.size(), combined_values.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.vbos[1]); // Activates the index buffer
-glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-// Strides between vertex coordinates
-GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-// Create Vertex Attribute Pointers
-glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-glEnableVertexAttribArray(0);
-
-glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-glEnableVertexAttribArray(1);
-
-glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-glEnableVertexAttribArray(2);
-}
-
-void UCreatePyramidsMesh(GLMesh& mesh) {
-	GLfloat verts[] = {
-		// Position                 // Normals              // Texture 
-
-	// Front
-		 -1.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,		0.0f, 0.0f, // 1 
-		 -1.0f, 0.0f,  1.0f,		0.0f, -1.0f, 0.0f,		0.0f, 1.0f, // 2
-		  1.0f, 0.0f,  1.0f,		0.0f, -1.0f, 0.0f,		1.0f, 1.0f, // 3
-
-
-		  1.0f, 0.0f,  1.0f,	    0.0f, -1.0f, 0.0f,		1.0f, 1.0f, // 3
-		  1.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,		1.0f, 0.0f, // 4
-		 -1.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,		0.0f, 0.0f, // 1
-
-
-		 -1.0f, 0.0f, -1.0f,		-1.0f, 0.0f, 0.0f,		0.0f, 0.0f, // 1
-		 -1.0f, 0.0f,  1.0f,		-1.0f, 0.0f, 0.0f,		1.0f, 0.0f, // 2
-		  0.0f, 1.0f,  0.0f,	    -1.0f, 0.0f, 0.0f,		0.5f, 1.0f, // 5
-
-
-		 -1.0f, 0.0f, -1.0f,		0.0f, 0.0f, -1.0f,		0.0f, 0.0f, // 1
-		  1.0f, 0.0f, -1.0f,		0.0f, 0.0f, -1.0f,		1.0f, 0.0f, // 4
-		  0.0f, 1.0f,  0.0f,		0.0f, 0.0f, -1.0f,		0.5f, 1.0f, // 5
-
-
-		  1.0f, 0.0f,  1.0f,		1.0f, 0.0f, 0.0f,		0.0f, 0.0f, // 3
-		  1.0f, 0.0f, -1.0f,		1.0f, 0.0f, 0.0f,		1.0f, 0.0f, // 4
-		  0.0f, 1.0f,  0.0f,		1.0f, 0.0f, 0.0f,		0.5f, 1.0f, // 5
-
-
-		 -1.0f, 0.0f, 1.0f,		    0.0f, 0.0f, 1.0f,		0.0f, 0.0f, // 2
-		  1.0f, 0.0f, 1.0f,		    0.0f, 0.0f, 1.0f,		1.0f, 0.0f, // 3
-		  0.0f, 1.0f, 0.0f,		    0.0f, 0.0f, 1.0f, 		0.5f, 1.0f  // 5
-	};
-	// Identify how many floats for Position, Normal, and Texture coordinates
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
-
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-
-	glGenVertexArrays(1, &mesh.vao); // Create and bind Vertex Array Object
-	glBindVertexArray(mesh.vao);
-
-	glGenBuffers(1, &mesh.vbo); // Create and activate Vertex Buffer Object
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Send vertex data to the GPU
-
-	// Strides between vertex coordinates
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-	// Create Vertex Attribute Pointers - position, normal, texture
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
-}
-
-void UCreateTorusMesh(GLMesh& mesh)
-{
-	int _mainSegments = 30;
-	int _tubeSegments = 30;
-	float _mainRadius = 1.0f;
-	float _tubeRadius = .1f;
-
-	auto mainSegmentAngleStep = glm::radians(360.0f / float(_mainSegments));
-	auto tubeSegmentAngleStep = glm::radians(360.0f / float(_tubeSegments));
-
-	std::vector<glm::vec3> vertex_list;
-	std::vector<std::vector<glm::vec3>> segments_list;
-
-	// generate the torus vertices
-	auto currentMainSegmentAngle = 0.0f;
-	for (auto i = 0; i < _mainSegments; i++)
-	{
-		// Calculate sine and cosine of main segment angle
-		auto sinMainSegment = sin(currentMainSegmentAngle);
-		auto cosMainSegment = cos(currentMainSegmentAngle);
-		auto currentTubeSegmentAngle = 0.0f;
-		std::vector<glm::vec3> segment_points;
-		for (auto j = 0; j < _tubeSegments; j++)
-		{
-			// Calculate sine and cosine of tube segment angle
-			auto sinTubeSegment = sin(currentTubeSegmentAngle);
-			auto cosTubeSegment = cos(currentTubeSegmentAngle);
-
-			// Calculate vertex position on the surface of torus
-			auto surfacePosition = glm::vec3(
-				(_mainRadius + _tubeRadius * cosTubeSegment) * cosMainSegment,
-				(_mainRadius + _tubeRadius * cosTubeSegment) * sinMainSegment,
-				_tubeRadius * sinTubeSegment);
-
-			//vertex_list.push_back(surfacePosition);
-			segment_points.push_back(surfacePosition);
-
-			// Update current tube angle
-			currentTubeSegmentAngle += tubeSegmentAngleStep;
-		}
-		segments_list.push_back(segment_points);
-		segment_points.clear();
-
-		// Update main segment angle
-		currentMainSegmentAngle += mainSegmentAngleStep;
-	}
-
-	// connect the various segments together, forming triangles
-	for (int i = 0; i < _mainSegments; i++)
-	{
-		for (int j = 0; j < _tubeSegments; j++)
-		{
-			if (((i + 1) < _mainSegments) && ((j + 1) < _tubeSegments))
-			{
-				vertex_list.push_back(segments_list[i][j]);
-				vertex_list.push_back(segments_list[i][j + 1]);
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				vertex_list.push_back(segments_list[i][j]);
-				vertex_list.push_back(segments_list[i + 1][j]);
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				vertex_list.push_back(segments_list[i][j]);
-			}
-			else
-			{
-				if (((i + 1) == _mainSegments) && ((j + 1) == _tubeSegments))
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					vertex_list.push_back(segments_list[i][0]);
-					vertex_list.push_back(segments_list[0][0]);
-					vertex_list.push_back(segments_list[i][j]);
-					vertex_list.push_back(segments_list[0][j]);
-					vertex_list.push_back(segments_list[0][0]);
-					vertex_list.push_back(segments_list[i][j]);
-				}
-				else if ((i + 1) == _mainSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					vertex_list.push_back(segments_list[i][j + 1]);
-					vertex_list.push_back(segments_list[0][j + 1]);
-					vertex_list.push_back(segments_list[i][j]);
-					vertex_list.push_back(segments_list[0][j]);
-					vertex_list.push_back(segments_list[0][j + 1]);
-					vertex_list.push_back(segments_list[i][j]);
-				}
-				else if ((j + 1) == _tubeSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					vertex_list.push_back(segments_list[i][0]);
-					vertex_list.push_back(segments_list[i + 1][0]);
-					vertex_list.push_back(segments_list[i][j]);
-					vertex_list.push_back(segments_list[i + 1][j]);
-					vertex_list.push_back(segments_list[i + 1][0]);
-					vertex_list.push_back(segments_list[i][j]);
-				}
-			}
-		}
-	}
-
-	// total float values per each type
-	const GLuint floatsPerVertex = 3;
-
-	// store vertex and index count
-	mesh.nVertices = vertex_list.size();
-	mesh.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(mesh.vao);
-
-	// Create VBOs
-	glGenBuffers(1, mesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3) * vertex_list.size(), vertex_list.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	// Strides between vertex coordinates
-	GLint stride = sizeof(float) * (floatsPerVertex);
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-}
-
-// Implements the UCreateMesh function
-void UCreatePyramidMesh(GLMesh& mesh)
-{
-	// Specifies Normalized Device Coordinates for triangle vertices
-	GLfloat verts[] =
-	{
-		-0.125f,  0.0f, 0.125f,
-		0.0f, 0.25f, 0.0f,
-		0.125f, 0.0f, 0.125f,
-		0.125f, 0.0f, -0.125f,
-		-0.125f, 0.0f, -0.125f,
-	};
-
-	GLuint indices[] = {
-		0,1,2,
-		2,1,3,
-		3,1,4,
-		4,1,0,
-		0,2,3,
-		3,4,0
-	};
-
-	const int floatsPerVertex = 3;
-	mesh.nVertices = mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex));
-	mesh.nIndices = sizeof(indices) / sizeof(indices[0]);
-
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glGenBuffers(2, mesh.vbos); // Creates 1 buffer
-	glBindVertexArray(mesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.vbos[1]);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-	// Strides between vertex coordinates
-	GLint stride = sizeof(float) * (floatsPerVertex);
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-}
-
-
-void UDestroyMesh(GLMesh& mesh)
-{
-	glDeleteVertexArrays(1, &mesh.vao);
-	glDeleteBuffers(2, mesh.vbos);
-}
-
-	
-
-// Implements the UCreateShaders function
-bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId)
-{
-	// Compilation and linkage error reporting
-	int success = 0;
-	char infoLog[512];
-
-	// Create a Shader program object.
-	programId = glCreateProgram();
-
-	// Create the vertex and fragment shader objects
-	GLuint vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
-	GLuint fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
-
-	// Retrive the shader source
-	glShaderSource(vertexShaderId, 1, &vtxShaderSource, NULL);
-	glShaderSource(fragmentShaderId, 1, &fragShaderSource, NULL);
-
-	// Compile the vertex shader, and print compilation errors (if any)
-	glCompileShader(vertexShaderId); // compile the vertex shader
-	// check for shader compile errors
-	glGetShaderiv(vertexShaderId, GL_COMPILE_STATUS, &success);
-	if (!success)
-	{
-		glGetShaderInfoLog(vertexShaderId, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-
-		return false;
-	}
-
-	glCompileShader(fragmentShaderId); // compile the fragment shader
-	// check for shader compile errors
-	glGetShaderiv(fragmentShaderId, GL_COMPILE_STATUS, &success);
-	if (!success)
-	{
-		glGetShaderInfoLog(fragmentShaderId, sizeof(infoLog), NULL, infoLog);
-		std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-
-		return false;
-	}
-
-	// Attached compiled shaders to the shader program
-	glAttachShader(programId, vertexShaderId);
-	glAttachShader(programId, fragmentShaderId);
-
-	glLinkProgram(programId);   // links the shader program
-	// check for linking errors
-	glGetProgramiv(programId, GL_LINK_STATUS, &success);
-	if (!success)
-	{
-		glGetProgramInfoLog(programId, sizeof(infoLog), NULL, infoLog);
-		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-
-		return false;
-	}
-
-	glUseProgram(programId);    // Uses the shader program
-
-	return true;
-}
-
-
-void UDestroyShaderProgram(GLuint programId)
-{
-	glDeleteProgram(programId);
-}
-
-// Images are loaded with Y axis going down, but OpenGL's Y axis goes up, so let's flip it
-void flipImageVertically(unsigned char* image, int width, int height, int channels)
-{
-	for (int j = 0; j < height / 2; ++j)
-	{
-		int index1 = j * width * channels;
-		int index2 = (height - 1 - j) * width * channels;
-
-		for (int i = width * channels; i > 0; --i)
-		{
-			unsigned char tmp = image[index1];
-			image[index1] = image[index2];
-			image[index2] = tmp;
-			++index1;
-			++index2;
-		}
-	}
-}
-
-/*Generate and load the texture*/
-bool UCreateTexture(const char* filename, GLuint& textureId)
-{
-	int width, height, channels;
-	unsigned char* image = stbi_load(filename, &width, &height, &channels, 0);
-	if (image)
-	{
-		stbi_set_flip_vertically_on_load(true); // Flip y-axis during image loading so that image is not upside down
-
-		glGenTextures(1, &textureId);               // Create texture ID
-		glBindTexture(GL_TEXTURE_2D, textureId);    // Bind texure 
-
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);       // Specify how to wrap texture
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);   // Specify how to filter texture
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		if (channels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		else if (channels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		else
-		{
-			cout << "Not implemented to handle image with " << channels << " channels" << endl;
-			return false;
-		}
-
-		glGenerateMipmap(GL_TEXTURE_2D);    // Generate all  required mipmaps for currently bound texture
-
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0);    // Unbind the texture
-
-		return true;
-	}
-
-	return false;
-}
-
-
-void UDestroyTexture(GLuint textureId)
-{
-	glGenTextures(1, &textureId);
-}
-
+#include <iostream>         // cout, cerr
+#include <cstdlib>          // EXIT_FAILURE, strtol
+#include <cfloat>           // FLT_MAX
+#include <climits>          // INT_MAX
+#include <cstring>          // strcmp
+#include <cmath>            // fmod
+#include <algorithm>        // sort
+#include <atomic>
+#include <cassert>
+#include <new>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <GL/glew.h>        // GLEW library
+#include <GLFW/glfw3.h>     // GLFW library
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"   // Image loading Utility functions
+
+// GLM Math Header inclusions
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <../learnOpengl/camera.h>
+
+#include "benchmark.h"
+#include "ecs.h"
+#include "framearena.h"
+#include "glcounters.h"
+#include "glresources.h"
+#include "gpuresources.h"
+#include "input.h"
+#include "jobs.h"
+#include "meshlets.h"
+#include "meshoptimize.h"
+#include "meshpack.h"
+#include "meshprocess.h"
+#include "meshsimplify.h"
+#include "primitivetables.h"
+#include "scenegraph.h"
+#include "streambuffer.h"
+#include "trace.h"
+#include "transforms.h"
+#include "triplebuffer.h"
+#include "vertexcompression.h"
+#include "vertexlayout.h"
+
+using namespace std; // Uses the standard namespace
+
+/*Shader program Macro*/
+#ifndef GLSL
+#define GLSL(Version, Source) "#version " #Version " core \n" #Source
+#endif
+
+// Unnamed namespace
+namespace
+{
+	const char* const WINDOW_TITLE = "Lighting Test"; // Macro for window title
+
+	// Variables for window width and height
+	const int WINDOW_WIDTH = 1800;
+	const int WINDOW_HEIGHT = 900;
+
+	// Per-draw constants that turn the stored vertex attributes back into object space
+	struct VertexDecode
+	{
+		glm::vec4 positionScale;    // position = stored * scale + bias; w is 1 for octahedral normals
+		glm::vec4 positionBias;
+	};
+
+	// A level of detail of a mesh, drawn from a range of its index buffer
+	struct GLMeshLod
+	{
+		GLint firstIndex;
+		GLsizei indexCount;
+		float maxScreenRadius;  // pixels; the level's error shows above this projected radius of the mesh
+	};
+
+	// Stores the GL data relative to a given mesh
+	struct GLMesh
+	{
+		GLuint vao;         // Shared by every mesh of the same vertex format
+		GLuint vertexBuffer;    // gMeshVertexBuffer, which holds every mesh
+		GLintptr vertexOffset;  // bytes to the mesh's first vertex in it
+		GLuint indexBuffer;     // gMeshIndexBuffer; indices count from the mesh's first vertex
+		GLsizei vertexStride;
+		GLuint nVertices;   // Number of vertices of the mesh
+		GLuint nIndices;
+		GLenum indexMode;   // GL_TRIANGLES, or GL_TRIANGLE_STRIP with restarts
+		glm::vec3 boundsMin; // Object-space box around the vertex positions
+		glm::vec3 boundsMax;
+		VertexDecode decode;
+		GLMeshLod lods[MeshPack::MAX_LODS];
+		int lodCount;       // 1 for meshes that only have the full level, 0 for unindexed ones
+		int firstCluster;   // into gClusters
+		int clusterCount;   // 0 for meshes drawn whole
+	};
+
+	// Levels of detail are switched where their error would cover this many pixels
+	const float LOD_PIXEL_ERROR = 1.0f;
+	// A coarser level is taken only once the object is this much smaller than where it would
+	// be allowed, so an object sitting right at a threshold does not flip between levels
+	const float LOD_HYSTERESIS = 0.1f;
+	// Levels are simplified down to half the triangles of the level before, while the full
+	// mesh has at least this many triangles and the error stays under this fraction of its radius
+	const int LOD_MIN_TRIANGLES = 64;
+	const float LOD_MAX_RELATIVE_ERROR = 0.1f;
+	// Full levels with at least this many triangles are also split into meshlets, culled one
+	// by one when the full level is drawn. Only the parametric solids are that dense, and
+	// they are closed with outward faces, as the meshlet facing test needs.
+	const int CLUSTER_MIN_TRIANGLES = 256;
+
+	// A mesh as produced by a generator, before upload; the view points into the vectors
+	struct GeneratedMesh
+	{
+		std::vector<GLfloat> vertices;  // interleaved
+		std::vector<GLuint> indices;
+		std::vector<uint8_t> compactVertices;   // the vertices again in the mesh's vertex encoding
+		std::vector<MeshPack::Meshlet> meshlets;
+		MeshPack::MeshView view;
+		std::ostringstream log;         // written by the job that made the mesh, printed in order afterwards
+	};
+
+	// A distinct mesh to generate on a job worker
+	struct MeshGenerateJob
+	{
+		void (*build)(GeneratedMesh& mesh);
+		const char* name;
+		VertexCompression::Encoding encoding;
+		GeneratedMesh* mesh;
+	};
+
+	// Milliseconds spent in each phase of startup, printed once the first frame can be drawn
+	struct StartupTimes
+	{
+		double meshLoad;        // mapping and checking the mesh pack
+		double meshGenerate;    // generating, optimizing and encoding meshes on the job workers
+		double meshUpload;
+		double meshBake;
+		double shaders;
+		double textures;
+		double total;
+	};
+
+	// Generated meshes are baked here and loaded from here on later starts; --bake-meshes regenerates it
+	const char* const MESH_PACK_FILENAME = "meshes.pack";
+	bool gBakeMeshes = false;
+	bool gFloatVertices = false; // --float-vertices stores every mesh uncompressed, to compare against
+
+	// Main GLFW window
+	GLFWwindow* gWindow = nullptr;
+	// Triangle mesh data
+	GLMesh gTablePlaneMesh; // for plane
+	GLMesh gPyramidMesh; // for Lights 
+	GLMesh gCubeAMesh; // Cube A for Handle 
+	GLMesh gCubeBMesh; // for carving fork 
+	GLMesh gCuttingBoardMesh; // for Cutting Board
+	GLMesh gPrismAMesh;
+	GLMesh gProngBMesh; // For Carving Fork 
+	GLMesh gProngCMesh; // FOr Carving Fork 
+	GLMesh gBowlMesh; // For Bowl
+	GLMesh gCubeCMesh; // For Bowl
+	GLMesh gSauceMesh; // For Sauce
+	GLMesh gTurkeyAMesh; // for turkey body 
+	// Vertices and indices of every mesh, uploaded in one batch
+	GLuint gMeshVertexBuffer = 0;
+	GLuint gMeshIndexBuffer = 0;
+	
+
+	// Shader program
+	GLuint gProgramId;
+	GLuint gSurfaceProgramId;
+	GLuint gLightProgramId;
+	Camera gCameraFront(glm::vec3(-0.5f, 3.5f, 9.0f));
+	Camera* g_pCurrentCamera = NULL;
+	// Texture
+	GLuint gTableTextureId, gPyramidTextureId, gCubeATextureId, gCubeBTextureId, gCuttingBoardTextureId, gPrismATextureId, 
+		gProngBTextureId, gProngCTextureId, gBowlTextureId, gCubeCTextureId, gSauceTextureId, gTurkeyATextureId;
+	glm::vec2 gUVScale(1.0f, 1.0f);
+	GLint gTexWrapMode = GL_REPEAT;
+	
+
+	float gLastX = WINDOW_WIDTH / 2.0f;
+	float gLastY = WINDOW_HEIGHT / 2.0f;
+	float gDeltaTime = 0.0f;
+	double gLastFrame = 0.0;
+	bool perspective = false; 
+	bool gFirstMouse = true;
+
+	// Chrome trace output, set with --trace <file>; F9 dumps on demand
+	const char* gTraceFilename = "trace.json";
+
+	// --no-dsa creates GL resources by binding them, even where direct state access is available
+	bool gNoDirectStateAccess = false;
+
+	// GL call counters, enabled with --gl-counters or toggled with F10
+	bool gStartGLCounters = false;
+	double gLastCounterReport = 0.0;
+
+	// Benchmark mode: --benchmark <camera path> [--frames N] [--benchmark-out <file>]
+	const char* gBenchmarkPathFilename = nullptr;
+	const char* gBenchmarkOutputFilename = "benchmark.json";
+	const int DEFAULT_BENCHMARK_FRAMES = 1000;
+	int gBenchmarkFrames = DEFAULT_BENCHMARK_FRAMES;
+	int gBenchmarkFrame = 0;
+	std::vector<Benchmark::CameraKey> gBenchmarkPath;
+
+	// Camera path recording of a live session, toggled with F8
+	const char* const CAMERA_PATH_FILENAME = "camera_path.txt";
+	bool gRecordingCameraPath = false;
+	float gCameraPathStart = 0.0f;
+	std::vector<Benchmark::CameraKey> gRecordedCameraPath;
+
+	// Fixed-step simulation; frames are drawn between the last two simulated states
+	const float SIMULATION_STEP = 1.0f / 120.0f;
+	const int MAX_SIMULATION_STEPS = 10; // per frame, the rest of a long stall is dropped
+	double gSimulationAccumulator = 0.0;
+	glm::vec3 gPreviousCameraPosition;
+	Camera gRenderCamera; // interpolated copy of the current camera that frame snapshots are built from
+
+	// Rendering is vsynced unless started with --uncapped
+	bool gUncapped = false;
+
+	// Scene entities and their components. Every drawn object has a transform,
+	// mesh, material and bounds; the light fixtures also carry a light.
+	struct TransformComponent
+	{
+		SceneGraph::NodeId node;
+		glm::mat4 world;    // copied from the scene graph after its update
+	};
+
+	// One draw call over a mesh; indexed draws read count indices from index first on
+	struct MeshDraw
+	{
+		GLenum mode;
+		GLint first;
+		GLsizei count;
+		bool indexed;
+	};
+
+	// The vertex array comes from the mesh's vertex format; the mesh's range of the shared buffers is bound to it per draw
+	struct MeshComponent
+	{
+		GLuint vao;
+		GLuint vertexBuffer;
+		GLintptr vertexOffset;
+		GLuint indexBuffer;
+		GLsizei vertexStride;
+		VertexDecode decode;
+		MeshDraw draw;
+	};
+
+	struct MaterialComponent
+	{
+		GLuint programId;
+		GLuint textureId;   // 0 for untextured programs, always sampled from unit 0
+		glm::vec3 color;
+	};
+
+	struct BoundsComponent
+	{
+		glm::vec3 localMin;
+		glm::vec3 localMax;
+		glm::vec3 worldCenter;  // world-space box, updated every frame
+		glm::vec3 worldExtent;
+	};
+
+	// The surface shader lights from position, which is not where the fixture sits
+	struct LightComponent
+	{
+		glm::vec3 color;
+		glm::vec3 position;
+	};
+
+	// Entities of meshes with several levels of detail; culling picks the level
+	// and points the mesh's draw at its indices when indexed
+	struct LodComponent
+	{
+		const GLMesh* mesh;
+		int current;
+	};
+
+	// Entities of meshes split into meshlets; culling draws only the meshlets that face
+	// the camera inside the frustum, while the full level is selected
+	struct ClusterComponent
+	{
+		int firstCluster;
+		int clusterCount;
+	};
+
+	const int MAX_LIGHTS = 2; // light1 and light2 of the surface shader
+
+	struct SceneWorld
+	{
+		Ecs::Registry entities;
+		Ecs::ComponentPool<TransformComponent> transforms;
+		Ecs::ComponentPool<MeshComponent> meshes;
+		Ecs::ComponentPool<MaterialComponent> materials;
+		Ecs::ComponentPool<BoundsComponent> bounds;
+		Ecs::ComponentPool<LightComponent> lights;
+		Ecs::ComponentPool<LodComponent> lods;
+		Ecs::ComponentPool<ClusterComponent> clusters;
+	};
+
+	SceneGraph gScene;
+	SceneWorld gWorld;
+
+	// Composite props; moving one of these moves all of its parts
+	SceneGraph::NodeId gCarvingForkNode;
+	SceneGraph::NodeId gSauceBowlNode;
+	SceneGraph::NodeId gTurkeyNode;
+
+	// Indices of visible meshlets that follow each other in the index buffer, drawn as one triangle list
+	struct ClusterRange
+	{
+		GLint first;
+		GLsizei count;
+	};
+
+	// A visible entity as submitted to GL, with copies of the components the render thread needs
+	struct DrawItem
+	{
+		uint64_t sortKey;
+		glm::mat4 model;
+		MeshComponent mesh;
+		MaterialComponent material;
+		const ClusterRange* clusters;   // replaces the mesh's draw when not null, in the frame's arena
+		int clusterCount;
+	};
+
+	// Everything the render thread needs to draw a frame, filled in by the main thread.
+	// Variable-sized data lives in the snapshot's arena, reset when the slot is written again.
+	struct FrameSnapshot
+	{
+		FrameArena arena;
+		DrawItem* draws;                // sorted to minimize state changes
+		int drawCount;
+		glm::vec3 lightColors[MAX_LIGHTS];
+		glm::vec3 lightPositions[MAX_LIGHTS];
+		int lightCount;
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec3 viewPosition;
+		int framebufferWidth;
+		int framebufferHeight;
+	};
+
+	// Visible entities found by one culling batch, in the arena of the thread that ran it
+	struct CullBatch
+	{
+		DrawItem* draws;
+		int drawCount;
+	};
+
+	struct CullContext
+	{
+		FrameSnapshot* frame;
+		glm::vec4 planes[6];    // normalized, so spheres can be tested against them
+		glm::vec3 viewPosition;
+		float pixelsPerUnit;    // projected size in pixels of one unit at distance one
+		CullBatch* batches;
+	};
+
+	// The FrameData uniform block of the shaders, std140 layout
+	struct FrameUniforms
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec4 viewPosition;
+		glm::vec4 ambient;                  // rgb color, a strength
+		glm::vec4 lightColor[MAX_LIGHTS];
+		glm::vec4 lightPosition[MAX_LIGHTS];
+		glm::vec4 surface;                  // x specular intensity, y highlight size, zw uv scale
+	};
+
+	// One element of the Objects storage block, std430 layout
+	struct ObjectUniforms
+	{
+		glm::mat4 model;
+		glm::vec4 color;
+		VertexDecode decode;
+	};
+
+	// Draws per frame that get object data; the draw id attribute counts up to this
+	const int MAX_STREAM_OBJECTS = 1024;
+	// Meshlet ranges per frame that get an indirect command; clustered draws past these
+	// draw their whole mesh instead
+	const int MAX_STREAM_CLUSTER_RANGES = 4096;
+
+	// Layout of glMultiDrawElementsIndirect's commands
+	struct DrawElementsIndirectCommand
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	// Frame and object data are written by the render thread into a persistently mapped
+	// ring. Each draw is an instanced draw of one instance whose base instance is its
+	// index in the frame; the per-instance draw id attribute turns that into an index
+	// into the object array, since GL 4.4 shaders cannot read gl_BaseInstance. The
+	// indirect commands of meshlet draws go in the same ring.
+	StreamBuffer gStreamBuffer;
+	GLuint gDrawIdBuffer = 0;
+	// Binding point of the draw ids in every vertex array, past the mesh's VertexLayout::VERTEX_BINDING
+	const GLuint DRAW_ID_BINDING = 1;
+
+	// Meshlets of every uploaded mesh, read by the culling jobs; a mesh's are a range of it
+	std::vector<MeshPack::Meshlet> gClusters;
+
+	// An image file decoded into memory, ready for upload
+	struct DecodedImage
+	{
+		const char* filename;
+		unsigned char* pixels;
+		int width;
+		int height;
+		int channels;
+	};
+
+	// The main thread runs input and simulation and publishes a snapshot per frame;
+	// the render thread owns the GL context and draws the newest snapshot
+	TripleBuffer<FrameSnapshot> gSnapshots;
+	int gFramebufferWidth = WINDOW_WIDTH;
+	int gFramebufferHeight = WINDOW_HEIGHT;
+	std::atomic<bool> gToggleGLCounters(false); // F10, applied by the render thread
+
+	// Input log of the session: --record-input <file> or --replay-input <file>
+	const char* gRecordInputFilename = nullptr;
+	const char* gReplayInputFilename = nullptr;
+
+	// Once warmed up, building and drawing a frame must not touch the heap;
+	// transient data goes in the frame arenas instead
+	const int ALLOCATION_WARMUP_FRAMES = 120;
+	const int CULL_BATCH_SIZE = 256;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+/* Surface Vertex Shader Source Code*/
+const GLchar* surfaceVertexShaderSource = GLSL(440,
+
+	layout(location = 0) in vec3 vertexPosition; // VAP position 0 for vertex position data
+layout(location = 1) in vec4 vertexNormal; // VAP position 1 for normals, xyz or octahedral xy
+layout(location = 2) in vec2 textureCoordinate;
+layout(location = 3) in uint drawId; // per instance, index of this draw in the object array
+
+out vec3 vertexFragmentNormal; // For outgoing normals to fragment shader
+out vec3 vertexFragmentPos; // For outgoing color / pixels to fragment shader
+out vec2 vertexTextureCoordinate;
+
+// Frame-wide values, streamed once per frame
+layout(std140, binding = 0) uniform FrameData
+{
+	mat4 view;
+	mat4 projection;
+	vec4 viewPosition;
+	vec4 ambient; // rgb color, a strength
+	vec4 lightColor[2];
+	vec4 lightPosition[2];
+	vec4 surface; // x specular intensity, y highlight size, zw uv scale
+} frame;
+
+// Per-draw values, streamed once per frame for every draw
+struct ObjectData
+{
+	mat4 model;
+	vec4 color;
+	vec4 positionScale; // w is 1 for octahedral normals
+	vec4 positionBias;
+};
+
+layout(std430, binding = 1) readonly buffer Objects
+{
+	ObjectData objects[];
+};
+
+// Unfolds a normal stored on the octahedron
+vec3 UDecodeOctahedral(vec2 e)
+{
+	vec3 n = vec3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	return normalize(n);
+}
+
+void main()
+{
+	ObjectData object = objects[drawId];
+	mat4 model = object.model;
+	vec3 position = vertexPosition * object.positionScale.xyz + object.positionBias.xyz; // Dequantizes 16-bit positions, identity for floats
+	vec3 normal = object.positionScale.w > 0.5 ? UDecodeOctahedral(vertexNormal.xy) : vertexNormal.xyz;
+
+	gl_Position = frame.projection * frame.view * model * vec4(position, 1.0f); // Transforms vertices into clip coordinates
+
+	vertexFragmentPos = vec3(model * vec4(position, 1.0f)); // Gets fragment / pixel position in world space only (exclude view and projection)
+
+	vertexFragmentNormal = mat3(transpose(inverse(model))) * normal; // get normal vectors in world space only and exclude normal translation properties
+	vertexTextureCoordinate = textureCoordinate;
+}
+);
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+/* Surface Fragment Shader Source Code*/
+const GLchar* surfaceFragmentShaderSource = GLSL(440,
+
+	in vec3 vertexFragmentNormal; // For incoming normals
+in vec3 vertexFragmentPos; // For incoming fragment position
+in vec2 vertexTextureCoordinate;
+
+out vec4 fragmentColor; // For outgoing cube color to the GPU
+
+// Light colors and positions, camera/view position and surface parameters, streamed once per frame
+layout(std140, binding = 0) uniform FrameData
+{
+	mat4 view;
+	mat4 projection;
+	vec4 viewPosition;
+	vec4 ambient; // rgb color, a strength
+	vec4 lightColor[2];
+	vec4 lightPosition[2];
+	vec4 surface; // x specular intensity, y highlight size, zw uv scale
+} frame;
+
+layout(binding = 0) uniform sampler2D uTexture; // Every material binds its texture to unit 0
+
+void main()
+{
+	/*Phong lighting model calculations to generate ambient, diffuse, and specular components*/
+
+	//Calculate Ambient lighting
+	vec3 ambient = frame.ambient.a * frame.ambient.rgb; // Generate ambient light color
+
+	//**Calculate Diffuse lighting**
+	vec3 norm = normalize(vertexFragmentNormal); // Normalize vectors to 1 unit
+	vec3 light1Direction = normalize(frame.lightPosition[0].xyz - vertexFragmentPos); // Calculate distance (light direction) between light source and fragments/pixels on cube
+	float impact1 = max(dot(norm, light1Direction), -.9);// Calculate diffuse impact by generating dot product of normal and light
+	vec3 diffuse1 = impact1 * frame.lightColor[0].rgb; // Generate diffuse light color
+	vec3 light2Direction = normalize(frame.lightPosition[1].xyz - vertexFragmentPos); // Calculate distance (light direction) between light source and fragments/pixels on cube
+	float impact2 = max(dot(norm, light2Direction), .3);// Calculate diffuse impact by generating dot product of normal and light
+	vec3 diffuse2 = impact2 * frame.lightColor[1].rgb; // Generate diffuse light color
+
+	//**Calculate Specular lighting**
+	vec3 viewDir = normalize(frame.viewPosition.xyz - vertexFragmentPos); // Calculate view direction
+	vec3 reflectDir1 = reflect(-light1Direction, norm);// Calculate reflection vector
+	//Calculate specular component
+	float specularComponent1 = pow(max(dot(viewDir, reflectDir1), 0.4), frame.surface.y);
+	vec3 specular1 = frame.surface.x * specularComponent1 * frame.lightColor[0].rgb;
+	vec3 reflectDir2 = reflect(-light2Direction, norm);// Calculate reflection vector
+	//Calculate specular component
+	float specularComponent2 = pow(max(dot(viewDir, reflectDir2), 0.1), frame.surface.y);
+	vec3 specular2 = frame.surface.x * specularComponent2 * frame.lightColor[1].rgb;
+
+	//**Calculate phong result**
+	//Texture holds the color to be used for all three components
+	vec4 textureColor = texture(uTexture, vertexTextureCoordinate * frame.surface.zw);
+	vec3 phong1 = (ambient + diffuse1 + specular1) * textureColor.xyz; //objectColor;
+	vec3 phong2 = (ambient + diffuse2 + specular2) * textureColor.xyz; //objectColor;
+
+	fragmentColor = vec4(phong1 + phong2, 8.0); // Send lighting results to GPU
+}
+);
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/* Light Object Shader Source Code*/
+const GLchar* lightVertexShaderSource = GLSL(440,
+	layout(location = 0) in vec3 aPos;
+layout(location = 3) in uint drawId;
+
+layout(std140, binding = 0) uniform FrameData
+{
+	mat4 view;
+	mat4 projection;
+} frame;
+
+struct ObjectData
+{
+	mat4 model;
+	vec4 color;
+	vec4 positionScale; // w is 1 for octahedral normals
+	vec4 positionBias;
+};
+
+layout(std430, binding = 1) readonly buffer Objects
+{
+	ObjectData objects[];
+};
+
+void main()
+{
+	ObjectData object = objects[drawId];
+	vec3 position = aPos * object.positionScale.xyz + object.positionBias.xyz;
+	gl_Position = frame.projection * frame.view * object.model * vec4(position, 1.0);
+}
+);
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/* Light Object Shader Source Code*/
+const GLchar* lightFragmentShaderSource = GLSL(440,
+	out vec4 FragColor;
+
+void main()
+{
+	FragColor = vec4(0.4); // set all 4 vector values to 1.0
+}
+);
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/* User-defined Function prototypes to:
+ * initialize the program, set the window size,
+ * redraw graphics on the window when resized,
+ * and render graphics on the screen
+ */
+bool UInitialize(int, char* [], GLFWwindow** window);
+void UResizeWindow(GLFWwindow* window, int width, int height);
+void UProcessInput(GLFWwindow* window);
+void USimulate(float timeStep);
+float UAdvanceSimulation(float deltaTime);
+void UMousePositionCallBack(GLFWwindow* window, double xpos, double ypos);
+void UMouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
+void UMouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+void UMouseMovement(double xpos, double ypos);
+void UKeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+bool UCreateMeshes(StartupTimes& times);
+void UGenerateMeshJob(void* data);
+void UReportVertexBytes(uint64_t vertexBytes, uint64_t floatBytes);
+void UBuildTablePlaneMesh(GeneratedMesh& mesh);
+void UBuildPyramidMesh(GeneratedMesh& mesh);
+void UBuildCubeMesh(GeneratedMesh& mesh);
+void UBuildPrismMesh(GeneratedMesh& mesh);
+void UBuildPyramidsMesh(GeneratedMesh& mesh);
+void UBuildTorusMesh(GeneratedMesh& mesh);
+void UBuildSphereMesh(GeneratedMesh& mesh);
+void UFinishGeneratedMesh(GeneratedMesh& mesh, const MeshPack::VertexFormat& format);
+void UOptimizeMesh(GeneratedMesh& mesh);
+bool UUploadMeshes(GLMesh* const meshes[], const MeshPack::MeshView views[], int count);
+void UDescribeMesh(GLMesh& mesh, const MeshPack::MeshView& view, GLintptr vertexOffset, GLint baseIndex, int firstCluster);
+void UCreateScene();
+Ecs::Entity UAddEntity(SceneGraph::NodeId parent, const Transform& local, const GLMesh& mesh, const MeshComponent& meshComponent, const MaterialComponent& material);
+void UUpdateSceneComponents();
+void UCollectDraws(FrameSnapshot& frame);
+void UCollectLights(FrameSnapshot& frame);
+void UCheckFrameAllocations(const char* threadName, uint64_t allocations, int frameIndex);
+void URender(const FrameSnapshot& frame);
+void URenderThread();
+void UDestroyMeshBuffers();
+bool UCreateStreamResources();
+void UAttachDrawIds(GLuint vao);
+void UDestroyStreamResources();
+bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId);
+void UDestroyShaderProgram(GLuint programId);
+bool UCreateTexture(const char* filename, GLuint& textureId);
+void UDecodeImageJob(void* data);
+bool UUploadTexture(const DecodedImage& image, GLuint& textureId);
+void UDestroyTexture(GLuint textureId);
+
+// main function. Entry point to the OpenGL program
+int main(int argc, char* argv[])
+{
+	// Micro-benchmarks, run without a window
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--bench-jobs") == 0)
+		{
+			Jobs::RunBenchmark();
+			return EXIT_SUCCESS;
+		}
+		if (strcmp(argv[i], "--bench-transforms") == 0)
+		{
+			Transforms::RunBenchmark();
+			return EXIT_SUCCESS;
+		}
+		if (strcmp(argv[i], "--bench-meshprocess") == 0)
+		{
+			MeshProcess::RunBenchmark();
+			return EXIT_SUCCESS;
+		}
+	}
+
+	if (!UInitialize(argc, argv, &gWindow))
+		return EXIT_FAILURE;
+
+	Trace::SetThreadName("main");
+	Jobs::Initialize();
+	cout << "INFO: Job system running on " << Jobs::ThreadCount() << " threads" << endl;
+
+	StartupTimes startup = {};
+	double startupBegin = glfwGetTime();
+
+	// Create the meshes
+	if (!UCreateMeshes(startup))
+		return EXIT_FAILURE;
+	
+
+
+	// Create the shader program
+	double shadersBegin = glfwGetTime();
+	if (!UCreateShaderProgram(surfaceVertexShaderSource, surfaceFragmentShaderSource, gSurfaceProgramId))
+		return EXIT_FAILURE;
+
+	if (!UCreateShaderProgram(lightVertexShaderSource, lightFragmentShaderSource, gLightProgramId))
+		return EXIT_FAILURE;
+	startup.shaders = (glfwGetTime() - shadersBegin) * 1000.0;
+
+	if (!UCreateStreamResources())
+		return EXIT_FAILURE;
+	const GLMesh* const meshes[] = { &gTablePlaneMesh, &gPyramidMesh, &gCubeAMesh, &gCubeBMesh, &gCuttingBoardMesh, &gPrismAMesh,
+		&gProngBMesh, &gProngCMesh, &gBowlMesh, &gCubeCMesh, &gSauceMesh, &gTurkeyAMesh };
+	// Meshes of one vertex format share a vertex array, so most of these set up one already done
+	for (const GLMesh* mesh : meshes)
+		UAttachDrawIds(mesh->vao);
+	cout << "INFO: " << sizeof(meshes) / sizeof(meshes[0]) << " meshes share " << VertexLayout::SharedCount() << " vertex arrays" << endl;
+
+	// Load texture
+	double texturesBegin = glfwGetTime();
+	Trace::Begin("UCreateTextures");
+	struct TextureLoad
+	{
+		const char* filename;
+		GLuint* textureId;
+	};
+	const TextureLoad textureLoads[] =
+	{
+		{ "tablePlane.png", &gTableTextureId },
+		{ "wood.png", &gCubeATextureId },
+		{ "this.png", &gCubeBTextureId },
+		{ "stone.png", &gCuttingBoardTextureId },
+		{ "this.png", &gPrismATextureId },
+		{ "this.png", &gProngBTextureId },
+		{ "this.png", &gProngCTextureId },
+		{ "clay.png", &gBowlTextureId },
+		{ "handle.png", &gCubeCTextureId },
+		{ "sauce.png", &gSauceTextureId },
+		{ "tbskin.png", &gTurkeyATextureId }
+	};
+	const int TEXTURE_COUNT = sizeof(textureLoads) / sizeof(textureLoads[0]);
+
+	// Decode every image on the job workers, then upload them here where the context is current
+	DecodedImage images[TEXTURE_COUNT] = {};
+	Jobs::Counter decodeCounter;
+	for (int i = 0; i < TEXTURE_COUNT; ++i)
+	{
+		images[i].filename = textureLoads[i].filename;
+		Jobs::Run(UDecodeImageJob, &images[i], &decodeCounter);
+	}
+	Jobs::Wait(&decodeCounter);
+
+	for (int i = 0; i < TEXTURE_COUNT; ++i)
+	{
+		if (!UUploadTexture(images[i], *textureLoads[i].textureId))
+		{
+			cout << "Failed to load texture " << images[i].filename << endl;
+			return EXIT_FAILURE;
+		}
+	}
+	Trace::End();
+	startup.textures = (glfwGetTime() - texturesBegin) * 1000.0;
+	startup.total = (glfwGetTime() - startupBegin) * 1000.0;
+	cout << "INFO: Startup took " << startup.total << " ms: meshes " << startup.meshLoad << " loading, " << startup.meshGenerate << " generating on "
+		<< Jobs::ThreadCount() << " threads, " << startup.meshUpload << " uploading, " << startup.meshBake << " baking; shaders "
+		<< startup.shaders << "; textures " << startup.textures << endl;
+
+	GpuResources::PrintReport();
+	
+	
+	
+	// tell opengl for each sampler to which texture unit it belongs to (only has to be done once)
+	glUseProgram(gSurfaceProgramId);
+	// We set the texture as texture unit 0
+
+
+	// Sets the background color of the window to black (it will be implicitely used by glClear)
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+	gCameraFront.Front = glm::vec3(0.0, -1.0, -1.0f);
+	gCameraFront.Up = glm::vec3(0.0, 0.0, 0.0);
+	g_pCurrentCamera = &gCameraFront;
+	gPreviousCameraPosition = g_pCurrentCamera->Position;
+
+	UCreateScene();
+
+	if (gBenchmarkPathFilename)
+	{
+		if (!Benchmark::LoadCameraPath(gBenchmarkPathFilename, gBenchmarkPath))
+		{
+			cout << "Failed to load camera path " << gBenchmarkPathFilename << endl;
+			return EXIT_FAILURE;
+		}
+		cout << "INFO: Benchmarking " << gBenchmarkFrames << " frames of " << gBenchmarkPathFilename << endl;
+		Benchmark::Start(gBenchmarkFrames);
+	}
+
+	if (gReplayInputFilename)
+	{
+		if (!Input::StartReplay(gReplayInputFilename))
+		{
+			cout << "Failed to load input log " << gReplayInputFilename << endl;
+			return EXIT_FAILURE;
+		}
+		cout << "INFO: Replaying input from " << gReplayInputFilename << endl;
+	}
+	else if (gRecordInputFilename)
+	{
+		if (!Input::StartRecording(gRecordInputFilename))
+		{
+			cout << "Failed to create input log " << gRecordInputFilename << endl;
+			return EXIT_FAILURE;
+		}
+		cout << "INFO: Recording input to " << gRecordInputFilename << endl;
+	}
+
+	// Hand the context over to the render thread
+	glfwMakeContextCurrent(NULL);
+	std::thread renderThread(URenderThread);
+
+	// simulation loop
+	// -----------
+	int frameIndex = 0;
+	while (!glfwWindowShouldClose(gWindow))
+	{
+		TRACE_SCOPE("Frame");
+
+		// per-frame timing
+		// --------------------
+		double currentFrame = glfwGetTime();
+		gDeltaTime = (float)(currentFrame - gLastFrame);
+		gLastFrame = currentFrame;
+
+		// input and simulation
+		// --------------------
+		float interpolation = 1.0f;
+		if (gBenchmarkPathFilename)
+		{
+			// Scripted camera on a fixed virtual timestep so every run renders the same frames
+			gDeltaTime = Benchmark::TIMESTEP;
+			Benchmark::ApplyCameraKey(*g_pCurrentCamera, Benchmark::SampleCameraPath(gBenchmarkPath, gBenchmarkFrame * Benchmark::TIMESTEP));
+			++gBenchmarkFrame;
+		}
+		else
+		{
+			// A replay also supplies the delta time of each recorded frame
+			if (!Input::BeginFrame(currentFrame, gDeltaTime))
+			{
+				cout << "INFO: Input replay finished" << endl;
+				glfwSetWindowShouldClose(gWindow, true);
+			}
+			UProcessInput(gWindow);
+			interpolation = UAdvanceSimulation(gDeltaTime);
+		}
+
+		// Draw from between the last two simulated camera positions so motion stays smooth at any frame rate
+		gRenderCamera = *g_pCurrentCamera;
+		if (!gBenchmarkPathFilename)
+			gRenderCamera.Position = glm::mix(gPreviousCameraPosition, g_pCurrentCamera->Position, interpolation);
+
+		if (gRecordingCameraPath)
+			gRecordedCameraPath.push_back(Benchmark::CaptureCameraKey(gRenderCamera, (float)(currentFrame - gCameraPathStart)));
+
+		uint64_t allocationsBefore = HeapTracking::ThreadAllocationCount();
+
+		// Only moved objects get new world matrices
+		Trace::Begin("SceneGraph::Update");
+		gScene.Update();
+		Trace::End();
+
+		UUpdateSceneComponents();
+
+		// Publish the frame to the render thread; nothing reads this slot any more
+		FrameSnapshot& snapshot = gSnapshots.WriteSlot();
+		snapshot.arena.Reset();
+		snapshot.view = gRenderCamera.GetViewMatrix();
+		snapshot.projection = glm::perspective(glm::radians(gRenderCamera.Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
+		snapshot.viewPosition = gRenderCamera.Position;
+		snapshot.framebufferWidth = gFramebufferWidth;
+		snapshot.framebufferHeight = gFramebufferHeight;
+		UCollectDraws(snapshot);
+		UCollectLights(snapshot);
+		gSnapshots.Publish();
+
+		UCheckFrameAllocations("main", HeapTracking::ThreadAllocationCount() - allocationsBefore, frameIndex++);
+
+		Trace::Begin("glfwPollEvents");
+		glfwPollEvents();
+		Trace::End();
+
+		// Stay at most one frame ahead of the render thread
+		Trace::Begin("WaitForRender");
+		gSnapshots.WaitUntilTaken();
+		Trace::End();
+	}
+
+	// Take the context back to release GPU resources
+	gSnapshots.Close();
+	renderThread.join();
+	glfwMakeContextCurrent(gWindow);
+
+	// Write out the timeline of the run when tracing was requested
+	if (Trace::IsEnabled())
+	{
+		if (Trace::WriteChromeJson(gTraceFilename))
+			cout << "INFO: Trace written to " << gTraceFilename << endl;
+		else
+			cout << "Failed to write trace " << gTraceFilename << endl;
+	}
+
+	Input::StopRecording();
+
+	// Release mesh data
+	UDestroyMeshBuffers();
+	VertexLayout::DestroyShared();
+
+	// Release texture data
+	UDestroyTexture(gTableTextureId);
+	UDestroyTexture(gCubeATextureId);
+	UDestroyTexture(gCubeBTextureId);
+	UDestroyTexture(gCuttingBoardTextureId);
+	UDestroyTexture(gPrismATextureId);
+	UDestroyTexture(gProngBTextureId);
+	UDestroyTexture(gProngCTextureId);
+	UDestroyTexture(gBowlTextureId);
+	UDestroyTexture(gCubeCTextureId);
+	UDestroyTexture(gSauceTextureId);
+	UDestroyTexture(gTurkeyATextureId);
+	
+	
+	
+	
+	
+	
+
+	cout << "INFO: Stream buffer waited on the GPU in " << gStreamBuffer.StallCount() << " frames" << endl;
+	UDestroyStreamResources();
+
+	UDestroyShaderProgram(gSurfaceProgramId);
+	UDestroyShaderProgram(gLightProgramId);
+
+	// Anything still tracked at this point was never freed
+	if (GpuResources::ReportLeaks() == 0)
+		cout << "INFO: No GPU resources leaked" << endl;
+
+	Jobs::Shutdown();
+
+	exit(EXIT_SUCCESS); // Terminates the program successfully
+}
+
+
+// Initialize GLFW, GLEW, and create a window
+bool UInitialize(int argc, char* argv[], GLFWwindow** window)
+{
+	// Command line options
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+		{
+			gTraceFilename = argv[++i];
+			Trace::SetEnabled(true);
+		}
+		else if (strcmp(argv[i], "--gl-counters") == 0)
+			gStartGLCounters = true;
+		else if (strcmp(argv[i], "--benchmark") == 0 && i + 1 < argc)
+			gBenchmarkPathFilename = argv[++i];
+		else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+		{
+			// A count that is not a whole positive number would leave the benchmark without samples
+			const char* text = argv[++i];
+			char* end = nullptr;
+			long frames = strtol(text, &end, 10);
+			if (end == text || *end != '\0' || frames <= 0 || frames > INT_MAX)
+			{
+				cout << "Failed to parse --frames " << text << ", benchmarking " << DEFAULT_BENCHMARK_FRAMES << " frames" << endl;
+				gBenchmarkFrames = DEFAULT_BENCHMARK_FRAMES;
+			}
+			else
+				gBenchmarkFrames = (int)frames;
+		}
+		else if (strcmp(argv[i], "--benchmark-out") == 0 && i + 1 < argc)
+			gBenchmarkOutputFilename = argv[++i];
+		else if (strcmp(argv[i], "--uncapped") == 0)
+			gUncapped = true;
+		else if (strcmp(argv[i], "--bake-meshes") == 0)
+			gBakeMeshes = true;
+		else if (strcmp(argv[i], "--float-vertices") == 0)
+			gFloatVertices = true;
+		else if (strcmp(argv[i], "--no-dsa") == 0)
+			gNoDirectStateAccess = true;
+		else if (strcmp(argv[i], "--record-input") == 0 && i + 1 < argc)
+			gRecordInputFilename = argv[++i];
+		else if (strcmp(argv[i], "--replay-input") == 0 && i + 1 < argc)
+			gReplayInputFilename = argv[++i];
+	}
+
+	// GLFW: initialize and configure
+	// ------------------------------
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#ifdef __APPLE__
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
+	// Benchmarks run headless
+	if (gBenchmarkPathFilename)
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+	// GLFW: window creation
+	// ---------------------
+	* window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE, NULL, NULL);
+	if (*window == NULL)
+	{
+		std::cout << "Failed to create GLFW window" << std::endl;
+		glfwTerminate();
+		return false;
+	}
+	glfwMakeContextCurrent(*window);  // Make context current for calling thread
+	glfwGetFramebufferSize(*window, &gFramebufferWidth, &gFramebufferHeight);
+	if (gBenchmarkPathFilename || gUncapped)
+		glfwSwapInterval(0); // measure frame cost, not the display refresh
+	else
+		glfwSwapInterval(1);
+	glfwSetFramebufferSizeCallback(*window, UResizeWindow);
+	glfwSetCursorPosCallback(*window, UMousePositionCallBack);
+	glfwSetScrollCallback(*window, UMouseScrollCallback);
+	glfwSetKeyCallback(*window, UKeyCallback);
+	glfwSetInputMode(*window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+
+	// GLEW: initialize
+	// ----------------
+	// Note: if using GLEW version 1.13 or earlier
+	glewExperimental = GL_TRUE;
+	GLenum GlewInitResult = glewInit();
+
+	if (GLEW_OK != GlewInitResult)
+	{
+		std::cerr << glewGetErrorString(GlewInitResult) << std::endl;
+		return false;
+	}
+
+	// Displays GPU OpenGL version
+	cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << endl;
+
+	GLCounters::Install();
+	GLCounters::SetEnabled(gStartGLCounters);
+
+	GLResources::Initialize(!gNoDirectStateAccess);
+	cout << "INFO: Resources created with " << (GLResources::IsDirect() ? "direct state access" : "bind-to-edit") << endl;
+
+	return true;
+}
+
+
+// process all input: apply the mouse events of this frame; held keys are handled by the simulation steps
+void UProcessInput(GLFWwindow* window)
+{
+	TRACE_SCOPE("UProcessInput");
+
+	Input::Event event;
+	while (Input::PollEvent(event))
+	{
+		if (event.type == Input::EVENT_CURSOR)
+			UMouseMovement(event.x, event.y);
+		else if (event.type == Input::EVENT_SCROLL)
+			g_pCurrentCamera->ProcessMouseScroll(event.y);
+	}
+
+	if (Input::IsKeyDown(GLFW_KEY_ESCAPE))
+		glfwSetWindowShouldClose(window, true);
+}
+
+
+// One fixed simulation step: moves the camera for the keys held down
+void USimulate(float timeStep)
+{
+	if (Input::IsKeyDown(GLFW_KEY_W))
+		g_pCurrentCamera->ProcessKeyboard(FORWARD, timeStep);
+	if (Input::IsKeyDown(GLFW_KEY_S))
+		g_pCurrentCamera->ProcessKeyboard(BACKWARD, timeStep);
+	if (Input::IsKeyDown(GLFW_KEY_A))
+		g_pCurrentCamera->ProcessKeyboard(LEFT, timeStep);
+	if (Input::IsKeyDown(GLFW_KEY_D))
+		g_pCurrentCamera->ProcessKeyboard(RIGHT, timeStep);
+
+	float velocity = g_pCurrentCamera->MovementSpeed * timeStep;
+	if (Input::IsKeyDown(GLFW_KEY_E))
+		g_pCurrentCamera->Position -= g_pCurrentCamera->Up * velocity;
+	if (Input::IsKeyDown(GLFW_KEY_Q))
+		g_pCurrentCamera->Position += g_pCurrentCamera->Up * velocity;
+}
+
+
+// Runs as many fixed steps as the frame time covers; returns how far into the next step the frame is (0 to 1)
+float UAdvanceSimulation(float deltaTime)
+{
+	TRACE_SCOPE("UAdvanceSimulation");
+
+	gSimulationAccumulator += deltaTime;
+	int steps = 0;
+	while (gSimulationAccumulator >= SIMULATION_STEP)
+	{
+		if (steps == MAX_SIMULATION_STEPS)
+		{
+			gSimulationAccumulator = fmod(gSimulationAccumulator, SIMULATION_STEP);
+			break;
+		}
+
+		gPreviousCameraPosition = g_pCurrentCamera->Position;
+		USimulate(SIMULATION_STEP);
+		gSimulationAccumulator -= SIMULATION_STEP;
+		++steps;
+	}
+	return (float)(gSimulationAccumulator / SIMULATION_STEP);
+}
+
+
+// glfw: whenever the window size changed (by OS or user resize) this callback function executes
+// The viewport is set by the render thread, which owns the context
+void UResizeWindow(GLFWwindow* window, int width, int height)
+{
+	gFramebufferWidth = width;
+	gFramebufferHeight = height;
+}
+void UMousePositionCallBack(GLFWwindow* window, double xpos, double ypos)
+{
+	Input::PushCursor(glfwGetTime(), xpos, ypos);
+}
+
+// Mouse look from a cursor event
+void UMouseMovement(double xpos, double ypos)
+{
+	if (gFirstMouse)
+	{
+		gLastX = xpos;
+		gLastY = ypos;
+		gFirstMouse = false;
+	}
+
+	float xoffset = xpos - gLastX;
+	float yoffset = gLastY - ypos; // reversed since y-coordinates go from bottom to top
+
+	gLastX = xpos;
+	gLastY = ypos;
+
+	g_pCurrentCamera->ProcessMouseMovement(xoffset, yoffset);
+}
+
+void UMouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset)
+{
+	Input::PushScroll(glfwGetTime(), xoffset, yoffset);
+}
+
+// glfw: key events feed the input queue; one-shot tool keys are handled here directly
+void UKeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+	Input::PushKey(glfwGetTime(), key, action);
+
+	if (action != GLFW_PRESS)
+		return;
+
+	// Live keys are ignored during a replay, so Escape is checked here to stop it early
+	if (key == GLFW_KEY_ESCAPE && Input::IsReplaying())
+		glfwSetWindowShouldClose(window, true);
+
+	// F9: start tracing, or dump the timeline recorded so far
+	if (key == GLFW_KEY_F9)
+	{
+		if (!Trace::IsEnabled())
+		{
+			Trace::SetEnabled(true);
+			cout << "INFO: Tracing started, press F9 again to write " << gTraceFilename << endl;
+		}
+		else if (Trace::WriteChromeJson(gTraceFilename))
+			cout << "INFO: Trace written to " << gTraceFilename << endl;
+		else
+			cout << "Failed to write trace " << gTraceFilename << endl;
+	}
+
+	// F10: toggle GL call counting, done between frames on the render thread
+	if (key == GLFW_KEY_F10)
+		gToggleGLCounters = true;
+
+	// F8: record the camera path of this session for use with --benchmark
+	if (key == GLFW_KEY_F8)
+	{
+		gRecordingCameraPath = !gRecordingCameraPath;
+		if (gRecordingCameraPath)
+		{
+			gRecordedCameraPath.clear();
+			gCameraPathStart = glfwGetTime();
+			cout << "INFO: Recording camera path, press F8 again to save" << endl;
+		}
+		else if (Benchmark::SaveCameraPath(CAMERA_PATH_FILENAME, gRecordedCameraPath))
+			cout << "INFO: Camera path written to " << CAMERA_PATH_FILENAME << endl;
+		else
+			cout << "Failed to write camera path " << CAMERA_PATH_FILENAME << endl;
+	}
+
+	// F11: print GPU memory usage
+	if (key == GLFW_KEY_F11)
+		GpuResources::PrintReport();
+}
+
+
+
+// The draw call of a mesh: its index buffer in the mode it was baked in, or a plain
+// triangle list over its vertices for meshes without indices
+MeshComponent UMeshComponent(const GLMesh& mesh)
+{
+	MeshComponent component = {};
+	component.vao = mesh.vao;
+	component.vertexBuffer = mesh.vertexBuffer;
+	component.vertexOffset = mesh.vertexOffset;
+	component.indexBuffer = mesh.indexBuffer;
+	component.vertexStride = mesh.vertexStride;
+	component.decode = mesh.decode;
+	if (mesh.nIndices > 0)
+		component.draw = { mesh.indexMode, mesh.lods[0].firstIndex, mesh.lods[0].indexCount, true };
+	else
+		component.draw = { GL_TRIANGLES, 0, (GLsizei)mesh.nVertices, false };
+	return component;
+}
+
+MaterialComponent USurfaceMaterial(GLuint textureId, const glm::vec3& color)
+{
+	MaterialComponent material;
+	material.programId = gSurfaceProgramId;
+	material.textureId = textureId;
+	material.color = color;
+	return material;
+}
+
+// Creates a drawn entity placed by a new scene graph node under parent
+Ecs::Entity UAddEntity(SceneGraph::NodeId parent, const Transform& local, const GLMesh& mesh, const MeshComponent& meshComponent, const MaterialComponent& material)
+{
+	Ecs::Entity entity = gWorld.entities.Create();
+
+	TransformComponent transform;
+	transform.node = gScene.AddNode(parent, local);
+	transform.world = glm::mat4(1.0f);
+	gWorld.transforms.Add(entity, transform);
+
+	BoundsComponent bounds;
+	bounds.localMin = mesh.boundsMin;
+	bounds.localMax = mesh.boundsMax;
+	gWorld.bounds.Add(entity, bounds);
+
+	gWorld.meshes.Add(entity, meshComponent);
+	gWorld.materials.Add(entity, material);
+	if (mesh.lodCount > 1)
+		gWorld.lods.Add(entity, { &mesh, 0 });
+	if (mesh.clusterCount > 0)
+		gWorld.clusters.Add(entity, { mesh.firstCluster, mesh.clusterCount });
+	return entity;
+}
+
+
+// Builds the scene: an entity for every drawn object, placed through the scene graph
+void UCreateScene()
+{
+	const glm::vec3 diagonalAxis(1.0f, 1.0f, 1.0f);
+
+	UAddEntity(SceneGraph::ROOT,
+		Transform::FromAngleAxis(glm::vec3(0.0f, 0.0f, 0.0f), 0.0f, diagonalAxis, glm::vec3(5.0f, 2.5f, 5.0f)),
+		gTablePlaneMesh, UMeshComponent(gTablePlaneMesh), USurfaceMaterial(gTableTextureId, glm::vec3(0.5f, 0.5f, 0.5f)));
+	UAddEntity(SceneGraph::ROOT,
+		Transform::FromAngleAxis(glm::vec3(4.5f, 0.53f, 3.7f), 0.0f, glm::vec3(1.7f, 1.0f, 1.0f), glm::vec3(0.9f, 0.9f, 2.5f)),
+		gCubeAMesh, UMeshComponent(gCubeAMesh), USurfaceMaterial(gCubeATextureId, glm::vec3(1.0f, 1.0f, 1.0f)));
+	UAddEntity(SceneGraph::ROOT,
+		Transform::FromAngleAxis(glm::vec3(2.0f, 0.0f, 0.7f), 0.0f, glm::vec3(1.7f, 1.0f, 1.0f), glm::vec3(5.9f, 0.1f, 8.0f)),
+		gCuttingBoardMesh, UMeshComponent(gCuttingBoardMesh), USurfaceMaterial(gCuttingBoardTextureId, glm::vec3(1.0f, 0.0f, 1.0f)));
+
+	// Carving fork: handle, head and two prongs
+	gCarvingForkNode = gScene.AddNode(SceneGraph::ROOT, Transform());
+	UAddEntity(gCarvingForkNode,
+		Transform::FromAngleAxis(glm::vec3(4.5f, 0.4f, 1.3f), 0.0f, glm::vec3(1.7f, 1.0f, 1.0f), glm::vec3(0.9f, 0.3f, 2.5f)),
+		gCubeBMesh, UMeshComponent(gCubeBMesh), USurfaceMaterial(gCubeBTextureId, glm::vec3(1.0f, 1.0f, 0.8f)));
+	UAddEntity(gCarvingForkNode,
+		Transform::FromAngleAxis(glm::vec3(9.49f, 1.47f, -1.54f), 10.5f, diagonalAxis, glm::vec3(4.99f, 5.5f, 1.3f)),
+		gPrismAMesh, UMeshComponent(gPrismAMesh), USurfaceMaterial(gPrismATextureId, glm::vec3(1.0f, 1.0f, 0.8f)));
+	UAddEntity(gCarvingForkNode,
+		Transform::FromAngleAxis(glm::vec3(6.3f, 0.7f, -3.8f), 180.0f, diagonalAxis, glm::vec3(10.0f, 1.4f, 0.8f)),
+		gProngBMesh, UMeshComponent(gProngBMesh), USurfaceMaterial(gProngBTextureId, glm::vec3(1.0f, 1.0f, 0.8f)));
+	UAddEntity(gCarvingForkNode,
+		Transform::FromAngleAxis(glm::vec3(5.8f, 0.7f, -3.8f), 180.0f, diagonalAxis, glm::vec3(10.0f, 1.4f, 0.8f)),
+		gProngCMesh, UMeshComponent(gProngCMesh), USurfaceMaterial(gProngCTextureId, glm::vec3(1.0f, 1.0f, 0.6f)));
+
+	// Sauce bowl with its spoon and sauce
+	gSauceBowlNode = gScene.AddNode(SceneGraph::ROOT, Transform());
+	UAddEntity(gSauceBowlNode,
+		Transform::FromAngleAxis(glm::vec3(-3.0f, 0.5f, 3.0f), -4.0f, glm::vec3(-5.0f, -6.0f, -6.0f), glm::vec3(1.0f, 1.0f, 4.0f)),
+		gBowlMesh, UMeshComponent(gBowlMesh), USurfaceMaterial(gBowlTextureId, glm::vec3(1.0f, 1.0f, 0.6f)));
+	UAddEntity(gSauceBowlNode,
+		Transform::FromAngleAxis(glm::vec3(-3.0f, 1.3f, 3.0f), -0.2f, glm::vec3(1.3f, 1.0f, 1.0f), glm::vec3(0.2f, 2.0f, 0.2f)),
+		gCubeCMesh, UMeshComponent(gCubeCMesh), USurfaceMaterial(gCubeCTextureId, glm::vec3(1.0f, 1.0f, 1.0f)));
+	UAddEntity(gSauceBowlNode,
+		Transform::FromAngleAxis(glm::vec3(-3.0f, 0.6f, 3.0f), -0.2f, glm::vec3(1.3f, 1.0f, 1.0f), glm::vec3(1.0f, 0.2f, 1.0f)),
+		gSauceMesh, UMeshComponent(gSauceMesh), USurfaceMaterial(gSauceTextureId, glm::vec3(1.0f, 0.0f, 0.0f)));
+
+	// Turkey body and legs
+	gTurkeyNode = gScene.AddNode(SceneGraph::ROOT, Transform());
+	UAddEntity(gTurkeyNode,
+		Transform::FromAngleAxis(glm::vec3(2.0f, 0.6f, -2.2f), -0.2f, glm::vec3(1.3f, 1.0f, 1.0f), glm::vec3(2.0f, 1.5f, 6.0f)),
+		gTurkeyAMesh, UMeshComponent(gTurkeyAMesh), USurfaceMaterial(gTurkeyATextureId, glm::vec3(1.0f, 1.0f, 0.6f)));
+	UAddEntity(gTurkeyNode,
+		Transform::FromAngleAxis(glm::vec3(2.0f, 0.9f, -2.0f), -0.2f, glm::vec3(1.3f, 1.0f, -1.7f), glm::vec3(2.0f, 1.5f, 4.0f)),
+		gTurkeyAMesh, UMeshComponent(gTurkeyAMesh), USurfaceMaterial(gTurkeyATextureId, glm::vec3(1.0f, 1.0f, 0.6f)));
+	UAddEntity(gTurkeyNode,
+		Transform::FromAngleAxis(glm::vec3(2.0f, 1.9f, -0.3f), 0.9f, glm::vec3(-2.3f, -2.0f, 0.3f), glm::vec3(2.0f, 0.7f, 0.5f)),
+		gTurkeyAMesh, UMeshComponent(gTurkeyAMesh), USurfaceMaterial(gTurkeyATextureId, glm::vec3(1.0f, 1.0f, 0.6f)));
+	UAddEntity(gTurkeyNode,
+		Transform::FromAngleAxis(glm::vec3(3.0f, 0.6f, -0.3f), 0.9f, glm::vec3(-2.3f, -2.0f, 0.3f), glm::vec3(2.0f, 0.7f, 0.5f)),
+		gTurkeyAMesh, UMeshComponent(gTurkeyAMesh), USurfaceMaterial(gTurkeyATextureId, glm::vec3(1.0f, 1.0f, 0.6f)));
+
+	// Light fixtures, drawn with the light shader
+	MaterialComponent fixture = {};
+	fixture.programId = gLightProgramId;
+
+	Ecs::Entity lightA = UAddEntity(SceneGraph::ROOT,
+		Transform::FromAngleAxis(glm::vec3(0.4f, 9.0f, -2.0f), -0.2f, glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.1f, 1.0f)),
+		gPyramidMesh, UMeshComponent(gPyramidMesh), fixture);
+	gWorld.lights.Add(lightA, { glm::vec3(0.5f, 0.5f, 0.5f), glm::vec3(1.5f, 1.0f, 1.0f) }); // white light from the left
+
+	Ecs::Entity lightB = UAddEntity(SceneGraph::ROOT,
+		Transform::FromAngleAxis(glm::vec3(0.9f, 9.0f, -1.0f), -0.5f, glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(2.0f, 2.0f, 2.0f)),
+		gPyramidMesh, UMeshComponent(gPyramidMesh), fixture);
+	gWorld.lights.Add(lightB, { glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(0.5f, 1.0f, 1.0f) });
+
+	gScene.Update();
+	UUpdateSceneComponents();
+}
+
+
+// Pulls the world matrices of the scene graph into the transform components and
+// refits the world-space boxes around them
+void UUpdateSceneComponents()
+{
+	TRACE_SCOPE("UUpdateSceneComponents");
+
+	Ecs::View(gWorld.transforms, [](Ecs::Entity, TransformComponent& transform)
+	{
+		transform.world = gScene.GetWorld(transform.node);
+	});
+
+	Ecs::View(gWorld.bounds, gWorld.transforms, [](Ecs::Entity, BoundsComponent& bounds, const TransformComponent& transform)
+	{
+		// Box of the transformed box: the center moves, the extent is spread by the absolute matrix
+		glm::vec3 center = (bounds.localMin + bounds.localMax) * 0.5f;
+		glm::vec3 extent = (bounds.localMax - bounds.localMin) * 0.5f;
+		const glm::mat4& m = transform.world;
+		bounds.worldCenter = glm::vec3(m * glm::vec4(center, 1.0f));
+		for (int row = 0; row < 3; ++row)
+		{
+			bounds.worldExtent[row] = fabs(m[0][row]) * extent.x + fabs(m[1][row]) * extent.y + fabs(m[2][row]) * extent.z;
+		}
+	});
+}
+
+
+// The coarsest level whose error stays under LOD_PIXEL_ERROR at screenRadius. Going
+// finer happens as soon as the current level is too coarse, going coarser only with
+// LOD_HYSTERESIS to spare.
+int USelectLod(const GLMesh& mesh, int current, float screenRadius)
+{
+	int lod = current;
+	while (lod > 0 && screenRadius > mesh.lods[lod].maxScreenRadius)
+		--lod;
+	while (lod + 1 < mesh.lodCount && screenRadius <= mesh.lods[lod + 1].maxScreenRadius * (1.0f - LOD_HYSTERESIS))
+		++lod;
+	return lod;
+}
+
+// Keeps the meshlets of a draw that are in the frustum and face the camera, merging
+// neighbours in the index buffer into one range; false when none are left
+bool UCullClusters(const CullContext& context, const ClusterComponent& clusters, DrawItem& draw)
+{
+	// Facing is tested where the cones were made, in object space; the side of a triangle
+	// the camera is on stays the same through any transform
+	glm::vec3 objectView = glm::vec3(glm::inverse(draw.model) * glm::vec4(context.viewPosition, 1.0f));
+	// Spheres are tested in world space, grown by the largest scale of the model
+	const glm::mat4& m = draw.model;
+	float scale = sqrtf(glm::max(glm::dot(m[0], m[0]), glm::max(glm::dot(m[1], m[1]), glm::dot(m[2], m[2]))));
+
+	ClusterRange* ranges = context.frame->arena.Allocate<ClusterRange>(clusters.clusterCount);
+	int rangeCount = 0;
+	GLint rangeEnd = -1;
+	for (int c = 0; c < clusters.clusterCount; ++c)
+	{
+		const MeshPack::Meshlet& cluster = gClusters[clusters.firstCluster + c];
+		if (Meshlets::IsBackFacing(cluster, glm::value_ptr(objectView)))
+			continue;
+
+		glm::vec3 center = glm::vec3(m * glm::vec4(cluster.center[0], cluster.center[1], cluster.center[2], 1.0f));
+		float radius = cluster.radius * scale;
+		bool visible = true;
+		for (int p = 0; p < 6 && visible; ++p)
+			visible = glm::dot(glm::vec3(context.planes[p]), center) + context.planes[p].w >= -radius;
+		if (!visible)
+			continue;
+
+		if ((GLint)cluster.firstIndex == rangeEnd)
+			ranges[rangeCount - 1].count += (GLsizei)cluster.indexCount;
+		else
+			ranges[rangeCount++] = { (GLint)cluster.firstIndex, (GLsizei)cluster.indexCount };
+		rangeEnd = (GLint)(cluster.firstIndex + cluster.indexCount);
+	}
+
+	draw.clusters = ranges;
+	draw.clusterCount = rangeCount;
+	return rangeCount > 0;
+}
+
+void UCullBatch(int begin, int end, void* data)
+{
+	CullContext* context = (CullContext*)data;
+	CullBatch& batch = context->batches[begin / CULL_BATCH_SIZE];
+	batch.draws = context->frame->arena.Allocate<DrawItem>(end - begin);
+	batch.drawCount = 0;
+
+	for (int i = begin; i < end; ++i)
+	{
+		const BoundsComponent& bounds = gWorld.bounds.At(i);
+		bool visible = true;
+		for (int p = 0; p < 6 && visible; ++p)
+		{
+			glm::vec3 normal(context->planes[p].x, context->planes[p].y, context->planes[p].z);
+			float distance = glm::dot(normal, bounds.worldCenter) + context->planes[p].w;
+			float radius = glm::dot(glm::abs(normal), bounds.worldExtent);
+			visible = distance + radius >= 0.0f;
+		}
+
+		// Only the visible entities look at their mesh and material
+		Ecs::Entity entity = gWorld.bounds.EntityAt(i);
+		if (!visible || !gWorld.meshes.Has(entity) || !gWorld.materials.Has(entity))
+			continue;
+
+		DrawItem* draw = new (&batch.draws[batch.drawCount++]) DrawItem;
+		draw->model = gWorld.transforms.Get(entity).world;
+		draw->mesh = gWorld.meshes.Get(entity);
+		draw->material = gWorld.materials.Get(entity);
+		draw->clusters = nullptr;
+		draw->clusterCount = 0;
+
+		bool fullLevel = true;
+		if (gWorld.lods.Has(entity))
+		{
+			// Radius of the sphere around the world box, as seen from the camera
+			LodComponent& lod = gWorld.lods.Get(entity);
+			float distance = glm::max(glm::length(bounds.worldCenter - context->viewPosition), 0.1f);
+			float screenRadius = glm::length(bounds.worldExtent) / distance * context->pixelsPerUnit;
+			lod.current = USelectLod(*lod.mesh, lod.current, screenRadius);
+			fullLevel = lod.current == 0;
+
+			const GLMeshLod& level = lod.mesh->lods[lod.current];
+			if (draw->mesh.draw.indexed)
+			{
+				draw->mesh.draw.first = level.firstIndex;
+				draw->mesh.draw.count = level.indexCount;
+			}
+		}
+
+		// Coarser levels are small on screen and drawn whole
+		if (fullLevel && gWorld.clusters.Has(entity) && !UCullClusters(*context, gWorld.clusters.Get(entity), *draw))
+		{
+			--batch.drawCount;
+			continue;
+		}
+
+		// GL names are small and there are only a few vertex formats, so the fields are narrow;
+		// meshes start on MeshPack::BLOB_ALIGNMENT in the shared buffer, so their offsets in
+		// those units tell them apart. The entity keeps the order stable.
+		draw->sortKey = ((uint64_t)(draw->material.programId & 0xFFF) << 52) |
+			((uint64_t)(draw->mesh.vao & 0xFF) << 44) |
+			((uint64_t)((draw->mesh.vertexOffset / MeshPack::BLOB_ALIGNMENT) & 0xFFFF) << 28) |
+			((uint64_t)(draw->material.textureId & 0xFFF) << 16) |
+			(uint64_t)(entity & 0xFFFF);
+	}
+}
+
+// Culls the entities against the view frustum on the job workers and fills the
+// draw list, sorted by program, mesh and texture. All of it lives in the frame's arena.
+void UCollectDraws(FrameSnapshot& frame)
+{
+	TRACE_SCOPE("UCollectDraws");
+
+	CullContext context;
+	context.frame = &frame;
+	context.viewPosition = frame.viewPosition;
+	context.pixelsPerUnit = frame.projection[1][1] * frame.framebufferHeight * 0.5f;
+
+	// Frustum planes from the rows of projection * view, pointing inwards
+	glm::mat4 viewProjection = frame.projection * frame.view;
+	for (int i = 0; i < 3; ++i)
+	{
+		glm::vec4 row(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+		glm::vec4 w(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+		context.planes[2 * i] = w + row;
+		context.planes[2 * i + 1] = w - row;
+	}
+	for (int i = 0; i < 6; ++i)
+		context.planes[i] /= glm::length(glm::vec3(context.planes[i]));
+
+	int count = gWorld.bounds.Size();
+	int batchCount = (count + CULL_BATCH_SIZE - 1) / CULL_BATCH_SIZE;
+	context.batches = frame.arena.Allocate<CullBatch>(batchCount);
+	Jobs::ParallelFor(count, CULL_BATCH_SIZE, UCullBatch, &context);
+
+	// Gather the batches into one list
+	frame.drawCount = 0;
+	for (int i = 0; i < batchCount; ++i)
+		frame.drawCount += context.batches[i].drawCount;
+	frame.draws = frame.arena.Allocate<DrawItem>(frame.drawCount);
+	int next = 0;
+	for (int i = 0; i < batchCount; ++i)
+	{
+		for (int j = 0; j < context.batches[i].drawCount; ++j)
+			new (&frame.draws[next++]) DrawItem(context.batches[i].draws[j]);
+	}
+
+	std::sort(frame.draws, frame.draws + frame.drawCount, [](const DrawItem& a, const DrawItem& b)
+	{
+		return a.sortKey < b.sortKey;
+	});
+}
+
+
+// Lights in the order they were created, as many as the surface shader takes
+void UCollectLights(FrameSnapshot& frame)
+{
+	frame.lightCount = 0;
+	Ecs::View(gWorld.lights, [&frame](Ecs::Entity, const LightComponent& light)
+	{
+		if (frame.lightCount == MAX_LIGHTS)
+			return;
+		frame.lightColors[frame.lightCount] = light.color;
+		frame.lightPositions[frame.lightCount] = light.position;
+		++frame.lightCount;
+	});
+}
+
+
+// Reports heap allocations made by a warmed-up frame; debug builds stop on the first one
+void UCheckFrameAllocations(const char* threadName, uint64_t allocations, int frameIndex)
+{
+	if (allocations == 0 || frameIndex < ALLOCATION_WARMUP_FRAMES)
+		return;
+
+	cout << "Failed zero allocation check: " << allocations << " heap allocations on the " << threadName
+		<< " thread in frame " << frameIndex << endl;
+	assert(allocations == 0);
+}
+
+
+// Runs on its own thread with the GL context current, drawing the snapshots published by the main loop
+void URenderThread()
+{
+	Trace::SetThreadName("render");
+	glfwMakeContextCurrent(gWindow);
+
+	int viewportWidth = gFramebufferWidth;
+	int viewportHeight = gFramebufferHeight;
+	bool benchmarkWritten = false;
+	int frameIndex = 0;
+
+	const FrameSnapshot* frame;
+	while ((frame = gSnapshots.Acquire()) != nullptr)
+	{
+		TRACE_SCOPE("RenderFrame");
+
+		if (gToggleGLCounters.exchange(false))
+		{
+			GLCounters::SetEnabled(!GLCounters::IsEnabled());
+			cout << "INFO: GL counters " << (GLCounters::IsEnabled() ? "on" : "off") << endl;
+		}
+
+		GLCounters::BeginFrame();
+		// Frames still published after the results are written must not open a timer query
+		// that EndFrame would never close
+		if (gBenchmarkPathFilename && !benchmarkWritten)
+			Benchmark::BeginFrame();
+
+		if (frame->framebufferWidth != viewportWidth || frame->framebufferHeight != viewportHeight)
+		{
+			viewportWidth = frame->framebufferWidth;
+			viewportHeight = frame->framebufferHeight;
+			glViewport(0, 0, viewportWidth, viewportHeight);
+		}
+
+		// Culling runs on the job workers, so their allocations are checked with the render thread's
+		uint64_t allocationsBefore = HeapTracking::ThreadAllocationCount();
+		uint64_t workerAllocationsBefore = Jobs::WorkerAllocationCount();
+		URender(*frame);
+		UCheckFrameAllocations("job worker", Jobs::WorkerAllocationCount() - workerAllocationsBefore, frameIndex);
+		UCheckFrameAllocations("render", HeapTracking::ThreadAllocationCount() - allocationsBefore, frameIndex++);
+
+		// Report the GL cost of a frame once a second while counting
+		GLCounters::EndFrame();
+		if (gBenchmarkPathFilename && !benchmarkWritten)
+		{
+			Benchmark::EndFrame();
+			if (Benchmark::IsFinished())
+			{
+				if (Benchmark::WriteJson(gBenchmarkOutputFilename, gBenchmarkPathFilename))
+					cout << "INFO: Benchmark results written to " << gBenchmarkOutputFilename << endl;
+				else
+					cout << "Failed to write benchmark results " << gBenchmarkOutputFilename << endl;
+				benchmarkWritten = true;
+				glfwSetWindowShouldClose(gWindow, true);
+			}
+		}
+		double now = glfwGetTime();
+		if (GLCounters::IsEnabled() && now - gLastCounterReport >= 1.0)
+		{
+			GLCounters::PrintFrame(GLCounters::LastFrame());
+			gLastCounterReport = now;
+		}
+	}
+
+	glfwMakeContextCurrent(NULL);
+}
+
+
+void URender(const FrameSnapshot& frame)
+{
+	TRACE_SCOPE("URender");
+
+	// Clear the background
+	glEnable(GL_DEPTH_TEST);
+	glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);   // strips are separated by 0xFFFFFFFF
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	// Write the frame's uniform data straight into GPU-visible memory. The mapping is
+	// write-combined, so it is only written, front to back, and never read.
+	gStreamBuffer.BeginFrame();
+	int objectCount = std::min(frame.drawCount, MAX_STREAM_OBJECTS);
+	GLintptr frameOffset = 0;
+	GLintptr objectOffset = 0;
+	FrameUniforms* uniforms = (FrameUniforms*)gStreamBuffer.Allocate(sizeof(FrameUniforms), frameOffset);
+	ObjectUniforms* objects = (ObjectUniforms*)gStreamBuffer.Allocate(sizeof(ObjectUniforms) * MAX_STREAM_OBJECTS, objectOffset);
+	GLintptr commandOffset = 0;
+	DrawElementsIndirectCommand* commands = (DrawElementsIndirectCommand*)gStreamBuffer.Allocate(sizeof(DrawElementsIndirectCommand) * MAX_STREAM_CLUSTER_RANGES, commandOffset);
+	assert(uniforms && objects && commands);
+	int commandCount = 0;
+
+	uniforms->view = frame.view;
+	uniforms->projection = frame.projection;
+	uniforms->viewPosition = glm::vec4(frame.viewPosition, 1.0f);
+	uniforms->ambient = glm::vec4(0.5f, 0.5f, 0.5f, 0.3f);
+	for (int i = 0; i < MAX_LIGHTS; ++i)
+	{
+		// Lights without a light component stay black
+		bool lit = i < frame.lightCount;
+		uniforms->lightColor[i] = lit ? glm::vec4(frame.lightColors[i], 1.0f) : glm::vec4(0.0f);
+		uniforms->lightPosition[i] = lit ? glm::vec4(frame.lightPositions[i], 1.0f) : glm::vec4(0.0f);
+	}
+	uniforms->surface = glm::vec4(0.1f, 4.0f, gUVScale.x, gUVScale.y);
+
+	for (int i = 0; i < objectCount; ++i)
+	{
+		objects[i].model = frame.draws[i].model;
+		objects[i].color = glm::vec4(frame.draws[i].material.color, 1.0f);
+		objects[i].decode = frame.draws[i].mesh.decode;
+	}
+
+	glBindBufferRange(GL_UNIFORM_BUFFER, 0, gStreamBuffer.Buffer(), frameOffset, sizeof(FrameUniforms));
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 1, gStreamBuffer.Buffer(), objectOffset, sizeof(ObjectUniforms) * MAX_STREAM_OBJECTS);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gStreamBuffer.Buffer());
+	glActiveTexture(GL_TEXTURE0);
+
+	// Draws come sorted by program, vertex format, mesh and texture, so state only changes between
+	// runs of equal keys. Nothing is set per draw; the base instance selects the draw's object data.
+	GLuint currentProgram = 0;
+	GLuint currentVao = 0;
+	GLuint currentVertexBuffer = 0;
+	GLintptr currentVertexOffset = -1;
+	GLuint currentIndexBuffer = 0;
+	GLuint currentTexture = 0;
+	for (int drawIndex = 0; drawIndex < objectCount; ++drawIndex)
+	{
+		const DrawItem& draw = frame.draws[drawIndex];
+		const MaterialComponent& material = draw.material;
+		if (material.programId != currentProgram)
+		{
+			currentProgram = material.programId;
+			glUseProgram(currentProgram);
+		}
+
+		if (draw.mesh.vao != currentVao)
+		{
+			currentVao = draw.mesh.vao;
+			glBindVertexArray(currentVao);
+			currentVertexBuffer = 0;
+			currentVertexOffset = -1;
+			currentIndexBuffer = 0;
+		}
+
+		// Every mesh is a range of the same buffers; the binding offset makes its first vertex
+		// index 0. The index buffer binding is part of the vertex array, so it follows that.
+		if (draw.mesh.vertexBuffer != currentVertexBuffer || draw.mesh.vertexOffset != currentVertexOffset)
+		{
+			currentVertexBuffer = draw.mesh.vertexBuffer;
+			currentVertexOffset = draw.mesh.vertexOffset;
+			glBindVertexBuffer(VertexLayout::VERTEX_BINDING, currentVertexBuffer, currentVertexOffset, draw.mesh.vertexStride);
+		}
+		if (draw.mesh.indexBuffer != currentIndexBuffer)
+		{
+			currentIndexBuffer = draw.mesh.indexBuffer;
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, currentIndexBuffer);
+		}
+
+		if (material.textureId != 0 && material.textureId != currentTexture)
+		{
+			currentTexture = material.textureId;
+			glBindTexture(GL_TEXTURE_2D, currentTexture);
+		}
+
+		// The visible meshlets of a mesh go in one call, as long as there is room for their commands
+		if (draw.clusters && commandCount + draw.clusterCount <= MAX_STREAM_CLUSTER_RANGES)
+		{
+			for (int i = 0; i < draw.clusterCount; ++i)
+			{
+				const ClusterRange& range = draw.clusters[i];
+				commands[commandCount + i] = { (GLuint)range.count, 1, (GLuint)range.first, 0, (GLuint)drawIndex };
+			}
+			const void* indirect = (const void*)(commandOffset + commandCount * sizeof(DrawElementsIndirectCommand));
+			glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, indirect, draw.clusterCount, 0);
+			commandCount += draw.clusterCount;
+			continue;
+		}
+
+		const MeshDraw& call = draw.mesh.draw;
+		if (call.indexed)
+			glDrawElementsInstancedBaseInstance(call.mode, call.count, GL_UNSIGNED_INT, (const void*)(call.first * sizeof(GLuint)), 1, drawIndex);
+		else
+			glDrawArraysInstancedBaseInstance(call.mode, call.first, call.count, 1, drawIndex);
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	glUseProgram(0);
+
+	// The region is free again once the GPU has run these draws
+	gStreamBuffer.EndFrame();
+
+	// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
+	Trace::Begin("glfwSwapBuffers");
+	glfwSwapBuffers(gWindow);    // Flips the the back buffer with the front buffer every frame.
+	Trace::End();
+}
+
+// Generates, optimizes and encodes one mesh. Only touches the job's own mesh, so any
+// number of these run at once; what it reports goes to the mesh's log.
+void UGenerateMeshJob(void* data)
+{
+	MeshGenerateJob& job = *(MeshGenerateJob*)data;
+	TRACE_SCOPE("UGenerateMeshJob", job.name);
+	GeneratedMesh& mesh = *job.mesh;
+	job.build(mesh);
+	mesh.view.name = job.name;
+	UOptimizeMesh(mesh);
+
+	VertexCompression::Error error;
+	MeshPack::MeshView floatView = mesh.view;
+	uint32_t floatStride = floatView.format.stride;
+	VertexCompression::Encode(floatView, job.encoding, mesh.compactVertices, mesh.view, error);
+	mesh.log << "INFO: Mesh " << mesh.view.name << ": " << floatStride << " -> " << mesh.view.format.stride << " bytes a vertex ("
+		<< VertexCompression::Describe(job.encoding) << "), max error: position " << error.positionMax
+		<< ", normal " << error.normalMaxDegrees << " deg, uv " << error.uvMax << endl;
+}
+
+// Creates every scene mesh, from the baked mesh pack when there is a valid one.
+// Otherwise the meshes are generated on the job workers, then uploaded together and
+// baked for the next start. The time of each phase goes to times.
+bool UCreateMeshes(StartupTimes& times)
+{
+	TRACE_SCOPE("UCreateMeshes");
+	double start = glfwGetTime();
+
+	// Vertex encodings: everything compact, with normals packed to 2_10_10_10 where they are axis aligned
+	const VertexCompression::Encoding octahedral = { VertexCompression::POSITION_UNORM16, VertexCompression::NORMAL_OCTAHEDRAL16, VertexCompression::UV_HALF };
+	const VertexCompression::Encoding packed = { VertexCompression::POSITION_UNORM16, VertexCompression::NORMAL_INT_2_10_10_10, VertexCompression::UV_HALF };
+
+	// Meshes made by the same generator share its pack entry, the encoding of its first
+	// slot, and its data on the GPU
+	struct MeshSlot
+	{
+		GLMesh* mesh;
+		const char* name;
+		void (*build)(GeneratedMesh& mesh);
+		VertexCompression::Encoding encoding;
+	};
+	const MeshSlot slots[] =
+	{
+		{ &gTablePlaneMesh, "tablePlane", UBuildTablePlaneMesh, packed },
+		{ &gPyramidMesh, "pyramid", UBuildPyramidMesh, packed },
+		{ &gCubeAMesh, "cube", UBuildCubeMesh, packed },
+		{ &gCubeBMesh, "cube", UBuildCubeMesh, packed },
+		{ &gCuttingBoardMesh, "cube", UBuildCubeMesh, packed },
+		{ &gPrismAMesh, "prism", UBuildPrismMesh, packed },
+		{ &gProngBMesh, "prism", UBuildPrismMesh, packed },
+		{ &gProngCMesh, "prism", UBuildPrismMesh, packed },
+		{ &gBowlMesh, "torus", UBuildTorusMesh, octahedral },
+		{ &gCubeCMesh, "cube", UBuildCubeMesh, packed },
+		{ &gSauceMesh, "sphere", UBuildSphereMesh, octahedral },
+		{ &gTurkeyAMesh, "sphere", UBuildSphereMesh, octahedral }
+	};
+	const int SLOT_COUNT = sizeof(slots) / sizeof(slots[0]);
+	GLMesh* meshes[SLOT_COUNT];
+	for (int i = 0; i < SLOT_COUNT; ++i)
+		meshes[i] = slots[i].mesh;
+
+	// A pack baked with other encodings is regenerated like a missing one
+	MeshPack::MappedPack pack;
+	if (!gBakeMeshes && pack.Open(MESH_PACK_FILENAME))
+	{
+		MeshPack::MeshView views[SLOT_COUNT];
+		bool complete = true;
+		for (int i = 0; i < SLOT_COUNT && complete; ++i)
+		{
+			const VertexCompression::Encoding& encoding = gFloatVertices ? VertexCompression::FLOAT_ENCODING : slots[i].encoding;
+			complete = pack.Find(slots[i].name, views[i]) && VertexCompression::Matches(views[i].format, encoding);
+		}
+
+		if (complete)
+		{
+			uint64_t vertexBytes = 0;
+			uint64_t floatBytes = 0;
+			for (int i = 0; i < pack.MeshCount(); ++i)
+			{
+				MeshPack::MeshView view = pack.GetMesh(i);
+				vertexBytes += (uint64_t)view.vertexCount * view.format.stride;
+				floatBytes += (uint64_t)view.vertexCount * VertexCompression::FloatStride(view.format);
+			}
+			double uploadStart = glfwGetTime();
+			times.meshLoad = (uploadStart - start) * 1000.0;
+			if (!UUploadMeshes(meshes, views, SLOT_COUNT))
+				return false;
+			times.meshUpload = (glfwGetTime() - uploadStart) * 1000.0;
+			cout << "INFO: Loaded " << pack.MeshCount() << " meshes (" << pack.Size() << " bytes) from " << MESH_PACK_FILENAME
+				<< " in " << (glfwGetTime() - start) * 1000.0 << " ms" << endl;
+			UReportVertexBytes(vertexBytes, floatBytes);
+			return true;
+		}
+		cout << "INFO: " << MESH_PACK_FILENAME << " is missing meshes or has other vertex encodings, regenerating it" << endl;
+	}
+
+	// Generate each distinct mesh on the job workers; the first slot with a generator holds its mesh
+	double generateStart = glfwGetTime();
+	times.meshLoad = (generateStart - start) * 1000.0;
+	GeneratedMesh generated[SLOT_COUNT];
+	MeshGenerateJob jobs[SLOT_COUNT];
+	int sources[SLOT_COUNT];
+	Jobs::Counter generateCounter;
+	Trace::Begin("GenerateMeshes");
+	for (int i = 0; i < SLOT_COUNT; ++i)
+	{
+		sources[i] = 0;
+		while (slots[sources[i]].build != slots[i].build)
+			++sources[i];
+		if (sources[i] != i)
+			continue;
+
+		jobs[i] = { slots[i].build, slots[i].name, gFloatVertices ? VertexCompression::FLOAT_ENCODING : slots[i].encoding, &generated[i] };
+		Jobs::Run(UGenerateMeshJob, &jobs[i], &generateCounter);
+	}
+	Jobs::Wait(&generateCounter);
+	Trace::End();
+
+	// Reports and the pack follow slot order whichever job finished first
+	MeshPack::Writer writer;
+	MeshPack::MeshView views[SLOT_COUNT];
+	uint64_t vertexBytes = 0;
+	uint64_t floatBytes = 0;
+	for (int i = 0; i < SLOT_COUNT; ++i)
+	{
+		const MeshPack::MeshView& view = generated[sources[i]].view;
+		views[i] = view;
+		if (sources[i] != i)
+			continue;
+
+		cout << generated[i].log.str();
+		vertexBytes += (uint64_t)view.vertexCount * view.format.stride;
+		floatBytes += (uint64_t)view.vertexCount * VertexCompression::FloatStride(view.format);
+		writer.Add(view);
+	}
+	double uploadStart = glfwGetTime();
+	times.meshGenerate = (uploadStart - generateStart) * 1000.0;
+
+	if (!UUploadMeshes(meshes, views, SLOT_COUNT))
+		return false;
+	double bakeStart = glfwGetTime();
+	times.meshUpload = (bakeStart - uploadStart) * 1000.0;
+	cout << "INFO: Generated meshes in " << (bakeStart - start) * 1000.0 << " ms" << endl;
+	UReportVertexBytes(vertexBytes, floatBytes);
+
+	if (writer.Write(MESH_PACK_FILENAME))
+		cout << "INFO: Meshes baked to " << MESH_PACK_FILENAME << endl;
+	else
+		cout << "Failed to write mesh pack " << MESH_PACK_FILENAME << endl;
+	times.meshBake = (glfwGetTime() - bakeStart) * 1000.0;
+	return true;
+}
+
+// Vertex memory of the distinct meshes, which is also what every full pass over them fetches
+void UReportVertexBytes(uint64_t vertexBytes, uint64_t floatBytes)
+{
+	cout << "INFO: Vertex data " << vertexBytes << " bytes, " << floatBytes << " as floats";
+	if (floatBytes > 0)
+		cout << " (" << 100 - (int)(vertexBytes * 100 / floatBytes) << "% smaller)";
+	cout << endl;
+}
+
+// Generates the table top, a textured unit square in the XZ plane
+void UBuildTablePlaneMesh(GeneratedMesh& mesh)
+{
+	// Specifies Normalized Device Coordinates for triangle vertices
+	GLfloat verts[] =
+	{
+		//Vertex coords			//Normals				//Texture coords
+		-1.0f,  0.0f, -1.0f,	0.0f,  1.0f,  0.0f,		0.0f, 1.0f,
+		-1.0f, 0.0f, 1.0f,		0.0f,  1.0f,  0.0f,		0.0f, 0.0f,
+		1.0f, 0.0f, 1.0f,		0.0f,  1.0f,  0.0f,		1.0f, 0.0f,
+		-1.0f,  0.0f, -1.0f,	0.0f,  1.0f,  0.0f,		0.0f, 1.0f,
+		1.0f,  0.0f, -1.0f,		0.0f,  1.0f,  0.0f,		1.0f, 1.0f,
+		1.0f, 0.0f, 1.0f,		0.0f,  1.0f,  0.0f,		1.0f, 0.0f,
+		-1.0f, 0.0f, 1.0f,		0.0f,  1.0f,  0.0f,		0.0f, 0.0f
+	};
+
+	mesh.vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+	UFinishGeneratedMesh(mesh, VertexLayout::Surface::Format());
+}
+
+void UBuildCubeMesh(GeneratedMesh& mesh) {
+	GLfloat verts[] =
+	{
+		//Vertex coords			//Normals				//Texture coords
+
+		//
+		-0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  1.0f,		0.0f, 0.0f, 
+		0.5f, -0.5f, -0.5f,		1.0f,  0.0f,  1.0f,		1.0f, 0.0f,
+		0.5f,  0.5f, -0.5f,		1.0f,  0.0f,  1.0f,		1.0f, 1.0f,
+		0.5f,  0.5f, -0.5f,		1.0f,  0.0f,  1.0f,		1.0f, 1.0f,
+		-0.5f,  0.5f, -0.5f,	1.0f,  0.0f,  1.0f,		0.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  1.0f,		0.0f, 0.0f,
+
+		-0.5f, -0.5f,  0.5f,	1.0f,  0.0f,  -1.0f,	0.0f, 0.0f,
+		0.5f, -0.5f,  0.5f,		1.0f,  0.0f,  -1.0f,	1.0f, 0.0f,
+		0.5f,  0.5f,  0.5f,		1.0f,  0.0f,  -1.0f,	1.0f, 1.0f,
+		0.5f,  0.5f,  0.5f,		1.0f,  0.0f,  -1.0f,	1.0f, 1.0f,
+		-0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  -1.0f,	0.0f, 1.0f,
+		-0.5f, -0.5f,  0.5f,	1.0f,  0.0f,  -1.0f,	0.0f, 0.0f,
+
+		-0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
+		-0.5f,  0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 0.0f,
+		-0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
+		-0.5f, -0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 1.0f,
+		-0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
+
+		0.5f,  0.5f,  0.5f,		1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
+		0.5f,  0.5f, -0.5f,		1.0f,  0.0f,  0.0f,		1.0f, 0.0f,
+		0.5f, -0.5f, -0.5f,		1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
+		0.5f, -0.5f, -0.5f,		1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
+		0.5f, -0.5f,  0.5f,		1.0f,  0.0f,  0.0f,		0.0f, 1.0f,
+		0.5f,  0.5f,  0.5f,		1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
+
+		-0.5f, -0.5f, -0.5f,	0.0f,  1.0f,  0.0f,		0.0f, 0.0f,
+		0.5f, -0.5f, -0.5f,		0.0f,  1.0f,  0.0f,		1.0f, 0.0f,
+		0.5f, -0.5f,  0.5f,		0.0f,  1.0f,  0.0f,		1.0f, 1.0f,
+		0.5f, -0.5f,  0.5f,		0.0f,  1.0f,  0.0f,		1.0f, 1.0f,
+		-0.5f, -0.5f,  0.5f,	0.0f,  1.0f,  0.0f,		0.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f,	0.0f,  1.0f,  0.0f,		0.0f, 0.0f,
+
+		-0.5f,  0.5f, -0.5f,	0.0f,  -1.0f,  0.0f,	0.0f, 0.0f,
+		0.5f,  0.5f, -0.5f,		0.0f,  -1.0f,  0.0f,	1.0f, 0.0f,
+		0.5f,  0.5f,  0.5f,		0.0f,  -1.0f,  0.0f,	1.0f, 1.0f,
+		0.5f,  0.5f,  0.5f,		0.0f,  -1.0f,  0.0f,	1.0f, 0.0f,
+		-0.5f,  0.5f,  0.5f,	0.0f,  -1.0f,  0.0f,	0.0f, 1.0f,
+		-0.5f,  0.5f, -0.5f,	0.0f,  -1.0f,  0.0f,	1.0f, 1.0f
+		
+		
+
+	};
+
+
+	mesh.vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+	UFinishGeneratedMesh(mesh, VertexLayout::Surface::Format());
+}
+void UBuildPrismMesh(GeneratedMesh& mesh)
+{
+	GLfloat verts[] = {
+		 0.15f, -0.85f, -0.85f, 	0.0f, 0.0f, 1.0f,   0.0f, 0.0f, // 4
+		0.15f, -0.85f, -0.6f, 	0.0f, 0.0f, 1.0f,   1.0f, 0.0f, // 5
+		0.15f, -0.98f, -0.85f, 	0.0f, 0.0f, 1.0f,   1.0f, 1.0f, // 6
+		0.15f, -0.85f, -0.6f, 	0.0f, 0.0f, 1.0f,   1.0f, 0.0f, // 5
+		0.15f, -0.98f, -0.6f, 	0.0f, 0.0f, 1.0f,   0.0f, 1.0f, // 7
+		0.15f, -0.98f, -0.85f, 	0.0f, 0.0f, 1.0f,   1.0f, 1.0f, // 6
+
+		// Back face
+		0.33f, -1.0f, -0.85f, 	0.0f, 0.0f, -1.0f,   0.0f, 0.0f, // 0
+		0.33f, -1.0f, -0.6f, 	0.0f, 0.0f, -1.0f,   1.0f, 0.0f, // 1
+		0.33f, -0.83f, -0.85f, 	0.0f, 0.0f, -1.0f,   1.0f, 1.0f, // 2
+		0.33f, -1.0f, -0.6f, 	0.0f, 0.0f, -1.0f,   1.0f, 0.0f, // 1
+		0.33f, -0.83f, -0.6f, 	0.0f, 0.0f, -1.0f,   0.0f, 1.0f, // 3
+		0.33f, -0.83f, -0.85f, 	0.0f, 0.0f, -1.0f,   1.0f, 1.0f, // 2
+
+		// Left face
+		0.15f, -0.85f, -0.85f, 	-1.0f, 0.0f, 0.0f,   0.0f, 0.0f, // 4
+		0.15f, -0.85f, -0.6f, 	-1.0f, 0.0f, 0.0f,   1.0f, 0.0f, // 5
+		0.33f, -0.83f, -0.85f, 	-1.0f, 0.0f, 0.0f,   1.0f, 1.0f, // 2
+		0.15f, -0.85f, -0.6f, 	-1.0f, 0.0f, 0.0f,   1.0f, 0.0f, // 5
+		0.33f, -0.83f, -0.6f, 	-1.0f, 0.0f, 0.0f,   0.0f, 1.0f, // 3
+		0.33f, -0.83f, -0.85f, 	-1.0f, 0.0f, 0.0f,   1.0f, 1.0f, // 2
+
+		// Right face
+		0.15f, -0.98f, -0.85f, 	1.0f, 0.0f, 0.0f,   0.0f, 0.0f, // 6
+		0.15f, -0.98f, -0.6f, 	1.0f, 0.0f, 0.0f,   1.0f, 0.0f, // 7
+		0.33f, -1.0f, -0.85f, 	1.0f, 0.0f, 0.0f,   1.0f, 1.0f, // 0
+		0.15f, -0.98f, -0.6f, 	1.0f, 0.0f, 0.0f,   1.0f, 0.0f, // 7
+		0.33f, -1.0f, -0.6f, 	1.0f, 0.0f, 0.0f,   0.0f, 1.0f, // 1
+		0.33f, -1.0f, -0.85f, 	1.0f, 0.0f, 0.0f,   1.0f, 1.0f, // 0
+
+		// Top face
+		0.15f, -0.85f, -0.6f, 	0.0f, 1.0f, 0.0f,   0.0f, 0.0f, // 5
+		0.33f, -0.83f, -0.6f, 	0.0f, 1.0f, 0.0f,   1.0f, 0.0f, // 3
+		0.15f, -0.98f, -0.6f, 	0.0f, 1.0f, 0.0f,   1.0f, 1.0f, // 7
+		0.33, -0.83f, -0.6f, 	0.0f, 1.0f, 0.0f,   1.0f, 0.0f, // 3
+		0.33f, -1.0f, -0.6f, 	0.0f, 1.0f, 0.0f,   0.0f, 1.0f, // 1
+		0.15f, -0.98f, -0.6f, 	0.0f, 1.0f, 0.0f,   1.0f, 1.0f, // 7
+
+		// Bottom face
+		0.15f, -0.85f, -0.85f, 	0.0f, -1.0f, 0.0f,   0.0f, 0.0f, // 4
+		0.33f, -0.83f, -0.85f, 	0.0f, -1.0f, 0.0f,   1.0f, 0.0f, // 2
+		0.15f, -0.98f, -0.85f, 	0.0f, -1.0f, 0.0f,   1.0f, 1.0f, // 6
+		0.33, -0.83f, -0.85f, 	0.0f, -1.0f, 0.0f,   1.0f, 0.0f, // 2
+		0.33f, -1.0f, -0.85f, 	0.0f, -1.0f, 0.0f,   0.0f, 1.0f, // 0
+		0.15f, -0.98f, -0.85f, 	0.0f, -1.0f, 0.0f,   1.0f, 1.0f, // 6
+	};
+
+	mesh.vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+	UFinishGeneratedMesh(mesh, VertexLayout::Surface::Format());
+}
+
+// Copies a compile-time primitive table into a generated mesh, which the bake then optimizes
+template <typename Layout, typename Vertex, size_t VertexCount, size_t IndexCount>
+void UAssignPrimitiveTable(GeneratedMesh& mesh, const PrimitiveTables::Table<Vertex, VertexCount, IndexCount>& table)
+{
+	static_assert(sizeof(Vertex) == Layout::STRIDE, "the table's vertices do not match the layout");
+
+	const GLfloat* vertices = reinterpret_cast<const GLfloat*>(table.vertices.data());
+	mesh.vertices.assign(vertices, vertices + VertexCount * sizeof(Vertex) / sizeof(GLfloat));
+	mesh.indices.assign(table.indices.begin(), table.indices.end());
+	UFinishGeneratedMesh(mesh, Layout::Format());
+}
+
+// Unit sphere of radius 1, generated at compile time
+constexpr auto SPHERE_TABLE = PrimitiveTables::MakeSphere<32, 16, PrimitiveTables::SurfaceVertex>(1.0);
+
+void UBuildSphereMesh(GeneratedMesh& mesh)
+{
+	UAssignPrimitiveTable<VertexLayout::Surface>(mesh, SPHERE_TABLE);
+}
+
+void UBuildPyramidsMesh(GeneratedMesh& mesh) {
+	GLfloat verts[] = {
+		// Position                 // Normals              // Texture 
+
+	// Front
+		 -1.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,		0.0f, 0.0f, // 1 
+		 -1.0f, 0.0f,  1.0f,		0.0f, -1.0f, 0.0f,		0.0f, 1.0f, // 2
+		  1.0f, 0.0f,  1.0f,		0.0f, -1.0f, 0.0f,		1.0f, 1.0f, // 3
+
+
+		  1.0f, 0.0f,  1.0f,	    0.0f, -1.0f, 0.0f,		1.0f, 1.0f, // 3
+		  1.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,		1.0f, 0.0f, // 4
+		 -1.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,		0.0f, 0.0f, // 1
+
+
+		 -1.0f, 0.0f, -1.0f,		-1.0f, 0.0f, 0.0f,		0.0f, 0.0f, // 1
+		 -1.0f, 0.0f,  1.0f,		-1.0f, 0.0f, 0.0f,		1.0f, 0.0f, // 2
+		  0.0f, 1.0f,  0.0f,	    -1.0f, 0.0f, 0.0f,		0.5f, 1.0f, // 5
+
+
+		 -1.0f, 0.0f, -1.0f,		0.0f, 0.0f, -1.0f,		0.0f, 0.0f, // 1
+		  1.0f, 0.0f, -1.0f,		0.0f, 0.0f, -1.0f,		1.0f, 0.0f, // 4
+		  0.0f, 1.0f,  0.0f,		0.0f, 0.0f, -1.0f,		0.5f, 1.0f, // 5
+
+
+		  1.0f, 0.0f,  1.0f,		1.0f, 0.0f, 0.0f,		0.0f, 0.0f, // 3
+		  1.0f, 0.0f, -1.0f,		1.0f, 0.0f, 0.0f,		1.0f, 0.0f, // 4
+		  0.0f, 1.0f,  0.0f,		1.0f, 0.0f, 0.0f,		0.5f, 1.0f, // 5
+
+
+		 -1.0f, 0.0f, 1.0f,		    0.0f, 0.0f, 1.0f,		0.0f, 0.0f, // 2
+		  1.0f, 0.0f, 1.0f,		    0.0f, 0.0f, 1.0f,		1.0f, 0.0f, // 3
+		  0.0f, 1.0f, 0.0f,		    0.0f, 0.0f, 1.0f, 		0.5f, 1.0f  // 5
+	};
+	mesh.vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+	UFinishGeneratedMesh(mesh, VertexLayout::Surface::Format());
+}
+
+// Bowl torus with a main radius of 1 and a tube radius of 0.1, generated at compile time
+constexpr auto TORUS_TABLE = PrimitiveTables::MakeTorus<30, 30, PrimitiveTables::SurfaceVertex>(1.0, 0.1);
+
+void UBuildTorusMesh(GeneratedMesh& mesh)
+{
+	UAssignPrimitiveTable<VertexLayout::Surface>(mesh, TORUS_TABLE);
+}
+
+// Generates the pyramid of the light fixtures, positions only
+void UBuildPyramidMesh(GeneratedMesh& mesh)
+{
+	// Specifies Normalized Device Coordinates for triangle vertices
+	GLfloat verts[] =
+	{
+		-0.125f,  0.0f, 0.125f,
+		0.0f, 0.25f, 0.0f,
+		0.125f, 0.0f, 0.125f,
+		0.125f, 0.0f, -0.125f,
+		-0.125f, 0.0f, -0.125f,
+	};
+
+	GLuint indices[] = {
+		0,1,2,
+		2,1,3,
+		3,1,4,
+		4,1,0,
+		0,2,3,
+		3,4,0
+	};
+
+	mesh.vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+	mesh.indices.assign(indices, indices + sizeof(indices) / sizeof(indices[0]));
+	UFinishGeneratedMesh(mesh, VertexLayout::Position::Format());
+}
+
+
+// Describes the interleaved float vertices of a generated mesh, in one of the
+// VertexLayout float layouts with the position first, and fits its bounds
+void UFinishGeneratedMesh(GeneratedMesh& mesh, const MeshPack::VertexFormat& format)
+{
+	const size_t floatsPerVertexTotal = format.stride / sizeof(GLfloat);
+	MeshPack::MeshView& view = mesh.view;
+	view.format = format;
+
+	view.vertices = mesh.vertices.data();
+	view.vertexCount = (uint32_t)(mesh.vertices.size() / floatsPerVertexTotal);
+	view.indices = mesh.indices.empty() ? nullptr : mesh.indices.data();
+	view.indexCount = (uint32_t)mesh.indices.size();
+	view.lodCount = 0;
+	view.indexMode = GL_TRIANGLES;
+	view.meshlets = nullptr;
+	view.meshletCount = 0;
+
+	glm::vec3 boundsMin(0.0f);
+	glm::vec3 boundsMax(0.0f);
+	for (uint32_t i = 0; i < view.vertexCount; ++i)
+	{
+		const GLfloat* position = mesh.vertices.data() + i * floatsPerVertexTotal;
+		glm::vec3 point(position[0], position[1], position[2]);
+		boundsMin = i == 0 ? point : glm::min(boundsMin, point);
+		boundsMax = i == 0 ? point : glm::max(boundsMax, point);
+	}
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		view.boundsMin[axis] = boundsMin[axis];
+		view.boundsMax[axis] = boundsMax[axis];
+	}
+}
+
+// Indexes a generated triangle list by welding its duplicate vertices, reorders it for the post-transform cache and
+// overdraw, appends its levels of detail, reorders the vertices for fetch, splits a
+// dense full level into meshlets and turns every level into restart-separated strips,
+// printing the cache statistics of the full level before and after. An unindexed list starts at the worst case, every vertex
+// transformed once per triangle.
+void UOptimizeMesh(GeneratedMesh& mesh)
+{
+	const int CACHE_SIZE = 16;
+	MeshPack::MeshView& view = mesh.view;
+	const size_t stride = view.format.stride;
+	const size_t floatsPerVertex = stride / sizeof(GLfloat);
+
+	MeshOptimize::VertexCacheStats before;
+	float fetchBefore;
+	if (mesh.indices.empty())
+	{
+		before.acmr = 3.0f;
+		before.atvr = 1.0f;
+		fetchBefore = 1.0f;
+
+		mesh.indices.resize(view.vertexCount);
+		std::iota(mesh.indices.begin(), mesh.indices.end(), 0u);
+		size_t uniqueCount = MeshProcess::Weld(mesh.vertices.data(), mesh.indices.data(), mesh.indices.size(), view.vertexCount, stride, 0.0f);
+		mesh.vertices.resize(uniqueCount * floatsPerVertex);
+	}
+	else
+	{
+		before = MeshOptimize::AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), view.vertexCount, CACHE_SIZE);
+		fetchBefore = MeshOptimize::AnalyzeVertexFetch(mesh.indices.data(), mesh.indices.size(), view.vertexCount, stride);
+	}
+	size_t vertexCount = mesh.vertices.size() / floatsPerVertex;
+
+	MeshOptimize::OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), vertexCount);
+	MeshOptimize::OptimizeOverdraw(mesh.indices.data(), mesh.indices.size(), mesh.vertices.data(), vertexCount, stride, 1.05f);
+
+	// Every level is simplified from the full one, so its error is against the full mesh,
+	// and goes after it in the index buffer over the same vertices
+	const size_t fullCount = mesh.indices.size();
+	view.lodCount = 1;
+	view.lods[0] = { 0, (uint32_t)fullCount, 0.0f };
+	if (fullCount / 3 >= LOD_MIN_TRIANGLES)
+	{
+		glm::vec3 extent(view.boundsMax[0] - view.boundsMin[0], view.boundsMax[1] - view.boundsMin[1], view.boundsMax[2] - view.boundsMin[2]);
+		float maxError = LOD_MAX_RELATIVE_ERROR * glm::length(extent) * 0.5f;
+		std::vector<uint32_t> simplified(fullCount);
+		size_t previousCount = fullCount;
+		while (view.lodCount < (uint32_t)MeshPack::MAX_LODS)
+		{
+			float error;
+			size_t count = MeshSimplify::Simplify(simplified.data(), mesh.indices.data(), fullCount, mesh.vertices.data(), vertexCount, stride,
+				previousCount / 6 * 3, maxError, error);
+			// A level that barely got simpler is not worth switching to
+			if (count == 0 || count > previousCount * 3 / 4)
+				break;
+			MeshOptimize::OptimizeVertexCache(simplified.data(), count, vertexCount);
+			view.lods[view.lodCount++] = { (uint32_t)mesh.indices.size(), (uint32_t)count, error };
+			mesh.indices.insert(mesh.indices.end(), simplified.begin(), simplified.begin() + count);
+			previousCount = count;
+		}
+	}
+
+	vertexCount = MeshOptimize::OptimizeVertexFetch(mesh.vertices.data(), mesh.indices.data(), mesh.indices.size(), vertexCount, stride);
+	mesh.vertices.resize(vertexCount * floatsPerVertex);
+
+	// Meshlets regroup the triangles of the full level into a list of their own
+	std::vector<uint32_t> clusterIndices;
+	mesh.meshlets.clear();
+	if (fullCount / 3 >= CLUSTER_MIN_TRIANGLES)
+	{
+		clusterIndices.resize(fullCount);
+		Meshlets::Build(mesh.meshlets, clusterIndices.data(), mesh.indices.data(), fullCount, mesh.vertices.data(), vertexCount, stride);
+		size_t coneCount = 0;
+		for (const MeshPack::Meshlet& meshlet : mesh.meshlets)
+			coneCount += meshlet.coneCutoff < 1.0f ? 1 : 0;
+		mesh.log << "INFO: Mesh " << view.name << ": " << mesh.meshlets.size() << " meshlets of up to " << Meshlets::MAX_VERTICES << " vertices and "
+			<< Meshlets::MAX_TRIANGLES << " triangles, " << coneCount << " with a normal cone" << endl;
+	}
+
+	MeshOptimize::VertexCacheStats after = MeshOptimize::AnalyzeVertexCache(mesh.indices.data(), fullCount, vertexCount, CACHE_SIZE);
+	float fetchAfter = MeshOptimize::AnalyzeVertexFetch(mesh.indices.data(), fullCount, vertexCount, stride);
+	mesh.log << "INFO: Mesh " << view.name << ": " << fullCount / 3 << " triangles, ACMR " << before.acmr << " -> " << after.acmr
+		<< ", ATVR " << before.atvr << " -> " << after.atvr << ", overfetch " << fetchBefore << " -> " << fetchAfter << endl;
+	if (view.lodCount > 1)
+	{
+		mesh.log << "INFO: Mesh " << view.name << " levels of detail:";
+		for (uint32_t i = 1; i < view.lodCount; ++i)
+			mesh.log << " " << view.lods[i].indexCount / 3 << " triangles (error " << view.lods[i].error << ")";
+		mesh.log << endl;
+	}
+
+	// Every level becomes strips joined by restart indices, drawn in one call each
+	std::vector<uint32_t> strips(mesh.indices.size() / 3 * 4);
+	size_t stripCount = 0;
+	for (uint32_t i = 0; i < view.lodCount; ++i)
+	{
+		MeshPack::MeshLod& lod = view.lods[i];
+		size_t count = MeshOptimize::Stripify(strips.data() + stripCount, mesh.indices.data() + lod.firstIndex, lod.indexCount, vertexCount);
+		lod.firstIndex = (uint32_t)stripCount;
+		lod.indexCount = (uint32_t)count;
+		stripCount += count;
+	}
+	strips.resize(stripCount);
+	mesh.log << "INFO: Mesh " << view.name << " strips: " << mesh.indices.size() << " -> " << stripCount << " indices" << endl;
+
+	// The meshlets' triangle list follows the strips
+	if (!mesh.meshlets.empty())
+	{
+		strips.insert(strips.end(), clusterIndices.begin(), clusterIndices.end());
+		for (MeshPack::Meshlet& meshlet : mesh.meshlets)
+			meshlet.firstIndex += (uint32_t)stripCount;
+	}
+	mesh.indices.swap(strips);
+
+	view.vertices = mesh.vertices.data();
+	view.vertexCount = (uint32_t)vertexCount;
+	view.indices = mesh.indices.data();
+	view.indexCount = (uint32_t)mesh.indices.size();
+	view.indexMode = GL_TRIANGLE_STRIP;
+	view.meshlets = mesh.meshlets.empty() ? nullptr : mesh.meshlets.data();
+	view.meshletCount = (uint32_t)mesh.meshlets.size();
+}
+
+// Uploads the meshes as one batch: each distinct view once, vertices into one buffer
+// and indices into another, at offsets of their own. Meshes given the same view draw
+// from the same data. Everything is copied in through a single mapping of each buffer,
+// which then stays untouched by the CPU. Returns false, with the buffers deleted, when a
+// buffer cannot be mapped or loses its contents while mapped.
+bool UUploadMeshes(GLMesh* const meshes[], const MeshPack::MeshView views[], int count)
+{
+	TRACE_SCOPE("UUploadMeshes");
+
+	// Lay the buffers out first; vertex ranges start aligned like pack blobs, so each can be
+	// bound at its offset whatever the strides around it
+	struct Placement
+	{
+		int source;         // first mesh with the same view
+		GLintptr vertexOffset;
+		GLint baseIndex;
+		int firstCluster;
+	};
+	std::vector<Placement> placements(count);
+	GLsizeiptr vertexBytes = 0;
+	GLsizeiptr indexCount = 0;
+	int clusterCount = (int)gClusters.size();
+	for (int i = 0; i < count; ++i)
+	{
+		Placement& placement = placements[i];
+		placement.source = 0;
+		while (views[placement.source].vertices != views[i].vertices)
+			++placement.source;
+		if (placement.source != i)
+		{
+			placement = placements[placement.source];
+			continue;
+		}
+
+		placement.vertexOffset = (vertexBytes + MeshPack::BLOB_ALIGNMENT - 1) / MeshPack::BLOB_ALIGNMENT * MeshPack::BLOB_ALIGNMENT;
+		vertexBytes = placement.vertexOffset + (GLsizeiptr)views[i].vertexCount * views[i].format.stride;
+		placement.baseIndex = (GLint)indexCount;
+		indexCount += views[i].indexCount;
+		placement.firstCluster = clusterCount;
+		clusterCount += (int)views[i].meshletCount;
+	}
+
+	if (vertexBytes == 0)
+	{
+		cout << "Failed to upload meshes: there are no vertices" << endl;
+		return false;
+	}
+
+	// Static meshes are never written again after this, so the storage is immutable and
+	// only mappable for writing
+	gMeshVertexBuffer = GLResources::CreateBuffer(GL_ARRAY_BUFFER, vertexBytes, nullptr, GL_MAP_WRITE_BIT, "UUploadMeshes");
+	uint8_t* vertices = (uint8_t*)GLResources::MapBuffer(gMeshVertexBuffer, 0, vertexBytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	uint32_t* indices = nullptr;
+	GLsizeiptr indexBytes = indexCount * (GLsizeiptr)sizeof(uint32_t);
+	if (indexCount > 0)
+	{
+		gMeshIndexBuffer = GLResources::CreateBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBytes, nullptr, GL_MAP_WRITE_BIT, "UUploadMeshes");
+		indices = (uint32_t*)GLResources::MapBuffer(gMeshIndexBuffer, 0, indexBytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	}
+	// Deleting a buffer unmaps it, so a failed upload leaves nothing mapped behind
+	if (!vertices || (indexCount > 0 && !indices))
+	{
+		cout << "Failed to map mesh buffers of " << vertexBytes << " and " << indexBytes << " bytes" << endl;
+		UDestroyMeshBuffers();
+		return false;
+	}
+
+	// Meshlet index ranges move with their mesh's indices
+	for (int i = 0; i < count; ++i)
+	{
+		const MeshPack::MeshView& view = views[i];
+		const Placement& placement = placements[i];
+		if (placement.source == i)
+		{
+			memcpy(vertices + placement.vertexOffset, view.vertices, (size_t)view.vertexCount * view.format.stride);
+			if (view.indexCount > 0)
+				memcpy(indices + placement.baseIndex, view.indices, (size_t)view.indexCount * sizeof(uint32_t));
+			for (uint32_t m = 0; m < view.meshletCount; ++m)
+			{
+				gClusters.push_back(view.meshlets[m]);
+				gClusters.back().firstIndex += (uint32_t)placement.baseIndex;
+			}
+		}
+		UDescribeMesh(*meshes[i], view, placement.vertexOffset, placement.baseIndex, placement.firstCluster);
+	}
+
+	bool vertexUnmapped = GLResources::UnmapBuffer(gMeshVertexBuffer);
+	bool indexUnmapped = !indices || GLResources::UnmapBuffer(gMeshIndexBuffer);
+	if (!vertexUnmapped || !indexUnmapped)
+	{
+		cout << "Failed to upload meshes: the mesh buffers lost their contents while mapped" << endl;
+		UDestroyMeshBuffers();
+		return false;
+	}
+	return true;
+}
+
+// Fills in a mesh whose data was uploaded to the shared mesh buffers, its vertices at
+// vertexOffset, its indices from baseIndex and its meshlets from firstCluster of gClusters
+void UDescribeMesh(GLMesh& mesh, const MeshPack::MeshView& view, GLintptr vertexOffset, GLint baseIndex, int firstCluster)
+{
+	mesh.nVertices = view.vertexCount;
+	mesh.nIndices = view.indexCount;
+	mesh.indexMode = view.indexMode;
+	mesh.boundsMin = glm::vec3(view.boundsMin[0], view.boundsMin[1], view.boundsMin[2]);
+	mesh.boundsMax = glm::vec3(view.boundsMax[0], view.boundsMax[1], view.boundsMax[2]);
+
+	// 16-bit positions are normalized across the bounds
+	mesh.decode.positionScale = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+	mesh.decode.positionBias = glm::vec4(0.0f);
+	if (VertexCompression::HasQuantizedPositions(view.format))
+	{
+		mesh.decode.positionScale = glm::vec4(mesh.boundsMax - mesh.boundsMin, 0.0f);
+		mesh.decode.positionBias = glm::vec4(mesh.boundsMin, 0.0f);
+	}
+	if (VertexCompression::HasOctahedralNormals(view.format))
+		mesh.decode.positionScale.w = 1.0f;
+
+	// Indexed meshes without levels of detail draw all their indices as level 0. A level
+	// is allowed up to the projected radius where its error covers LOD_PIXEL_ERROR. The
+	// error is MeshSimplify's RMS plane distance, not a largest displacement, so in places
+	// a level can be off by somewhat more than that.
+	float radius = glm::length(mesh.boundsMax - mesh.boundsMin) * 0.5f;
+	mesh.lodCount = view.indexCount > 0 ? 1 : 0;
+	mesh.lods[0] = { baseIndex, (GLsizei)view.indexCount, FLT_MAX };
+	for (uint32_t i = 0; i < view.lodCount; ++i)
+	{
+		const MeshPack::MeshLod& lod = view.lods[i];
+		mesh.lods[i].firstIndex = baseIndex + (GLint)lod.firstIndex;
+		mesh.lods[i].indexCount = (GLsizei)lod.indexCount;
+		mesh.lods[i].maxScreenRadius = lod.error > 0.0f ? LOD_PIXEL_ERROR * radius / lod.error : FLT_MAX;
+		mesh.lodCount = (int)i + 1;
+	}
+
+	mesh.firstCluster = firstCluster;
+	mesh.clusterCount = (int)view.meshletCount;
+
+	mesh.vao = VertexLayout::Acquire(view.format);
+	mesh.vertexStride = (GLsizei)view.format.stride;
+	mesh.vertexBuffer = gMeshVertexBuffer;
+	mesh.vertexOffset = vertexOffset;
+	mesh.indexBuffer = view.indexCount > 0 ? gMeshIndexBuffer : 0;
+}
+
+
+void UDestroyMeshBuffers()
+{
+	// The vertex arrays are shared and go with VertexLayout::DestroyShared
+	GLResources::DestroyBuffer(gMeshVertexBuffer);
+	GLResources::DestroyBuffer(gMeshIndexBuffer);
+}
+
+
+// Creates the stream buffer and the draw id buffer every mesh reads its draw id from
+bool UCreateStreamResources()
+{
+	GLsizeiptr regionSize = sizeof(FrameUniforms) + sizeof(ObjectUniforms) * MAX_STREAM_OBJECTS + sizeof(DrawElementsIndirectCommand) * MAX_STREAM_CLUSTER_RANGES;
+	if (!gStreamBuffer.Create(regionSize, "UCreateStreamResources"))
+		return false;
+
+	GLuint drawIds[MAX_STREAM_OBJECTS];
+	for (int i = 0; i < MAX_STREAM_OBJECTS; ++i)
+		drawIds[i] = (GLuint)i;
+	gDrawIdBuffer = GLResources::CreateBuffer(GL_ARRAY_BUFFER, sizeof(drawIds), drawIds, 0, "UCreateStreamResources");
+	return true;
+}
+
+// Adds the per-instance draw id attribute (location 3) to a vertex array, read from
+// a binding of its own next to the mesh vertices
+void UAttachDrawIds(GLuint vao)
+{
+	GLResources::SetAttribIFormat(vao, 3, 1, GL_UNSIGNED_INT, 0, DRAW_ID_BINDING);
+	GLResources::SetVertexBuffer(vao, DRAW_ID_BINDING, gDrawIdBuffer, 0, sizeof(GLuint), 1);
+}
+
+void UDestroyStreamResources()
+{
+	gStreamBuffer.Destroy();
+	GLResources::DestroyBuffer(gDrawIdBuffer);
+}
+
+	
+
+// Implements the UCreateShaders function
+bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId)
+{
+	// Compilation and linkage error reporting
+	int success = 0;
+	char infoLog[512];
+
+	// Create a Shader program object.
+	programId = glCreateProgram();
+
+	// Create the vertex and fragment shader objects
+	GLuint vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
+	GLuint fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
+
+	// Retrive the shader source
+	glShaderSource(vertexShaderId, 1, &vtxShaderSource, NULL);
+	glShaderSource(fragmentShaderId, 1, &fragShaderSource, NULL);
+
+	// Compile the vertex shader, and print compilation errors (if any)
+	glCompileShader(vertexShaderId); // compile the vertex shader
+	// check for shader compile errors
+	glGetShaderiv(vertexShaderId, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		glGetShaderInfoLog(vertexShaderId, 512, NULL, infoLog);
+		std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
+
+		return false;
+	}
+
+	glCompileShader(fragmentShaderId); // compile the fragment shader
+	// check for shader compile errors
+	glGetShaderiv(fragmentShaderId, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		glGetShaderInfoLog(fragmentShaderId, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
+
+		return false;
+	}
+
+	// Attached compiled shaders to the shader program
+	glAttachShader(programId, vertexShaderId);
+	glAttachShader(programId, fragmentShaderId);
+
+	glLinkProgram(programId);   // links the shader program
+	// check for linking errors
+	glGetProgramiv(programId, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glGetProgramInfoLog(programId, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+
+		return false;
+	}
+
+	glUseProgram(programId);    // Uses the shader program
+
+	return true;
+}
+
+
+void UDestroyShaderProgram(GLuint programId)
+{
+	glDeleteProgram(programId);
+}
+
+// Images are loaded with Y axis going down, but OpenGL's Y axis goes up, so let's flip it
+void flipImageVertically(unsigned char* image, int width, int height, int channels)
+{
+	for (int j = 0; j < height / 2; ++j)
+	{
+		int index1 = j * width * channels;
+		int index2 = (height - 1 - j) * width * channels;
+
+		for (int i = width * channels; i > 0; --i)
+		{
+			unsigned char tmp = image[index1];
+			image[index1] = image[index2];
+			image[index2] = tmp;
+			++index1;
+			++index2;
+		}
+	}
+}
+
+/*Generate and load the texture*/
+bool UCreateTexture(const char* filename, GLuint& textureId)
+{
+	DecodedImage image = {};
+	image.filename = filename;
+	UDecodeImageJob(&image);
+	return UUploadTexture(image, textureId);
+}
+
+// Loads and flips an image file; needs no GL context, so it can run on any thread
+void UDecodeImageJob(void* data)
+{
+	DecodedImage* image = (DecodedImage*)data;
+	TRACE_SCOPE("UDecodeImage", image->filename);
+
+	image->pixels = stbi_load(image->filename, &image->width, &image->height, &image->channels, 0);
+	if (image->pixels)
+		flipImageVertically(image->pixels, image->width, image->height, image->channels); // so that image is not upside down
+}
+
+// Creates a texture from a decoded image and frees the image
+bool UUploadTexture(const DecodedImage& image, GLuint& textureId)
+{
+	TRACE_SCOPE("UUploadTexture", image.filename);
+
+	if (image.pixels)
+	{
+		GLenum internalFormat;
+		GLenum format;
+		if (image.channels == 3)
+		{
+			internalFormat = GL_RGB8;
+			format = GL_RGB;
+		}
+		else if (image.channels == 4)
+		{
+			internalFormat = GL_RGBA8;
+			format = GL_RGBA;
+		}
+		else
+		{
+			cout << "Not implemented to handle image with " << image.channels << " channels" << endl;
+			stbi_image_free(image.pixels);
+			return false;
+		}
+
+		// Repeating, linearly filtered, with the full mip chain generated
+		textureId = GLResources::CreateTexture2D(image.width, image.height, internalFormat, format, GL_UNSIGNED_BYTE, image.pixels,
+			GL_REPEAT, GL_LINEAR, GL_LINEAR, image.filename);
+
+		stbi_image_free(image.pixels);
+		return textureId != 0;
+	}
+
+	return false;
+}
+
+
+void UDestroyTexture(GLuint textureId)
+{
+	GLResources::DestroyTexture(textureId);
+}
@@ -0,0 +1,317 @@
+#include "benchmark.h"
+#include "glcounters.h"
+#include "gpuresources.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+	// GPU timer queries in flight; results are read this many frames later so the CPU never waits on the GPU
+	const int QUERY_COUNT = 4;
+
+	struct FrameSample
+	{
+		double cpuMs;       // since the previous frame began
+		double submitMs;    // from BeginFrame to EndFrame
+		double gpuMs;
+		uint32_t drawCalls;
+		uint32_t glCalls;
+		uint32_t stateChanges;
+	};
+
+	int gFrameCount = 0;
+	int gFrameIndex = 0;
+	std::vector<FrameSample> gSamples;
+	std::chrono::steady_clock::time_point gFrameStart;
+	bool gHasFrameStart = false;
+
+	GLuint gQueries[QUERY_COUNT];
+	bool gQueriesCreated = false;
+
+	// Frame index the results of a query belong to, -1 when the query holds nothing
+	int gQueryFrame[QUERY_COUNT];
+
+	void UCollectQuery(int slot)
+	{
+		if (gQueryFrame[slot] < 0)
+			return;
+
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(gQueries[slot], GL_QUERY_RESULT, &elapsed);
+
+		int sample = gQueryFrame[slot] - Benchmark::WARMUP_FRAMES;
+		if (sample >= 0 && sample < (int)gSamples.size())
+			gSamples[sample].gpuMs = elapsed / 1.0e6;
+		gQueryFrame[slot] = -1;
+	}
+
+	struct Distribution
+	{
+		double mean, min, max, p50, p90, p95, p99;
+	};
+
+	Distribution UDistribution(std::vector<double> values)
+	{
+		Distribution result = {};
+		if (values.empty())
+			return result;
+
+		std::sort(values.begin(), values.end());
+		double sum = 0.0;
+		for (double value : values)
+			sum += value;
+
+		auto percentile = [&values](double p)
+		{
+			size_t index = (size_t)(p * (values.size() - 1) + 0.5);
+			return values[index];
+		};
+
+		result.mean = sum / values.size();
+		result.min = values.front();
+		result.max = values.back();
+		result.p50 = percentile(0.50);
+		result.p90 = percentile(0.90);
+		result.p95 = percentile(0.95);
+		result.p99 = percentile(0.99);
+		return result;
+	}
+
+	void UWriteDistribution(std::ofstream& file, const char* name, const Distribution& d)
+	{
+		char text[256];
+		snprintf(text, sizeof(text),
+			"  \"%s\": {\"mean\": %.4f, \"min\": %.4f, \"max\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p95\": %.4f, \"p99\": %.4f}",
+			name, d.mean, d.min, d.max, d.p50, d.p90, d.p95, d.p99);
+		file << text;
+	}
+
+	void UWriteJsonString(std::ofstream& file, const char* text)
+	{
+		file << '"';
+		for (const char* c = text ? text : ""; *c; ++c)
+		{
+			if (*c == '"' || *c == '\\')
+				file << '\\';
+			file << *c;
+		}
+		file << '"';
+	}
+}
+
+namespace Benchmark
+{
+	bool LoadCameraPath(const char* filename, std::vector<CameraKey>& path)
+	{
+		std::ifstream file(filename);
+		if (!file)
+			return false;
+
+		path.clear();
+		std::string line;
+		while (std::getline(file, line))
+		{
+			if (line.empty() || line[0] == '#')
+				continue;
+
+			std::istringstream fields(line);
+			CameraKey key;
+			if (fields >> key.time >> key.position.x >> key.position.y >> key.position.z >> key.yaw >> key.pitch >> key.zoom)
+				path.push_back(key);
+		}
+
+		// Keys must be in time order for sampling
+		std::sort(path.begin(), path.end(), [](const CameraKey& a, const CameraKey& b) { return a.time < b.time; });
+		return !path.empty();
+	}
+
+	bool SaveCameraPath(const char* filename, const std::vector<CameraKey>& path)
+	{
+		std::ofstream file(filename);
+		if (!file)
+			return false;
+
+		file << "# time x y z yaw pitch zoom\n";
+		char line[256];
+		for (const CameraKey& key : path)
+		{
+			snprintf(line, sizeof(line), "%.6f %.6f %.6f %.6f %.6f %.6f %.6f\n",
+				key.time, key.position.x, key.position.y, key.position.z, key.yaw, key.pitch, key.zoom);
+			file << line;
+		}
+		return (bool)file;
+	}
+
+	CameraKey SampleCameraPath(const std::vector<CameraKey>& path, float time)
+	{
+		if (path.size() == 1 || path.back().time <= 0.0f)
+			return path.front();
+
+		time = fmodf(time, path.back().time);
+
+		// Find the pair of keys around time
+		size_t next = 1;
+		while (next < path.size() - 1 && path[next].time < time)
+			++next;
+		const CameraKey& a = path[next - 1];
+		const CameraKey& b = path[next];
+
+		float span = b.time - a.time;
+		float t = span > 0.0f ? glm::clamp((time - a.time) / span, 0.0f, 1.0f) : 1.0f;
+
+		CameraKey key;
+		key.time = time;
+		key.position = glm::mix(a.position, b.position, t);
+		key.yaw = glm::mix(a.yaw, b.yaw, t);
+		key.pitch = glm::mix(a.pitch, b.pitch, t);
+		key.zoom = glm::mix(a.zoom, b.zoom, t);
+		return key;
+	}
+
+	CameraKey CaptureCameraKey(const Camera& camera, float time)
+	{
+		CameraKey key;
+		key.time = time;
+		key.position = camera.Position;
+		key.yaw = camera.Yaw;
+		key.pitch = camera.Pitch;
+		key.zoom = camera.Zoom;
+		return key;
+	}
+
+	void ApplyCameraKey(Camera& camera, const CameraKey& key)
+	{
+		camera.Position = key.position;
+		camera.Yaw = key.yaw;
+		camera.Pitch = key.pitch;
+		camera.Zoom = key.zoom;
+
+		// A zero mouse movement rebuilds Front/Right/Up from yaw and pitch
+		camera.ProcessMouseMovement(0.0f, 0.0f);
+	}
+
+	void Start(int frameCount)
+	{
+		gFrameCount = frameCount;
+		gFrameIndex = 0;
+		gSamples.assign(frameCount, FrameSample());
+		gHasFrameStart = false;
+
+		if (!gQueriesCreated)
+		{
+			glGenQueries(QUERY_COUNT, gQueries);
+			gQueriesCreated = true;
+		}
+		std::fill(gQueryFrame, gQueryFrame + QUERY_COUNT, -1);
+
+		// Draw and call counts come from the GL counters
+		GLCounters::SetEnabled(true);
+	}
+
+	void BeginFrame()
+	{
+		int slot = gFrameIndex % QUERY_COUNT;
+		UCollectQuery(slot);
+
+		glBeginQuery(GL_TIME_ELAPSED, gQueries[slot]);
+		gQueryFrame[slot] = gFrameIndex;
+
+		// The first frame has nothing before it, but it is always a warm-up frame
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		int sample = gFrameIndex - WARMUP_FRAMES;
+		if (gHasFrameStart && sample >= 0 && sample < gFrameCount)
+			gSamples[sample].cpuMs = std::chrono::duration<double, std::milli>(now - gFrameStart).count();
+		gFrameStart = now;
+		gHasFrameStart = true;
+	}
+
+	void EndFrame()
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		double submitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - gFrameStart).count();
+
+		int sample = gFrameIndex - WARMUP_FRAMES;
+		if (sample >= 0 && sample < gFrameCount)
+		{
+			const GLCounters::FrameStats& stats = GLCounters::LastFrame();
+			gSamples[sample].submitMs = submitMs;
+			gSamples[sample].drawCalls = stats.drawCalls;
+			gSamples[sample].glCalls = stats.totalCalls;
+			gSamples[sample].stateChanges = stats.stateChanges;
+		}
+		++gFrameIndex;
+	}
+
+	bool IsFinished()
+	{
+		return gFrameIndex >= gFrameCount + WARMUP_FRAMES;
+	}
+
+	bool WriteJson(const char* filename, const char* pathFilename)
+	{
+		// Wait for the queries still in flight
+		for (int slot = 0; slot < QUERY_COUNT; ++slot)
+			UCollectQuery(slot);
+
+		std::ofstream file(filename);
+		if (!file)
+			return false;
+
+		int measured = std::min(std::max(gFrameIndex - WARMUP_FRAMES, 0), gFrameCount);
+		std::vector<double> cpu, submit, gpu, draws, calls, changes;
+		for (int i = 0; i < measured; ++i)
+		{
+			cpu.push_back(gSamples[i].cpuMs);
+			submit.push_back(gSamples[i].submitMs);
+			gpu.push_back(gSamples[i].gpuMs);
+			draws.push_back(gSamples[i].drawCalls);
+			calls.push_back(gSamples[i].glCalls);
+			changes.push_back(gSamples[i].stateChanges);
+		}
+
+		file << "{\n  \"camera_path\": ";
+		UWriteJsonString(file, pathFilename);
+		file << ",\n  \"renderer\": ";
+		UWriteJsonString(file, (const char*)glGetString(GL_RENDERER));
+		file << ",\n  \"gl_version\": ";
+		UWriteJsonString(file, (const char*)glGetString(GL_VERSION));
+		file << ",\n  \"timestep\": " << TIMESTEP;
+		file << ",\n  \"warmup_frames\": " << WARMUP_FRAMES;
+		file << ",\n  \"frames\": " << measured << ",\n";
+		UWriteDistribution(file, "cpu_frame_ms", UDistribution(cpu));
+		file << ",\n";
+		UWriteDistribution(file, "render_submit_ms", UDistribution(submit));
+		file << ",\n";
+		UWriteDistribution(file, "gpu_frame_ms", UDistribution(gpu));
+		file << ",\n";
+		UWriteDistribution(file, "draw_calls", UDistribution(draws));
+		file << ",\n";
+		UWriteDistribution(file, "gl_calls", UDistribution(calls));
+		file << ",\n";
+		UWriteDistribution(file, "state_changes", UDistribution(changes));
+		file << ",\n  \"gpu_memory_bytes\": " << GpuResources::LiveBytes();
+
+		// Raw per-frame values for plotting
+		file << ",\n  \"cpu_frame_ms_samples\": [";
+		char value[32];
+		for (int i = 0; i < measured; ++i)
+		{
+			snprintf(value, sizeof(value), "%s%.4f", i ? ", " : "", cpu[i]);
+			file << value;
+		}
+		file << "],\n  \"gpu_frame_ms_samples\": [";
+		for (int i = 0; i < measured; ++i)
+		{
+			snprintf(value, sizeof(value), "%s%.4f", i ? ", " : "", gpu[i]);
+			file << value;
+		}
+		file << "]\n}\n";
+		return (bool)file;
+	}
+}
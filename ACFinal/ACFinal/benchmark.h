@@ -0,0 +1,56 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+#include <../learnOpengl/camera.h>
+
+// Deterministic frame-time benchmark. A scripted camera path is played back at
+// a fixed virtual timestep for a set number of frames and the CPU frame time,
+// GPU time and GL call counts of every frame are written out as JSON.
+//
+// The frame time is the wall-clock time between the render thread picking up
+// one snapshot and the next, so it covers the simulation, culling and waiting
+// on the main thread as well as rendering. The time spent submitting a frame
+// on the render thread alone is reported separately as render_submit_ms.
+namespace Benchmark
+{
+	// Fixed simulation step used while benchmarking (seconds)
+	const float TIMESTEP = 1.0f / 60.0f;
+
+	// Frames rendered before measurements start, lets drivers settle
+	const int WARMUP_FRAMES = 10;
+
+	// One camera pose on a path; poses between keys are interpolated linearly
+	struct CameraKey
+	{
+		float time;
+		glm::vec3 position;
+		float yaw;
+		float pitch;
+		float zoom;
+	};
+
+	// Camera paths are text files with one "time x y z yaw pitch zoom" key per line
+	bool LoadCameraPath(const char* filename, std::vector<CameraKey>& path);
+	bool SaveCameraPath(const char* filename, const std::vector<CameraKey>& path);
+
+	// Samples the path at time, looping once the last key has been passed
+	CameraKey SampleCameraPath(const std::vector<CameraKey>& path, float time);
+
+	CameraKey CaptureCameraKey(const Camera& camera, float time);
+	void ApplyCameraKey(Camera& camera, const CameraKey& key);
+
+	// Measurement of a run of frameCount frames (plus warm-up); needs a current GL context.
+	// BeginFrame goes right after a snapshot is acquired, EndFrame after it is submitted.
+	void Start(int frameCount);
+	void BeginFrame();
+	void EndFrame();
+	bool IsFinished();
+
+	// Writes the frame time distribution, GPU time and GL call counts collected since Start
+	bool WriteJson(const char* filename, const char* pathFilename);
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Entity-component storage. An entity is only an id; its data lives in one
+// component pool per component type. Each pool is a sparse set: components
+// are packed in a dense array in no particular order, and a sparse array
+// indexed by entity points into it. Systems walk the dense arrays of the
+// components they need and never touch the others.
+namespace Ecs
+{
+	typedef uint32_t Entity;
+	const Entity INVALID_ENTITY = 0xFFFFFFFFu;
+
+	// Hands out entity ids and reuses the ids of destroyed entities
+	class Registry
+	{
+	public:
+		Entity Create()
+		{
+			if (!mFree.empty())
+			{
+				Entity entity = mFree.back();
+				mFree.pop_back();
+				mAlive[entity] = 1;
+				return entity;
+			}
+			mAlive.push_back(1);
+			return (Entity)(mAlive.size() - 1);
+		}
+
+		// Components are not removed here; the owner of the pools removes them first
+		void Destroy(Entity entity)
+		{
+			mAlive[entity] = 0;
+			mFree.push_back(entity);
+		}
+
+		bool IsAlive(Entity entity) const
+		{
+			return entity < mAlive.size() && mAlive[entity];
+		}
+
+		int Count() const
+		{
+			return (int)(mAlive.size() - mFree.size());
+		}
+
+	private:
+		std::vector<uint8_t> mAlive;
+		std::vector<Entity> mFree;
+	};
+
+	template <typename T>
+	class ComponentPool
+	{
+	public:
+		T& Add(Entity entity, const T& component)
+		{
+			if (entity >= mSparse.size())
+				mSparse.resize(entity + 1, -1);
+			if (mSparse[entity] >= 0)
+				return mComponents[mSparse[entity]] = component;
+
+			mSparse[entity] = (int)mComponents.size();
+			mEntities.push_back(entity);
+			mComponents.push_back(component);
+			return mComponents.back();
+		}
+
+		// The last component moves into the hole, so removal is O(1) and the array stays packed
+		void Remove(Entity entity)
+		{
+			if (!Has(entity))
+				return;
+			int index = mSparse[entity];
+			int last = (int)mComponents.size() - 1;
+			if (index != last)
+			{
+				mComponents[index] = mComponents[last];
+				mEntities[index] = mEntities[last];
+				mSparse[mEntities[index]] = index;
+			}
+			mComponents.pop_back();
+			mEntities.pop_back();
+			mSparse[entity] = -1;
+		}
+
+		bool Has(Entity entity) const
+		{
+			return entity < mSparse.size() && mSparse[entity] >= 0;
+		}
+
+		T& Get(Entity entity)
+		{
+			return mComponents[mSparse[entity]];
+		}
+
+		const T& Get(Entity entity) const
+		{
+			return mComponents[mSparse[entity]];
+		}
+
+		// Dense access for systems, index in [0, Size())
+		int Size() const
+		{
+			return (int)mComponents.size();
+		}
+
+		Entity EntityAt(int index) const
+		{
+			return mEntities[index];
+		}
+
+		T& At(int index)
+		{
+			return mComponents[index];
+		}
+
+		const T& At(int index) const
+		{
+			return mComponents[index];
+		}
+
+	private:
+		std::vector<int> mSparse;       // by entity, index into the dense arrays or -1
+		std::vector<Entity> mEntities;  // dense
+		std::vector<T> mComponents;     // dense, same order as mEntities
+	};
+
+	// Calls function(entity, a) for every component in the pool
+	template <typename A, typename Function>
+	void View(ComponentPool<A>& a, Function function)
+	{
+		for (int i = 0; i < a.Size(); ++i)
+			function(a.EntityAt(i), a.At(i));
+	}
+
+	// Calls function(entity, a, b) for every entity that has both components.
+	// The first pool is walked in order and should be the smaller one.
+	template <typename A, typename B, typename Function>
+	void View(ComponentPool<A>& a, ComponentPool<B>& b, Function function)
+	{
+		for (int i = 0; i < a.Size(); ++i)
+		{
+			Entity entity = a.EntityAt(i);
+			if (b.Has(entity))
+				function(entity, a.At(i), b.Get(entity));
+		}
+	}
+
+	template <typename A, typename B, typename C, typename Function>
+	void View(ComponentPool<A>& a, ComponentPool<B>& b, ComponentPool<C>& c, Function function)
+	{
+		for (int i = 0; i < a.Size(); ++i)
+		{
+			Entity entity = a.EntityAt(i);
+			if (b.Has(entity) && c.Has(entity))
+				function(entity, a.At(i), b.Get(entity), c.Get(entity));
+		}
+	}
+}
@@ -0,0 +1,138 @@
+#include "framearena.h"
+
+#include <cstdlib>
+#include <new>
+
+LinearArena::LinearArena(size_t blockSize)
+	: mBlockSize(blockSize), mBlock(-1), mOffset(0), mUsedBefore(0)
+{
+}
+
+LinearArena::~LinearArena()
+{
+	for (Block& block : mBlocks)
+		free(block.memory);
+}
+
+void* LinearArena::Allocate(size_t size, size_t alignment)
+{
+	if (mBlock >= 0)
+	{
+		size_t aligned = (mOffset + alignment - 1) & ~(alignment - 1);
+		if (aligned + size <= mBlocks[mBlock].size)
+		{
+			mOffset = aligned + size;
+			return mBlocks[mBlock].memory + aligned;
+		}
+		mUsedBefore += mOffset;
+	}
+
+	// The next kept block if it is big enough, otherwise a new one at the end.
+	// malloc aligns to at least 16 bytes, so a block start is aligned for anything the arena holds.
+	int next = mBlock + 1;
+	while (next < (int)mBlocks.size() && mBlocks[next].size < size)
+		++next;
+	if (next == (int)mBlocks.size())
+	{
+		Block block;
+		block.size = size > mBlockSize ? size : mBlockSize;
+		block.memory = (char*)malloc(block.size);
+		if (!block.memory)
+			throw std::bad_alloc();
+		mBlocks.push_back(block);
+	}
+
+	mBlock = next;
+	mOffset = size;
+	return mBlocks[mBlock].memory;
+}
+
+void LinearArena::Reset()
+{
+	mBlock = mBlocks.empty() ? -1 : 0;
+	mOffset = 0;
+	mUsedBefore = 0;
+}
+
+size_t LinearArena::Used() const
+{
+	return mUsedBefore + mOffset;
+}
+
+size_t LinearArena::Capacity() const
+{
+	size_t capacity = 0;
+	for (const Block& block : mBlocks)
+		capacity += block.size;
+	return capacity;
+}
+
+LinearArena& FrameArena::ThreadArena()
+{
+	int index = Jobs::ThreadIndex();
+	return mArenas[index >= 0 ? index : 0];
+}
+
+void FrameArena::Reset()
+{
+	for (LinearArena& arena : mArenas)
+		arena.Reset();
+}
+
+size_t FrameArena::Used() const
+{
+	size_t used = 0;
+	for (const LinearArena& arena : mArenas)
+		used += arena.Used();
+	return used;
+}
+
+// Heap allocation counting
+// ------------------------
+namespace
+{
+	// Constant-initialized, so it is safe to touch from operator new on any thread
+	thread_local uint64_t tAllocations = 0;
+}
+
+namespace HeapTracking
+{
+	uint64_t ThreadAllocationCount()
+	{
+		return tAllocations;
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	++tAllocations;
+	void* memory = malloc(size ? size : 1);
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+	free(memory);
+}
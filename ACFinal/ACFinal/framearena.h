@@ -0,0 +1,86 @@
+#pragma once
+
+#include "jobs.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bump allocator. Allocation moves an offset forward through a block of
+// memory; nothing is freed individually, and Reset makes all of it available
+// again in O(1). Blocks are kept across resets, so once an arena has seen its
+// largest frame it stops touching the heap.
+//
+// No constructors or destructors run: the arena is for plain data that can be
+// dropped wholesale, like draw lists and culling results.
+class LinearArena
+{
+public:
+	static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+	explicit LinearArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+	~LinearArena();
+
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	void* Allocate(size_t size, size_t alignment);
+
+	template <typename T>
+	T* Allocate(int count)
+	{
+		return (T*)Allocate(sizeof(T) * count, alignof(T));
+	}
+
+	// Everything allocated so far becomes invalid
+	void Reset();
+
+	// Bytes handed out since the last reset, and bytes held in blocks
+	size_t Used() const;
+	size_t Capacity() const;
+
+private:
+	struct Block
+	{
+		char* memory;
+		size_t size;
+	};
+
+	std::vector<Block> mBlocks;
+	size_t mBlockSize;
+	int mBlock;         // block being allocated from, -1 before the first allocation
+	size_t mOffset;     // into mBlocks[mBlock]
+	size_t mUsedBefore; // bytes used in the blocks before mBlock
+};
+
+// The transient memory of one frame: a linear arena per job thread, so the
+// jobs of a frame can allocate without locks. Each frame snapshot owns one and
+// resets it when the slot is reused, which is when its last reader is done.
+class FrameArena
+{
+public:
+	// Arena of the calling job thread; threads outside the job system share the
+	// arena of the thread that called Jobs::Initialize
+	LinearArena& ThreadArena();
+
+	template <typename T>
+	T* Allocate(int count)
+	{
+		return ThreadArena().Allocate<T>(count);
+	}
+
+	void Reset();
+
+	size_t Used() const;
+
+private:
+	LinearArena mArenas[Jobs::MAX_THREADS];
+};
+
+// Heap allocation counting, through replacements of the global operator new.
+// The render path is expected to make no allocations once warmed up.
+namespace HeapTracking
+{
+	// operator new calls made by the calling thread so far
+	uint64_t ThreadAllocationCount();
+}
@@ -0,0 +1,386 @@
+#define GLCOUNTERS_IMPLEMENTATION
+#include "glcounters.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+	const GLuint UNKNOWN_BINDING = 0xFFFFFFFFu;
+	const int MAX_TEXTURE_UNITS = 32;
+	const int MAX_BUFFER_TARGETS = 16;
+
+	bool gInstalled = false;
+	GLCounters::FrameStats gCurrent;
+	GLCounters::FrameStats gLast;
+
+	// Last known bindings, used to spot redundant binds
+	struct BufferBinding
+	{
+		GLenum target;
+		GLuint buffer;
+	};
+	BufferBinding gBufferBindings[MAX_BUFFER_TARGETS];
+	int gBufferBindingCount = 0;
+	GLuint gVertexArrayBinding = UNKNOWN_BINDING;
+	GLuint gProgramBinding = UNKNOWN_BINDING;
+	GLenum gActiveTextureUnit = GL_TEXTURE0;
+	GLuint gTextureBindings[MAX_TEXTURE_UNITS];
+
+	void UForgetBindings()
+	{
+		gBufferBindingCount = 0;
+		gVertexArrayBinding = UNKNOWN_BINDING;
+		gProgramBinding = UNKNOWN_BINDING;
+		gActiveTextureUnit = UNKNOWN_BINDING;
+		std::fill(gTextureBindings, gTextureBindings + MAX_TEXTURE_UNITS, UNKNOWN_BINDING);
+	}
+
+	inline void UCount(GLCounters::Entry entry)
+	{
+		++gCurrent.calls[entry];
+		++gCurrent.totalCalls;
+	}
+
+	// Records a bind, flagging it when the object was already bound
+	void UCountBind(GLuint& current, GLuint object)
+	{
+		++gCurrent.stateChanges;
+		if (current == object)
+			++gCurrent.redundantBinds;
+		current = object;
+	}
+
+	GLuint& UBufferBindingSlot(GLenum target)
+	{
+		for (int i = 0; i < gBufferBindingCount; ++i)
+		{
+			if (gBufferBindings[i].target == target)
+				return gBufferBindings[i].buffer;
+		}
+		if (gBufferBindingCount == MAX_BUFFER_TARGETS)
+			gBufferBindingCount = 0;
+		gBufferBindings[gBufferBindingCount] = { target, UNKNOWN_BINDING };
+		return gBufferBindings[gBufferBindingCount++].buffer;
+	}
+
+	// Size in bytes of one pixel of client memory passed to glTexSubImage2D
+	GLuint UPixelSize(GLenum format, GLenum type)
+	{
+		GLuint components = 4;
+		switch (format)
+		{
+		case GL_RED: case GL_DEPTH_COMPONENT: components = 1; break;
+		case GL_RG: components = 2; break;
+		case GL_RGB: case GL_BGR: components = 3; break;
+		default: break;
+		}
+
+		switch (type)
+		{
+		case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: return components * 2;
+		case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: return components * 4;
+		default: return components;
+		}
+	}
+
+	// Original GLEW entry points and their counting replacements
+#define GLCOUNTERS_ORIGINAL(name) decltype(__glew##name) gOriginal##name = nullptr;
+	GLCOUNTERS_GLEW_ENTRIES(GLCOUNTERS_ORIGINAL)
+#undef GLCOUNTERS_ORIGINAL
+
+	void GLAPIENTRY UCountedBindBuffer(GLenum target, GLuint buffer)
+	{
+		UCount(GLCounters::ENTRY_BindBuffer);
+		UCountBind(UBufferBindingSlot(target), buffer);
+		gOriginalBindBuffer(target, buffer);
+	}
+
+	// Storage made without data is filled through a mapping, which is not counted
+	void GLAPIENTRY UCountedNamedBufferStorage(GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags)
+	{
+		UCount(GLCounters::ENTRY_NamedBufferStorage);
+		if (data)
+			gCurrent.bufferBytes += (uint64_t)size;
+		gOriginalNamedBufferStorage(buffer, size, data, flags);
+	}
+
+	void GLAPIENTRY UCountedBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)
+	{
+		UCount(GLCounters::ENTRY_BufferStorage);
+		if (data)
+			gCurrent.bufferBytes += (uint64_t)size;
+		gOriginalBufferStorage(target, size, data, flags);
+	}
+
+	void GLAPIENTRY UCountedTextureSubImage2D(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+		GLenum format, GLenum type, const void* pixels)
+	{
+		UCount(GLCounters::ENTRY_TextureSubImage2D);
+		if (pixels)
+			gCurrent.textureBytes += (uint64_t)width * height * UPixelSize(format, type);
+		gOriginalTextureSubImage2D(texture, level, xoffset, yoffset, width, height, format, type, pixels);
+	}
+
+	void GLAPIENTRY UCountedBindVertexArray(GLuint array)
+	{
+		UCount(GLCounters::ENTRY_BindVertexArray);
+		// The element array binding belongs to the vertex array
+		if (array != gVertexArrayBinding)
+			UBufferBindingSlot(GL_ELEMENT_ARRAY_BUFFER) = UNKNOWN_BINDING;
+		UCountBind(gVertexArrayBinding, array);
+		gOriginalBindVertexArray(array);
+	}
+
+	void GLAPIENTRY UCountedBindVertexBuffer(GLuint bindingIndex, GLuint buffer, GLintptr offset, GLsizei stride)
+	{
+		UCount(GLCounters::ENTRY_BindVertexBuffer);
+		++gCurrent.stateChanges;
+		gOriginalBindVertexBuffer(bindingIndex, buffer, offset, stride);
+	}
+
+	void GLAPIENTRY UCountedUseProgram(GLuint program)
+	{
+		UCount(GLCounters::ENTRY_UseProgram);
+		UCountBind(gProgramBinding, program);
+		gOriginalUseProgram(program);
+	}
+
+	void GLAPIENTRY UCountedActiveTexture(GLenum texture)
+	{
+		UCount(GLCounters::ENTRY_ActiveTexture);
+		UCountBind(gActiveTextureUnit, texture);
+		gOriginalActiveTexture(texture);
+	}
+
+	void GLAPIENTRY UCountedDeleteBuffers(GLsizei n, const GLuint* buffers)
+	{
+		UCount(GLCounters::ENTRY_DeleteBuffers);
+		gBufferBindingCount = 0;
+		gOriginalDeleteBuffers(n, buffers);
+	}
+
+	void GLAPIENTRY UCountedDeleteVertexArrays(GLsizei n, const GLuint* arrays)
+	{
+		UCount(GLCounters::ENTRY_DeleteVertexArrays);
+		gVertexArrayBinding = UNKNOWN_BINDING;
+		gOriginalDeleteVertexArrays(n, arrays);
+	}
+
+	void GLAPIENTRY UCountedBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+	{
+		UCount(GLCounters::ENTRY_BindBufferRange);
+		++gCurrent.stateChanges;
+		gOriginalBindBufferRange(target, index, buffer, offset, size);
+	}
+
+	void GLAPIENTRY UCountedDrawArraysInstancedBaseInstance(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount, GLuint baseInstance)
+	{
+		UCount(GLCounters::ENTRY_DrawArraysInstancedBaseInstance);
+		++gCurrent.drawCalls;
+		gOriginalDrawArraysInstancedBaseInstance(mode, first, count, instanceCount, baseInstance);
+	}
+
+	void GLAPIENTRY UCountedDrawElementsInstancedBaseInstance(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instanceCount, GLuint baseInstance)
+	{
+		UCount(GLCounters::ENTRY_DrawElementsInstancedBaseInstance);
+		++gCurrent.drawCalls;
+		gOriginalDrawElementsInstancedBaseInstance(mode, count, type, indices, instanceCount, baseInstance);
+	}
+
+	// Every command counts as a draw
+	void GLAPIENTRY UCountedMultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawCount, GLsizei stride)
+	{
+		UCount(GLCounters::ENTRY_MultiDrawElementsIndirect);
+		gCurrent.drawCalls += (uint32_t)drawCount;
+		gOriginalMultiDrawElementsIndirect(mode, type, indirect, drawCount, stride);
+	}
+
+	// Entry points with nothing to track beyond the call count
+	GLsync GLAPIENTRY UCountedFenceSync(GLenum condition, GLbitfield flags)
+	{
+		UCount(GLCounters::ENTRY_FenceSync);
+		return gOriginalFenceSync(condition, flags);
+	}
+
+	GLenum GLAPIENTRY UCountedClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+	{
+		UCount(GLCounters::ENTRY_ClientWaitSync);
+		return gOriginalClientWaitSync(sync, flags, timeout);
+	}
+
+	void GLAPIENTRY UCountedGenVertexArrays(GLsizei n, GLuint* arrays)
+	{
+		UCount(GLCounters::ENTRY_GenVertexArrays);
+		gOriginalGenVertexArrays(n, arrays);
+	}
+
+	void GLAPIENTRY UCountedEnableVertexAttribArray(GLuint index)
+	{
+		UCount(GLCounters::ENTRY_EnableVertexAttribArray);
+		gOriginalEnableVertexAttribArray(index);
+	}
+
+	const char* const ENTRY_NAMES[] =
+	{
+#define GLCOUNTERS_NAME(name) "gl" #name,
+		GLCOUNTERS_GLEW_ENTRIES(GLCOUNTERS_NAME)
+		GLCOUNTERS_DIRECT_ENTRIES(GLCOUNTERS_NAME)
+#undef GLCOUNTERS_NAME
+	};
+}
+
+namespace GLCounters
+{
+	bool gCounting = false;
+
+	void Install()
+	{
+#define GLCOUNTERS_SAVE(name) gOriginal##name = __glew##name;
+		GLCOUNTERS_GLEW_ENTRIES(GLCOUNTERS_SAVE)
+#undef GLCOUNTERS_SAVE
+		gInstalled = true;
+	}
+
+	void SetEnabled(bool enabled)
+	{
+		if (!gInstalled || enabled == gCounting)
+			return;
+
+		if (enabled)
+		{
+			// Bindings made while switched off are unknown
+			UForgetBindings();
+#define GLCOUNTERS_HOOK(name) __glew##name = UCounted##name;
+			GLCOUNTERS_GLEW_ENTRIES(GLCOUNTERS_HOOK)
+#undef GLCOUNTERS_HOOK
+		}
+		else
+		{
+#define GLCOUNTERS_RESTORE(name) __glew##name = gOriginal##name;
+			GLCOUNTERS_GLEW_ENTRIES(GLCOUNTERS_RESTORE)
+#undef GLCOUNTERS_RESTORE
+		}
+		gCounting = enabled;
+	}
+
+	bool IsEnabled()
+	{
+		return gCounting;
+	}
+
+	void BeginFrame()
+	{
+		memset(&gCurrent, 0, sizeof(gCurrent));
+	}
+
+	void EndFrame()
+	{
+		gLast = gCurrent;
+	}
+
+	const FrameStats& LastFrame()
+	{
+		return gLast;
+	}
+
+	void AddStreamBytes(uint64_t bytes)
+	{
+		if (gCounting)
+			gCurrent.streamBytes += bytes;
+	}
+
+	const char* EntryName(Entry entry)
+	{
+		return ENTRY_NAMES[entry];
+	}
+
+	void PrintFrame(const FrameStats& stats)
+	{
+		std::cout << "GL frame: " << stats.totalCalls << " calls, " << stats.drawCalls << " draws, "
+			<< stats.stateChanges << " state changes (" << stats.redundantBinds << " redundant), "
+			<< stats.bufferBytes << " buffer bytes, " << stats.textureBytes << " texture bytes, " << stats.streamBytes << " streamed bytes" << std::endl;
+
+		// Top entry points by call count
+		int order[ENTRY_COUNT];
+		for (int i = 0; i < ENTRY_COUNT; ++i)
+			order[i] = i;
+		std::sort(order, order + ENTRY_COUNT, [&stats](int a, int b) { return stats.calls[a] > stats.calls[b]; });
+
+		std::cout << "  ";
+		for (int i = 0; i < 6 && stats.calls[order[i]] > 0; ++i)
+			std::cout << ENTRY_NAMES[order[i]] << " " << stats.calls[order[i]] << "  ";
+		std::cout << std::endl;
+	}
+
+	void CountedBindTexture(GLenum target, GLuint texture)
+	{
+		UCount(ENTRY_BindTexture);
+		GLuint unit = gActiveTextureUnit - GL_TEXTURE0;
+		if (target == GL_TEXTURE_2D && unit < MAX_TEXTURE_UNITS)
+			UCountBind(gTextureBindings[unit], texture);
+		else
+			++gCurrent.stateChanges;
+		glBindTexture(target, texture);
+	}
+
+	void CountedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+	{
+		UCount(ENTRY_TexSubImage2D);
+		if (pixels)
+			gCurrent.textureBytes += (uint64_t)width * height * UPixelSize(format, type);
+		glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+	}
+
+	void CountedTexParameteri(GLenum target, GLenum pname, GLint param)
+	{
+		UCount(ENTRY_TexParameteri);
+		glTexParameteri(target, pname, param);
+	}
+
+	void CountedGenTextures(GLsizei n, GLuint* textures)
+	{
+		UCount(ENTRY_GenTextures);
+		glGenTextures(n, textures);
+	}
+
+	void CountedDeleteTextures(GLsizei n, const GLuint* textures)
+	{
+		UCount(ENTRY_DeleteTextures);
+		std::fill(gTextureBindings, gTextureBindings + MAX_TEXTURE_UNITS, UNKNOWN_BINDING);
+		glDeleteTextures(n, textures);
+	}
+
+	void CountedDrawArrays(GLenum mode, GLint first, GLsizei count)
+	{
+		UCount(ENTRY_DrawArrays);
+		++gCurrent.drawCalls;
+		glDrawArrays(mode, first, count);
+	}
+
+	void CountedDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+	{
+		UCount(ENTRY_DrawElements);
+		++gCurrent.drawCalls;
+		glDrawElements(mode, count, type, indices);
+	}
+
+	void CountedClear(GLbitfield mask)
+	{
+		UCount(ENTRY_Clear);
+		glClear(mask);
+	}
+
+	void CountedClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+	{
+		UCount(ENTRY_ClearColor);
+		glClearColor(red, green, blue, alpha);
+	}
+
+	void CountedEnable(GLenum cap)
+	{
+		UCount(ENTRY_Enable);
+		glEnable(cap);
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+// Optional GL call instrumentation. Entry points loaded by GLEW are counted by
+// swapping the GLEW function pointers for counting wrappers while enabled, so
+// there is no cost at all when switched off. The GL 1.1 entry points that GLEW
+// does not load (glBindTexture, glDrawArrays, ...) are redirected by the macros
+// at the bottom of this header and cost one branch when switched off.
+//
+// Counters are not synchronized; only count calls made on the context thread.
+
+// X(name) lists of the counted entry points
+#define GLCOUNTERS_GLEW_ENTRIES(X) \
+	X(BindBuffer) \
+	X(NamedBufferStorage) \
+	X(BufferStorage) \
+	X(TextureSubImage2D) \
+	X(BindVertexArray) \
+	X(BindVertexBuffer) \
+	X(UseProgram) \
+	X(ActiveTexture) \
+	X(BindBufferRange) \
+	X(DrawArraysInstancedBaseInstance) \
+	X(DrawElementsInstancedBaseInstance) \
+	X(MultiDrawElementsIndirect) \
+	X(FenceSync) \
+	X(ClientWaitSync) \
+	X(DeleteBuffers) \
+	X(GenVertexArrays) \
+	X(DeleteVertexArrays) \
+	X(EnableVertexAttribArray)
+
+#define GLCOUNTERS_DIRECT_ENTRIES(X) \
+	X(BindTexture) \
+	X(TexSubImage2D) \
+	X(TexParameteri) \
+	X(GenTextures) \
+	X(DeleteTextures) \
+	X(DrawArrays) \
+	X(DrawElements) \
+	X(Clear) \
+	X(ClearColor) \
+	X(Enable)
+
+namespace GLCounters
+{
+	enum Entry
+	{
+#define GLCOUNTERS_ENUM(name) ENTRY_##name,
+		GLCOUNTERS_GLEW_ENTRIES(GLCOUNTERS_ENUM)
+		GLCOUNTERS_DIRECT_ENTRIES(GLCOUNTERS_ENUM)
+#undef GLCOUNTERS_ENUM
+		ENTRY_COUNT
+	};
+
+	struct FrameStats
+	{
+		uint32_t calls[ENTRY_COUNT];
+		uint32_t totalCalls;
+		uint32_t drawCalls;
+		uint32_t stateChanges;      // binds, program and texture unit switches
+		uint32_t redundantBinds;    // binds of the object that was already bound
+		uint64_t bufferBytes;       // data given to glNamedBufferStorage / glBufferStorage
+		uint64_t textureBytes;      // glTextureSubImage2D / glTexSubImage2D payload
+		uint64_t streamBytes;       // written straight into persistently mapped buffers
+	};
+
+	// Remembers the GLEW entry points; call once right after glewInit
+	void Install();
+
+	void SetEnabled(bool enabled);
+	bool IsEnabled();
+
+	// Frame boundaries; EndFrame publishes the counts gathered since BeginFrame
+	void BeginFrame();
+	void EndFrame();
+	const FrameStats& LastFrame();
+
+	// Counts bytes written through a persistent mapping, which GL never sees
+	void AddStreamBytes(uint64_t bytes);
+
+	const char* EntryName(Entry entry);
+
+	// Prints the totals and the most called entry points of a frame
+	void PrintFrame(const FrameStats& stats);
+
+	// Set while counting; read by the redirect macros below
+	extern bool gCounting;
+
+	void CountedBindTexture(GLenum target, GLuint texture);
+	void CountedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels);
+	void CountedTexParameteri(GLenum target, GLenum pname, GLint param);
+	void CountedGenTextures(GLsizei n, GLuint* textures);
+	void CountedDeleteTextures(GLsizei n, const GLuint* textures);
+	void CountedDrawArrays(GLenum mode, GLint first, GLsizei count);
+	void CountedDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+	void CountedClear(GLbitfield mask);
+	void CountedClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+	void CountedEnable(GLenum cap);
+}
+
+#ifndef GLCOUNTERS_IMPLEMENTATION
+#define glBindTexture(target, texture) (GLCounters::gCounting ? GLCounters::CountedBindTexture(target, texture) : glBindTexture(target, texture))
+#define glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels) (GLCounters::gCounting ? GLCounters::CountedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels) : glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels))
+#define glTexParameteri(target, pname, param) (GLCounters::gCounting ? GLCounters::CountedTexParameteri(target, pname, param) : glTexParameteri(target, pname, param))
+#define glGenTextures(n, textures) (GLCounters::gCounting ? GLCounters::CountedGenTextures(n, textures) : glGenTextures(n, textures))
+#define glDeleteTextures(n, textures) (GLCounters::gCounting ? GLCounters::CountedDeleteTextures(n, textures) : glDeleteTextures(n, textures))
+#define glDrawArrays(mode, first, count) (GLCounters::gCounting ? GLCounters::CountedDrawArrays(mode, first, count) : glDrawArrays(mode, first, count))
+#define glDrawElements(mode, count, type, indices) (GLCounters::gCounting ? GLCounters::CountedDrawElements(mode, count, type, indices) : glDrawElements(mode, count, type, indices))
+#define glClear(mask) (GLCounters::gCounting ? GLCounters::CountedClear(mask) : glClear(mask))
+#define glClearColor(red, green, blue, alpha) (GLCounters::gCounting ? GLCounters::CountedClearColor(red, green, blue, alpha) : glClearColor(red, green, blue, alpha))
+#define glEnable(cap) (GLCounters::gCounting ? GLCounters::CountedEnable(cap) : glEnable(cap))
+#endif
@@ -0,0 +1,249 @@
+#include "glresources.h"
+#include "glcounters.h"
+#include "gpuresources.h"
+
+namespace
+{
+	bool gDirect = false;
+
+	// The fallback edits buffers on the copy write target, which drawing never reads,
+	// and still puts back whatever was bound there
+	struct ScopedBufferBinding
+	{
+		GLint previous;
+
+		explicit ScopedBufferBinding(GLuint buffer)
+		{
+			glGetIntegerv(GL_COPY_WRITE_BUFFER_BINDING, &previous);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+		}
+
+		~ScopedBufferBinding()
+		{
+			glBindBuffer(GL_COPY_WRITE_BUFFER, (GLuint)previous);
+		}
+	};
+
+	struct ScopedVertexArrayBinding
+	{
+		GLint previous;
+
+		explicit ScopedVertexArrayBinding(GLuint vao)
+		{
+			glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previous);
+			glBindVertexArray(vao);
+		}
+
+		~ScopedVertexArrayBinding()
+		{
+			glBindVertexArray((GLuint)previous);
+		}
+	};
+
+	// On the active texture unit
+	struct ScopedTextureBinding
+	{
+		GLint previous;
+
+		explicit ScopedTextureBinding(GLuint texture)
+		{
+			glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
+			glBindTexture(GL_TEXTURE_2D, texture);
+		}
+
+		~ScopedTextureBinding()
+		{
+			glBindTexture(GL_TEXTURE_2D, (GLuint)previous);
+		}
+	};
+}
+
+namespace GLResources
+{
+	void Initialize(bool allowDirect)
+	{
+		gDirect = allowDirect && (GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access);
+	}
+
+	bool IsDirect()
+	{
+		return gDirect;
+	}
+
+	GLuint CreateBuffer(GLenum target, GLsizeiptr bytes, const void* data, GLbitfield flags, const char* owner)
+	{
+		GLuint buffer = 0;
+		if (gDirect)
+		{
+			glCreateBuffers(1, &buffer);
+			glNamedBufferStorage(buffer, bytes, data, flags);
+		}
+		else
+		{
+			glGenBuffers(1, &buffer);
+			ScopedBufferBinding binding(buffer);
+			glBufferStorage(GL_COPY_WRITE_BUFFER, bytes, data, flags);
+		}
+		GpuResources::TrackBuffer(buffer, target, (uint64_t)bytes, owner);
+		return buffer;
+	}
+
+	void* MapBuffer(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access)
+	{
+		if (gDirect)
+			return glMapNamedBufferRange(buffer, offset, length, access);
+
+		ScopedBufferBinding binding(buffer);
+		return glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, length, access);
+	}
+
+	bool UnmapBuffer(GLuint buffer)
+	{
+		if (gDirect)
+			return glUnmapNamedBuffer(buffer) == GL_TRUE;
+
+		ScopedBufferBinding binding(buffer);
+		return glUnmapBuffer(GL_COPY_WRITE_BUFFER) == GL_TRUE;
+	}
+
+	void DestroyBuffer(GLuint& buffer)
+	{
+		if (buffer == 0)
+			return;
+		GpuResources::ReleaseBuffer(buffer);
+		glDeleteBuffers(1, &buffer);
+		buffer = 0;
+	}
+
+	GLuint CreateTexture2D(GLsizei width, GLsizei height, GLenum internalFormat, GLenum format, GLenum type, const void* pixels,
+		GLenum wrap, GLenum minFilter, GLenum magFilter, const char* owner)
+	{
+		if (width <= 0 || height <= 0)
+			return 0;
+
+		GLsizei levels = (GLsizei)GpuResources::MipLevelCount(width, height);
+		GLuint texture = 0;
+		if (gDirect)
+		{
+			glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_S, wrap);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_T, wrap);
+			glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, minFilter);
+			glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, magFilter);
+			glTextureStorage2D(texture, levels, internalFormat, width, height);
+			if (pixels)
+			{
+				glTextureSubImage2D(texture, 0, 0, 0, width, height, format, type, pixels);
+				glGenerateTextureMipmap(texture);
+			}
+		}
+		else
+		{
+			glGenTextures(1, &texture);
+			ScopedTextureBinding binding(texture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+			glTexStorage2D(GL_TEXTURE_2D, levels, internalFormat, width, height);
+			if (pixels)
+			{
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, type, pixels);
+				glGenerateMipmap(GL_TEXTURE_2D);
+			}
+		}
+		GpuResources::TrackTexture(texture, width, height, internalFormat, levels, owner);
+		return texture;
+	}
+
+	void DestroyTexture(GLuint& texture)
+	{
+		if (texture == 0)
+			return;
+		GpuResources::ReleaseTexture(texture);
+		glDeleteTextures(1, &texture);
+		texture = 0;
+	}
+
+	GLuint CreateVertexArray()
+	{
+		GLuint vao = 0;
+		if (gDirect)
+		{
+			glCreateVertexArrays(1, &vao);
+		}
+		else
+		{
+			// A generated name only becomes a vertex array once bound
+			glGenVertexArrays(1, &vao);
+			ScopedVertexArrayBinding binding(vao);
+		}
+		return vao;
+	}
+
+	void DestroyVertexArray(GLuint& vao)
+	{
+		if (vao == 0)
+			return;
+		glDeleteVertexArrays(1, &vao);
+		vao = 0;
+	}
+
+	void SetAttribFormat(GLuint vao, GLuint location, GLint components, GLenum type, GLboolean normalized, GLuint offset, GLuint binding)
+	{
+		if (gDirect)
+		{
+			glVertexArrayAttribFormat(vao, location, components, type, normalized, offset);
+			glVertexArrayAttribBinding(vao, location, binding);
+			glEnableVertexArrayAttrib(vao, location);
+			return;
+		}
+
+		ScopedVertexArrayBinding scoped(vao);
+		glVertexAttribFormat(location, components, type, normalized, offset);
+		glVertexAttribBinding(location, binding);
+		glEnableVertexAttribArray(location);
+	}
+
+	void SetAttribIFormat(GLuint vao, GLuint location, GLint components, GLenum type, GLuint offset, GLuint binding)
+	{
+		if (gDirect)
+		{
+			glVertexArrayAttribIFormat(vao, location, components, type, offset);
+			glVertexArrayAttribBinding(vao, location, binding);
+			glEnableVertexArrayAttrib(vao, location);
+			return;
+		}
+
+		ScopedVertexArrayBinding scoped(vao);
+		glVertexAttribIFormat(location, components, type, offset);
+		glVertexAttribBinding(location, binding);
+		glEnableVertexAttribArray(location);
+	}
+
+	void SetVertexBuffer(GLuint vao, GLuint binding, GLuint buffer, GLintptr offset, GLsizei stride, GLuint divisor)
+	{
+		if (gDirect)
+		{
+			glVertexArrayVertexBuffer(vao, binding, buffer, offset, stride);
+			glVertexArrayBindingDivisor(vao, binding, divisor);
+			return;
+		}
+
+		ScopedVertexArrayBinding scoped(vao);
+		glBindVertexBuffer(binding, buffer, offset, stride);
+		glVertexBindingDivisor(binding, divisor);
+	}
+
+	void SetElementBuffer(GLuint vao, GLuint buffer)
+	{
+		if (gDirect)
+		{
+			glVertexArrayElementBuffer(vao, buffer);
+			return;
+		}
+
+		ScopedVertexArrayBinding scoped(vao);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+	}
+}
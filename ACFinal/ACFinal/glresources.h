@@ -0,0 +1,50 @@
+#pragma once
+
+#include <GL/glew.h>
+
+// Creation and editing of buffers, textures and vertex arrays without touching
+// the bindings the renderer relies on.
+//
+// With GL 4.5 or ARB_direct_state_access every call names the object it edits
+// (glCreateBuffers, glNamedBufferStorage, glTextureStorage2D,
+// glVertexArrayVertexBuffer, ...), so resources can be made at any point of a
+// frame. Without it the same calls bind the object to edit it and put back
+// whatever was bound before. Either way buffers and textures get immutable
+// storage, which saves the driver from planning for reallocation.
+//
+// Buffers and textures made here are recorded with GpuResources under the
+// owner given, and released from it when destroyed here.
+namespace GLResources
+{
+	// Picks direct state access when the context has it and allowDirect is set; call once
+	// right after glewInit. Clearing allowDirect forces the bind-to-edit path.
+	void Initialize(bool allowDirect);
+	bool IsDirect();
+
+	// A buffer of bytes with immutable storage, filled from data unless it is null.
+	// flags are glBufferStorage flags, 0 for data only GL reads after creation. target
+	// only says how GpuResources counts the buffer; buffers can be bound to any target.
+	GLuint CreateBuffer(GLenum target, GLsizeiptr bytes, const void* data, GLbitfield flags, const char* owner);
+	void* MapBuffer(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access);
+	// False when the contents were lost while mapped and have to be written again
+	bool UnmapBuffer(GLuint buffer);
+	// Deletes the buffer and zeroes the handle; a handle of 0 is ignored
+	void DestroyBuffer(GLuint& buffer);
+
+	// A 2D texture with immutable storage for a full mip chain, filled from the level 0
+	// pixels and mipmapped. Returns 0 for a size of 0.
+	GLuint CreateTexture2D(GLsizei width, GLsizei height, GLenum internalFormat, GLenum format, GLenum type, const void* pixels,
+		GLenum wrap, GLenum minFilter, GLenum magFilter, const char* owner);
+	void DestroyTexture(GLuint& texture);
+
+	GLuint CreateVertexArray();
+	void DestroyVertexArray(GLuint& vao);
+
+	// Describes an attribute read as floats from binding, and enables it
+	void SetAttribFormat(GLuint vao, GLuint location, GLint components, GLenum type, GLboolean normalized, GLuint offset, GLuint binding);
+	// Describes an attribute read as integers from binding, and enables it
+	void SetAttribIFormat(GLuint vao, GLuint location, GLint components, GLenum type, GLuint offset, GLuint binding);
+	// Points a binding at a buffer; a divisor of 1 steps it once per instance
+	void SetVertexBuffer(GLuint vao, GLuint binding, GLuint buffer, GLintptr offset, GLsizei stride, GLuint divisor);
+	void SetElementBuffer(GLuint vao, GLuint buffer);
+}
@@ -0,0 +1,195 @@
+#include "gpuresources.h"
+
+#include <iostream>
+#include <unordered_map>
+
+namespace
+{
+	struct Allocation
+	{
+		GpuResources::Type type;
+		uint64_t bytes;
+		const char* owner;
+		GLsizei width;      // textures only
+		GLsizei height;
+		int mipLevels;
+	};
+
+	// Buffers and textures have separate name spaces, so key on both
+	std::unordered_map<uint64_t, Allocation> gAllocations;
+	uint64_t gLiveBytes = 0;
+	uint64_t gHighWaterBytes = 0;
+	uint64_t gLiveBytesByType[GpuResources::RESOURCE_TYPE_COUNT] = {};
+
+	const char* const TYPE_NAMES[GpuResources::RESOURCE_TYPE_COUNT] =
+	{
+		"vertex buffer",
+		"index buffer",
+		"buffer",
+		"texture"
+	};
+
+	uint64_t UKey(bool texture, GLuint name)
+	{
+		return ((uint64_t)(texture ? 1 : 0) << 32) | name;
+	}
+
+	void UAdd(uint64_t key, const Allocation& allocation)
+	{
+		auto found = gAllocations.find(key);
+		if (found != gAllocations.end())
+		{
+			gLiveBytes -= found->second.bytes;
+			gLiveBytesByType[found->second.type] -= found->second.bytes;
+		}
+
+		gAllocations[key] = allocation;
+		gLiveBytes += allocation.bytes;
+		gLiveBytesByType[allocation.type] += allocation.bytes;
+		if (gLiveBytes > gHighWaterBytes)
+			gHighWaterBytes = gLiveBytes;
+	}
+
+	void URemove(uint64_t key)
+	{
+		auto found = gAllocations.find(key);
+		if (found == gAllocations.end())
+			return;
+
+		gLiveBytes -= found->second.bytes;
+		gLiveBytesByType[found->second.type] -= found->second.bytes;
+		gAllocations.erase(found);
+	}
+
+	// Bytes per texel as stored by the driver
+	uint64_t UTexelSize(GLenum internalFormat)
+	{
+		switch (internalFormat)
+		{
+		case GL_R8: return 1;
+		case GL_RG8: case GL_R16F: return 2;
+		case GL_RGB8: return 4; // drivers pad 24-bit texels to 32 bits
+		case GL_RGBA16F: return 8;
+		case GL_RGBA32F: return 16;
+		default: return 4;
+		}
+	}
+
+	void UPrintBytes(uint64_t bytes)
+	{
+		if (bytes >= 1024 * 1024)
+			std::cout << (bytes / (1024.0 * 1024.0)) << " MB";
+		else if (bytes >= 1024)
+			std::cout << (bytes / 1024.0) << " KB";
+		else
+			std::cout << bytes << " B";
+	}
+}
+
+namespace GpuResources
+{
+	void TrackBuffer(GLuint buffer, GLenum target, uint64_t bytes, const char* owner)
+	{
+		Allocation allocation = {};
+		if (target == GL_ARRAY_BUFFER)
+			allocation.type = RESOURCE_VERTEX_BUFFER;
+		else if (target == GL_ELEMENT_ARRAY_BUFFER)
+			allocation.type = RESOURCE_INDEX_BUFFER;
+		else
+			allocation.type = RESOURCE_OTHER_BUFFER;
+		allocation.bytes = bytes;
+		allocation.owner = owner;
+		UAdd(UKey(false, buffer), allocation);
+	}
+
+	void TrackTexture(GLuint texture, GLsizei width, GLsizei height, GLenum internalFormat, int mipLevels, const char* owner)
+	{
+		if (mipLevels <= 0)
+			mipLevels = MipLevelCount(width, height);
+
+		Allocation allocation = {};
+		allocation.type = RESOURCE_TEXTURE;
+		allocation.owner = owner;
+		allocation.width = width;
+		allocation.height = height;
+		allocation.mipLevels = mipLevels;
+
+		// Sum the mip chain, each level half the size of the previous one
+		uint64_t texelSize = UTexelSize(internalFormat);
+		for (int level = 0; level < mipLevels; ++level)
+		{
+			uint64_t levelWidth = width >> level > 0 ? width >> level : 1;
+			uint64_t levelHeight = height >> level > 0 ? height >> level : 1;
+			allocation.bytes += levelWidth * levelHeight * texelSize;
+		}
+		UAdd(UKey(true, texture), allocation);
+	}
+
+	void ReleaseBuffer(GLuint buffer)
+	{
+		URemove(UKey(false, buffer));
+	}
+
+	void ReleaseTexture(GLuint texture)
+	{
+		URemove(UKey(true, texture));
+	}
+
+	uint64_t LiveBytes()
+	{
+		return gLiveBytes;
+	}
+
+	uint64_t HighWaterBytes()
+	{
+		return gHighWaterBytes;
+	}
+
+	uint64_t LiveBytes(Type type)
+	{
+		return gLiveBytesByType[type];
+	}
+
+	int MipLevelCount(GLsizei width, GLsizei height)
+	{
+		int levels = 1;
+		GLsizei size = width > height ? width : height;
+		while (size > 1)
+		{
+			size >>= 1;
+			++levels;
+		}
+		return levels;
+	}
+
+	void PrintReport()
+	{
+		std::cout << "GPU memory: ";
+		UPrintBytes(gLiveBytes);
+		std::cout << " live in " << gAllocations.size() << " allocations, peak ";
+		UPrintBytes(gHighWaterBytes);
+		std::cout << std::endl;
+
+		for (int type = 0; type < RESOURCE_TYPE_COUNT; ++type)
+		{
+			std::cout << "  " << TYPE_NAMES[type] << "s: ";
+			UPrintBytes(gLiveBytesByType[type]);
+			std::cout << std::endl;
+		}
+	}
+
+	int ReportLeaks()
+	{
+		for (const auto& entry : gAllocations)
+		{
+			const Allocation& allocation = entry.second;
+			std::cout << "Leaked " << TYPE_NAMES[allocation.type] << " " << (GLuint)entry.first
+				<< " (" << (allocation.owner ? allocation.owner : "unknown") << "): ";
+			UPrintBytes(allocation.bytes);
+			if (allocation.type == RESOURCE_TEXTURE)
+				std::cout << ", " << allocation.width << "x" << allocation.height << " with " << allocation.mipLevels << " mips";
+			std::cout << std::endl;
+		}
+		return (int)gAllocations.size();
+	}
+}
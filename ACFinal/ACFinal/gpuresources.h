@@ -0,0 +1,42 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+// Book-keeping of GPU allocations made by the mesh and texture loaders, so the
+// VRAM used by a scene can be budgeted and leaks show up at shutdown.
+// Owner names are stored by pointer and must outlive the allocation record.
+namespace GpuResources
+{
+	enum Type
+	{
+		RESOURCE_VERTEX_BUFFER,
+		RESOURCE_INDEX_BUFFER,
+		RESOURCE_OTHER_BUFFER,
+		RESOURCE_TEXTURE,
+		RESOURCE_TYPE_COUNT
+	};
+
+	// Records the data store of a buffer object; tracking the same buffer again replaces its size
+	void TrackBuffer(GLuint buffer, GLenum target, uint64_t bytes, const char* owner);
+
+	// Records a 2D texture and, when mipLevels is 0, its full mip chain
+	void TrackTexture(GLuint texture, GLsizei width, GLsizei height, GLenum internalFormat, int mipLevels, const char* owner);
+
+	void ReleaseBuffer(GLuint buffer);
+	void ReleaseTexture(GLuint texture);
+
+	uint64_t LiveBytes();
+	uint64_t HighWaterBytes();
+	uint64_t LiveBytes(Type type);
+
+	// Number of levels in a full mip chain for the given size
+	int MipLevelCount(GLsizei width, GLsizei height);
+
+	// Prints live and peak usage by type
+	void PrintReport();
+
+	// Prints every allocation still alive, returns the number found
+	int ReportLeaks();
+}
@@ -0,0 +1,315 @@
+#include "input.h"
+
+#include <GLFW/glfw3.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace
+{
+	// Log layout: an 8 byte header ("ACIN" and a version), then one record per event:
+	//   uint8  type
+	//   varint time since the previous record, in microseconds, zigzag signed since
+	//          the events of a frame arrive before its frame record is written
+	//   payload: frame  float32 delta time
+	//            key    varint key + 1, uint8 action
+	//            cursor float64 x, float64 y
+	//            scroll float64 x offset, float64 y offset
+	// Delta times and cursor/scroll values are stored exactly as received, which is
+	// what keeps a replay bit-exact; timestamps only serve to place events on a timeline.
+	const char LOG_MAGIC[4] = { 'A', 'C', 'I', 'N' };
+	const uint32_t LOG_VERSION = 1;
+
+	const int KEY_COUNT = GLFW_KEY_LAST + 1;
+
+	std::vector<Input::Event> gPending;       // received since the last frame
+	std::vector<Input::Event> gFrameEvents;   // events of the current frame
+	size_t gNextEvent = 0;
+	bool gKeys[KEY_COUNT] = {};
+
+	std::ofstream gRecordFile;
+	std::vector<uint8_t> gRecordBuffer;
+	int64_t gRecordLastTime = 0;
+
+	bool gReplaying = false;
+	std::vector<uint8_t> gReplayData;
+	size_t gReplayOffset = 0;
+	int64_t gReplayTime = 0;
+
+	int64_t UMicroseconds(double time)
+	{
+		return (int64_t)(time * 1.0e6 + 0.5);
+	}
+
+	void UWriteVarint(uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			gRecordBuffer.push_back((uint8_t)(value | 0x80));
+			value >>= 7;
+		}
+		gRecordBuffer.push_back((uint8_t)value);
+	}
+
+	template <typename T>
+	void UWriteRaw(T value)
+	{
+		uint8_t bytes[sizeof(T)];
+		memcpy(bytes, &value, sizeof(T));
+		gRecordBuffer.insert(gRecordBuffer.end(), bytes, bytes + sizeof(T));
+	}
+
+	void UWriteEvent(const Input::Event& event)
+	{
+		int64_t time = UMicroseconds(event.time);
+		int64_t delta = time - gRecordLastTime;
+		gRecordLastTime = time;
+
+		gRecordBuffer.push_back(event.type);
+		UWriteVarint(((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));
+		switch (event.type)
+		{
+		case Input::EVENT_FRAME:
+			UWriteRaw(event.deltaTime);
+			break;
+		case Input::EVENT_KEY:
+			UWriteVarint((uint64_t)(event.key + 1)); // GLFW_KEY_UNKNOWN is -1
+			gRecordBuffer.push_back((uint8_t)event.action);
+			break;
+		case Input::EVENT_CURSOR:
+		case Input::EVENT_SCROLL:
+			UWriteRaw(event.x);
+			UWriteRaw(event.y);
+			break;
+		default:
+			break;
+		}
+	}
+
+	bool UReadVarint(uint64_t& value)
+	{
+		value = 0;
+		for (int shift = 0; shift < 64 && gReplayOffset < gReplayData.size(); shift += 7)
+		{
+			uint8_t byte = gReplayData[gReplayOffset++];
+			value |= (uint64_t)(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+
+	template <typename T>
+	bool UReadRaw(T& value)
+	{
+		if (gReplayData.size() - gReplayOffset < sizeof(T))
+			return false;
+		memcpy(&value, &gReplayData[gReplayOffset], sizeof(T));
+		gReplayOffset += sizeof(T);
+		return true;
+	}
+
+	// Decodes the record at the read position, returns false at the end of the log or on a damaged record
+	bool UReadEvent(Input::Event& event)
+	{
+		if (gReplayOffset >= gReplayData.size())
+			return false;
+
+		event = Input::Event();
+		event.type = (Input::EventType)gReplayData[gReplayOffset++];
+
+		uint64_t delta;
+		if (!UReadVarint(delta))
+			return false;
+		gReplayTime += (int64_t)(delta >> 1) ^ -(int64_t)(delta & 1);
+		event.time = gReplayTime / 1.0e6;
+
+		switch (event.type)
+		{
+		case Input::EVENT_FRAME:
+			return UReadRaw(event.deltaTime);
+		case Input::EVENT_KEY:
+		{
+			uint64_t key;
+			uint8_t action;
+			if (!UReadVarint(key) || !UReadRaw(action))
+				return false;
+			event.key = (int)key - 1;
+			event.action = action;
+			return true;
+		}
+		case Input::EVENT_CURSOR:
+		case Input::EVENT_SCROLL:
+			return UReadRaw(event.x) && UReadRaw(event.y);
+		default:
+			return false;
+		}
+	}
+
+	// The type of the record at the read position without consuming it
+	bool UPeekType(Input::EventType& type)
+	{
+		if (gReplayOffset >= gReplayData.size())
+			return false;
+		type = (Input::EventType)gReplayData[gReplayOffset];
+		return true;
+	}
+
+	void UPush(const Input::Event& event)
+	{
+		if (!gReplaying)
+			gPending.push_back(event);
+	}
+}
+
+namespace Input
+{
+	void PushKey(double time, int key, int action)
+	{
+		Event event = {};
+		event.type = EVENT_KEY;
+		event.time = time;
+		event.key = key;
+		event.action = action;
+		UPush(event);
+	}
+
+	void PushCursor(double time, double x, double y)
+	{
+		Event event = {};
+		event.type = EVENT_CURSOR;
+		event.time = time;
+		event.x = x;
+		event.y = y;
+		UPush(event);
+	}
+
+	void PushScroll(double time, double xoffset, double yoffset)
+	{
+		Event event = {};
+		event.type = EVENT_SCROLL;
+		event.time = time;
+		event.x = xoffset;
+		event.y = yoffset;
+		UPush(event);
+	}
+
+	bool BeginFrame(double time, float& deltaTime)
+	{
+		gFrameEvents.clear();
+		gNextEvent = 0;
+
+		if (gReplaying)
+		{
+			// A frame is its frame record and everything up to the next one
+			Event frame;
+			if (!UReadEvent(frame) || frame.type != EVENT_FRAME)
+			{
+				gReplaying = false;
+				return false;
+			}
+			deltaTime = frame.deltaTime;
+
+			EventType type;
+			while (UPeekType(type) && type != EVENT_FRAME)
+			{
+				Event event;
+				if (!UReadEvent(event))
+				{
+					// Drop the damaged tail, the events read so far are still played
+					gReplayOffset = gReplayData.size();
+					break;
+				}
+				gFrameEvents.push_back(event);
+			}
+			return true;
+		}
+
+		gFrameEvents.swap(gPending);
+
+		if (gRecordFile.is_open())
+		{
+			Event frame = {};
+			frame.type = EVENT_FRAME;
+			frame.time = time;
+			frame.deltaTime = deltaTime;
+
+			gRecordBuffer.clear();
+			UWriteEvent(frame);
+			for (const Event& event : gFrameEvents)
+				UWriteEvent(event);
+			gRecordFile.write((const char*)gRecordBuffer.data(), gRecordBuffer.size());
+		}
+		return true;
+	}
+
+	bool PollEvent(Event& event)
+	{
+		if (gNextEvent >= gFrameEvents.size())
+			return false;
+
+		event = gFrameEvents[gNextEvent++];
+		if (event.type == EVENT_KEY && event.key >= 0 && event.key < KEY_COUNT)
+			gKeys[event.key] = event.action != GLFW_RELEASE;
+		return true;
+	}
+
+	bool IsKeyDown(int key)
+	{
+		return key >= 0 && key < KEY_COUNT && gKeys[key];
+	}
+
+	bool StartRecording(const char* filename)
+	{
+		StopRecording();
+
+		gRecordFile.open(filename, std::ios::binary);
+		if (!gRecordFile)
+			return false;
+
+		gRecordFile.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+		gRecordFile.write((const char*)&LOG_VERSION, sizeof(LOG_VERSION));
+		gRecordLastTime = 0;
+		return (bool)gRecordFile;
+	}
+
+	void StopRecording()
+	{
+		if (gRecordFile.is_open())
+			gRecordFile.close();
+	}
+
+	bool IsRecording()
+	{
+		return gRecordFile.is_open();
+	}
+
+	bool StartReplay(const char* filename)
+	{
+		std::ifstream file(filename, std::ios::binary);
+		if (!file)
+			return false;
+
+		gReplayData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+		uint32_t version = 0;
+		if (gReplayData.size() < sizeof(LOG_MAGIC) + sizeof(version) || memcmp(gReplayData.data(), LOG_MAGIC, sizeof(LOG_MAGIC)) != 0)
+			return false;
+		memcpy(&version, &gReplayData[sizeof(LOG_MAGIC)], sizeof(version));
+		if (version != LOG_VERSION)
+			return false;
+
+		gReplayOffset = sizeof(LOG_MAGIC) + sizeof(version);
+		gReplayTime = 0;
+		gPending.clear();
+		gReplaying = true;
+		return true;
+	}
+
+	bool IsReplaying()
+	{
+		return gReplaying;
+	}
+}
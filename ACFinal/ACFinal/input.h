@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+// Input event queue. The GLFW callbacks push timestamped events, and once per
+// frame the simulation drains them in order, so all camera control goes through
+// one stream. That stream can be recorded to a compact binary log and replayed
+// later. A replay feeds the simulation the same events with the same frame delta
+// times, so it reproduces the recorded session bit-exactly.
+//
+// Recording and replay always start at application start, so the camera and
+// mouse state they begin from is the same.
+namespace Input
+{
+	enum EventType : uint8_t
+	{
+		EVENT_FRAME,    // start of a frame, carries its delta time
+		EVENT_KEY,
+		EVENT_CURSOR,
+		EVENT_SCROLL,
+		EVENT_TYPE_COUNT
+	};
+
+	struct Event
+	{
+		EventType type;
+		double time;        // glfwGetTime() when the event was received
+		int key;            // EVENT_KEY
+		int action;         // EVENT_KEY: GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT
+		double x;           // EVENT_CURSOR position, EVENT_SCROLL offset
+		double y;
+		float deltaTime;    // EVENT_FRAME
+	};
+
+	// Called from the GLFW callbacks; live events are dropped while replaying
+	void PushKey(double time, int key, int action);
+	void PushCursor(double time, double x, double y);
+	void PushScroll(double time, double xoffset, double yoffset);
+
+	// Starts a frame. Live, the frame takes the events queued since the last
+	// frame and deltaTime is passed through. When replaying, the events and
+	// deltaTime come from the log instead. Returns false once a replay has run out.
+	bool BeginFrame(double time, float& deltaTime);
+
+	// Pops the next event of the current frame in arrival order
+	bool PollEvent(Event& event);
+
+	// Key state as of the events polled so far
+	bool IsKeyDown(int key);
+
+	// Writes every frame from now on to filename until StopRecording
+	bool StartRecording(const char* filename);
+	void StopRecording();
+	bool IsRecording();
+
+	// Replaces live input with the frames recorded in filename
+	bool StartReplay(const char* filename);
+	bool IsReplaying();
+}
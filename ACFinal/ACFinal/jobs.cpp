@@ -0,0 +1,506 @@
+#include "jobs.h"
+#include "framearena.h"
+#include "trace.h"
+
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// Per-thread deque and job pool sizes. A full deque runs the job inline, and
+	// job records are reused in a ring; a thread that comes back around to a
+	// record that is still in use runs other jobs until it is free.
+	const int64_t DEQUE_SIZE = 4096;
+	const int JOB_POOL_SIZE = 4096;
+
+	// Failed searches for work before a worker goes to sleep
+	const int SPIN_COUNT = 64;
+
+
+	struct Job
+	{
+		Jobs::Function function;
+		void* data;
+		Jobs::Counter* counter;
+		std::atomic<bool> busy;
+	};
+
+	// Chase-Lev deque (Le et al., "Correct and Efficient Work-Stealing for Weak
+	// Memory Models"). Only the owner calls Push and Pop; any thread may Steal.
+	class WorkDeque
+	{
+	public:
+		WorkDeque()
+			: mTop(0), mBottom(0)
+		{
+			for (int64_t i = 0; i < DEQUE_SIZE; ++i)
+				mJobs[i].store(nullptr, std::memory_order_relaxed);
+		}
+
+		bool Push(Job* job)
+		{
+			int64_t bottom = mBottom.load(std::memory_order_relaxed);
+			int64_t top = mTop.load(std::memory_order_acquire);
+			if (bottom - top >= DEQUE_SIZE)
+				return false;
+
+			mJobs[bottom & (DEQUE_SIZE - 1)].store(job, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		Job* Pop()
+		{
+			int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+			mBottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = mTop.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				// Empty
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Job* job = mJobs[bottom & (DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				// Last job, race the thieves for it
+				if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					job = nullptr;
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return job;
+		}
+
+		Job* Steal()
+		{
+			int64_t top = mTop.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t bottom = mBottom.load(std::memory_order_acquire);
+			if (top >= bottom)
+				return nullptr;
+
+			Job* job = mJobs[top & (DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+			if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+			return job;
+		}
+
+	private:
+		// Thieves and the owner write different ends, keep them on separate cache lines
+		alignas(64) std::atomic<int64_t> mTop;
+		alignas(64) std::atomic<int64_t> mBottom;
+		alignas(64) std::atomic<Job*> mJobs[DEQUE_SIZE];
+	};
+
+	std::vector<std::unique_ptr<WorkDeque>> gDeques;
+	std::vector<std::thread> gWorkers;
+	int gThreadCount = 0;
+
+	// Jobs submitted from threads that have no deque of their own
+	std::mutex gSharedMutex;
+	std::deque<Job*> gSharedJobs;
+	std::atomic<int> gSharedCount(0);
+
+	// Sleeping workers wake up when jobs are queued or on shutdown
+	std::mutex gSleepMutex;
+	std::condition_variable gWakeUp;
+	std::atomic<int> gQueuedJobs(0);
+	std::atomic<int> gSleepingWorkers(0);
+	std::atomic<bool> gShutdown(false);
+
+	std::atomic<uint64_t> gSteals(0);
+
+	// Heap allocation count of every worker thread, published after each job it runs
+	std::atomic<uint64_t> gWorkerAllocations[Jobs::MAX_THREADS];
+
+	// Index of the deque owned by this thread, -1 for threads outside the system
+	thread_local int tWorkerIndex = -1;
+	thread_local Job tJobPool[JOB_POOL_SIZE];
+	thread_local int tNextJob = 0;
+	thread_local unsigned tNextVictim = 0;
+
+	const char* const WORKER_NAMES[Jobs::MAX_THREADS] =
+	{
+		"worker 0", "worker 1", "worker 2", "worker 3", "worker 4", "worker 5", "worker 6", "worker 7",
+		"worker 8", "worker 9", "worker 10", "worker 11", "worker 12", "worker 13", "worker 14", "worker 15",
+		"worker 16", "worker 17", "worker 18", "worker 19", "worker 20", "worker 21", "worker 22", "worker 23",
+		"worker 24", "worker 25", "worker 26", "worker 27", "worker 28", "worker 29", "worker 30", "worker 31",
+		"worker 32", "worker 33", "worker 34", "worker 35", "worker 36", "worker 37", "worker 38", "worker 39",
+		"worker 40", "worker 41", "worker 42", "worker 43", "worker 44", "worker 45", "worker 46", "worker 47",
+		"worker 48", "worker 49", "worker 50", "worker 51", "worker 52", "worker 53", "worker 54", "worker 55",
+		"worker 56", "worker 57", "worker 58", "worker 59", "worker 60", "worker 61", "worker 62", "worker 63"
+	};
+
+	void UExecute(Job* job)
+	{
+		job->function(job->data);
+		// Published before the counter drops, so a thread done waiting sees the job's allocations
+		if (tWorkerIndex > 0)
+			gWorkerAllocations[tWorkerIndex].store(HeapTracking::ThreadAllocationCount(), std::memory_order_relaxed);
+		Jobs::Counter* counter = job->counter;
+		job->busy.store(false, std::memory_order_release);
+		if (counter)
+			counter->pending.fetch_sub(1, std::memory_order_release);
+	}
+
+	Job* UTakeJob()
+	{
+		Job* job = nullptr;
+
+		// Newest job of our own first, it is the most likely to be in cache
+		if (tWorkerIndex >= 0)
+			job = gDeques[tWorkerIndex]->Pop();
+
+		if (!job && gSharedCount.load() > 0)
+		{
+			std::lock_guard<std::mutex> lock(gSharedMutex);
+			if (!gSharedJobs.empty())
+			{
+				job = gSharedJobs.front();
+				gSharedJobs.pop_front();
+				gSharedCount.fetch_sub(1);
+			}
+		}
+
+		// Then steal the oldest job of another thread, trying a different victim first each time
+		for (int i = 0; !job && i < gThreadCount; ++i)
+		{
+			int victim = (int)(tNextVictim++ % gThreadCount);
+			if (victim == tWorkerIndex)
+				continue;
+			job = gDeques[victim]->Steal();
+			if (job)
+				gSteals.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (job)
+			gQueuedJobs.fetch_sub(1);
+		return job;
+	}
+
+	void UWorkerMain(int index)
+	{
+		tWorkerIndex = index;
+		tNextVictim = index + 1;
+		// Naming allocates the thread's trace ring, skip it for untraced runs such as the benchmark
+		if (Trace::IsEnabled())
+			Trace::SetThreadName(WORKER_NAMES[index]);
+
+		int idle = 0;
+		while (!gShutdown.load(std::memory_order_relaxed))
+		{
+			Job* job = UTakeJob();
+			if (job)
+			{
+				UExecute(job);
+				idle = 0;
+			}
+			else if (++idle < SPIN_COUNT)
+				std::this_thread::yield();
+			else
+			{
+				std::unique_lock<std::mutex> lock(gSleepMutex);
+				gSleepingWorkers.fetch_add(1);
+				gWakeUp.wait(lock, [] { return gQueuedJobs.load() > 0 || gShutdown.load(); });
+				gSleepingWorkers.fetch_sub(1);
+				idle = 0;
+			}
+		}
+	}
+
+	struct Range
+	{
+		Jobs::RangeFunction function;
+		void* data;
+		int begin;
+		int end;
+	};
+
+	void URangeJob(void* data)
+	{
+		Range* range = (Range*)data;
+		range->function(range->begin, range->end, range->data);
+	}
+}
+
+namespace Jobs
+{
+	void Initialize(int threadCount)
+	{
+		if (threadCount <= 0)
+			threadCount = (int)std::thread::hardware_concurrency();
+		if (threadCount <= 0)
+			threadCount = 1;
+		if (threadCount > MAX_THREADS)
+			threadCount = MAX_THREADS;
+
+		gThreadCount = threadCount;
+		gShutdown = false;
+		for (int i = 0; i < threadCount; ++i)
+			gDeques.push_back(std::unique_ptr<WorkDeque>(new WorkDeque()));
+
+		// Early returns from main must not leave joinable worker threads behind
+		static bool shutdownRegistered = false;
+		if (!shutdownRegistered)
+		{
+			atexit(Shutdown);
+			shutdownRegistered = true;
+		}
+
+		// The calling thread is worker 0 and runs jobs while it waits
+		tWorkerIndex = 0;
+		for (int i = 1; i < threadCount; ++i)
+			gWorkers.push_back(std::thread(UWorkerMain, i));
+	}
+
+	void Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(gSleepMutex);
+			gShutdown = true;
+		}
+		gWakeUp.notify_all();
+
+		for (std::thread& worker : gWorkers)
+			worker.join();
+		gWorkers.clear();
+		gDeques.clear();
+		gSharedJobs.clear();
+		gSharedCount = 0;
+		gQueuedJobs = 0;
+		gThreadCount = 0;
+		tWorkerIndex = -1;
+		for (std::atomic<uint64_t>& allocations : gWorkerAllocations)
+			allocations = 0;
+	}
+
+	int ThreadCount()
+	{
+		return gThreadCount;
+	}
+
+	int ThreadIndex()
+	{
+		return tWorkerIndex;
+	}
+
+	uint64_t WorkerAllocationCount()
+	{
+		uint64_t total = 0;
+		for (std::atomic<uint64_t>& allocations : gWorkerAllocations)
+			total += allocations.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	void Run(Function function, void* data, Counter* counter)
+	{
+		Job* job = &tJobPool[tNextJob];
+		tNextJob = (tNextJob + 1) % JOB_POOL_SIZE;
+		while (job->busy.load(std::memory_order_acquire))
+		{
+			Job* other = UTakeJob();
+			if (other)
+				UExecute(other);
+			else
+				std::this_thread::yield();
+		}
+		job->busy.store(true, std::memory_order_relaxed);
+		job->function = function;
+		job->data = data;
+		job->counter = counter;
+
+		if (counter)
+			counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+		if (gThreadCount == 0)
+		{
+			// Not initialized, run synchronously
+			UExecute(job);
+			return;
+		}
+
+		if (tWorkerIndex >= 0)
+		{
+			if (!gDeques[tWorkerIndex]->Push(job))
+			{
+				UExecute(job);
+				return;
+			}
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(gSharedMutex);
+			gSharedJobs.push_back(job);
+			gSharedCount.fetch_add(1);
+		}
+
+		gQueuedJobs.fetch_add(1);
+		if (gSleepingWorkers.load() > 0)
+		{
+			// Taking the lock orders this with a worker that is about to sleep
+			std::lock_guard<std::mutex> lock(gSleepMutex);
+			gWakeUp.notify_one();
+		}
+	}
+
+	void Wait(Counter* counter)
+	{
+		while (counter->pending.load(std::memory_order_acquire) > 0)
+		{
+			Job* job = UTakeJob();
+			if (job)
+				UExecute(job);
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	void ParallelFor(int count, int batchSize, RangeFunction function, void* data)
+	{
+		if (count <= 0)
+			return;
+		if (batchSize <= 0)
+			batchSize = 1;
+
+		// Small loops keep their ranges on the stack so per-frame work does not touch the heap;
+		// larger ones allocate on the calling thread, which its zero allocation check reports
+		const int LOCAL_RANGES = 64;
+		Range localRanges[LOCAL_RANGES];
+		std::vector<Range> heapRanges;
+		int rangeCount = (count + batchSize - 1) / batchSize;
+		Range* ranges = localRanges;
+		if (rangeCount > LOCAL_RANGES)
+		{
+			heapRanges.resize(rangeCount);
+			ranges = heapRanges.data();
+		}
+
+		for (int i = 0; i < rangeCount; ++i)
+		{
+			int begin = i * batchSize;
+			Range range = { function, data, begin, begin + batchSize < count ? begin + batchSize : count };
+			ranges[i] = range;
+		}
+
+		Counter counter;
+		for (int i = 0; i < rangeCount; ++i)
+			Run(URangeJob, &ranges[i], &counter);
+		Wait(&counter);
+	}
+}
+
+// Micro-benchmark
+// ---------------
+namespace
+{
+	const int EMPTY_JOB_BATCH = 1000;
+	const int EMPTY_JOB_ROUNDS = 200;
+	const int SCALING_ITEMS = 1 << 22;
+	const int SCALING_BATCH = 1 << 12;
+	const int REPEATS = 5;
+
+	void UEmptyJob(void*)
+	{
+	}
+
+	// Enough arithmetic per item that the run is compute bound rather than memory bound
+	void UScalingBatch(int begin, int end, void* data)
+	{
+		float* values = (float*)data;
+		for (int i = begin; i < end; ++i)
+		{
+			float x = (float)i * 0.001f;
+			for (int k = 0; k < 16; ++k)
+				x = sqrtf(x * x + 1.0f) * 0.5f;
+			values[i] = x;
+		}
+	}
+
+	double UMilliseconds(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+namespace Jobs
+{
+	void RunBenchmark()
+	{
+		int maxThreads = (int)std::thread::hardware_concurrency();
+		if (maxThreads <= 0)
+			maxThreads = 1;
+		if (maxThreads > MAX_THREADS)
+			maxThreads = MAX_THREADS;
+
+		std::vector<float> values(SCALING_ITEMS);
+
+		std::cout << "Job system benchmark, " << maxThreads << " hardware threads" << std::endl;
+		std::cout << "threads  empty job (ns)  parallel for (ms)  speedup  efficiency  steals" << std::endl;
+
+		// Powers of two up to the hardware thread count, and the count itself
+		std::vector<int> threadCounts;
+		for (int threads = 1; threads < maxThreads; threads *= 2)
+			threadCounts.push_back(threads);
+		threadCounts.push_back(maxThreads);
+
+		double singleThreadMs = 0.0;
+		for (int threads : threadCounts)
+		{
+			Initialize(threads);
+
+			// Scheduling overhead: submit and wait for batches of jobs that do nothing
+			double bestEmptyNs = 1.0e30;
+			for (int repeat = 0; repeat < REPEATS; ++repeat)
+			{
+				auto start = std::chrono::steady_clock::now();
+				for (int round = 0; round < EMPTY_JOB_ROUNDS; ++round)
+				{
+					Counter counter;
+					for (int i = 0; i < EMPTY_JOB_BATCH; ++i)
+						Run(UEmptyJob, nullptr, &counter);
+					Wait(&counter);
+				}
+				double ns = UMilliseconds(start) * 1.0e6 / ((double)EMPTY_JOB_ROUNDS * EMPTY_JOB_BATCH);
+				if (ns < bestEmptyNs)
+					bestEmptyNs = ns;
+			}
+
+			// Scaling: a compute bound parallel for split into many batches
+			gSteals = 0;
+			double bestMs = 1.0e30;
+			for (int repeat = 0; repeat < REPEATS; ++repeat)
+			{
+				auto start = std::chrono::steady_clock::now();
+				ParallelFor(SCALING_ITEMS, SCALING_BATCH, UScalingBatch, values.data());
+				double ms = UMilliseconds(start);
+				if (ms < bestMs)
+					bestMs = ms;
+			}
+			uint64_t steals = gSteals / REPEATS;
+
+			Shutdown();
+
+			if (threads == 1)
+				singleThreadMs = bestMs;
+			double speedup = singleThreadMs / bestMs;
+
+			char line[128];
+			snprintf(line, sizeof(line), "%7d  %14.1f  %17.2f  %7.2f  %9.0f%%  %6llu",
+				threads, bestEmptyNs, bestMs, speedup, 100.0 * speedup / threads, (unsigned long long)steals);
+			std::cout << line << std::endl;
+		}
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Work-stealing job system. Every worker thread, and the thread that calls
+// Initialize, owns a lock-free deque. A thread pushes and pops jobs at the
+// bottom of its own deque, and idle workers steal from the top of the others.
+// Threads outside the system submit through a shared queue instead.
+//
+// Completion is tracked with counters. Run increments the counter and it is
+// decremented once the job has finished. Wait does not block: the waiting
+// thread runs other jobs until its counter reaches zero, so jobs can wait on
+// the jobs they submit.
+namespace Jobs
+{
+	const int MAX_THREADS = 64;
+
+	typedef void (*Function)(void* data);
+	typedef void (*RangeFunction)(int begin, int end, void* data);
+
+	struct Counter
+	{
+		std::atomic<int> pending;
+
+		Counter()
+			: pending(0)
+		{
+		}
+	};
+
+	// Starts the workers; threadCount includes the calling thread, 0 uses one per hardware thread
+	void Initialize(int threadCount = 0);
+	void Shutdown();
+
+	// Number of threads running jobs, including the one that called Initialize
+	int ThreadCount();
+
+	// Index of the calling thread in [0, ThreadCount()), -1 for threads outside the job system
+	int ThreadIndex();
+
+	// Heap allocations made so far by the worker threads Initialize started, as of the
+	// last job each of them finished. Allocations of the calling threads are not included.
+	uint64_t WorkerAllocationCount();
+
+	// Queues function(data); counter may be null
+	void Run(Function function, void* data, Counter* counter);
+
+	// Runs queued jobs on the calling thread until counter reaches zero
+	void Wait(Counter* counter);
+
+	// Calls function on batches of at most batchSize items covering [0, count) and waits for all of them
+	void ParallelFor(int count, int batchSize, RangeFunction function, void* data);
+
+	// Measures scheduling overhead and scaling from 1 to N threads and prints a table
+	void RunBenchmark();
+}
@@ -0,0 +1,243 @@
+#include "meshlets.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+	// Marks a vertex as not in the meshlet being filled
+	const uint8_t NOT_IN_MESHLET = 0xFF;
+	const uint32_t NO_TRIANGLE = 0xFFFFFFFFu;
+
+	struct Vector3
+	{
+		float x, y, z;
+	};
+
+	Vector3 UPosition(const uint8_t* vertices, size_t stride, uint32_t vertex)
+	{
+		Vector3 position;
+		memcpy(&position, vertices + vertex * stride, sizeof(position));
+		return position;
+	}
+
+	float ULength(const Vector3& v)
+	{
+		return sqrtf(v.x * v.x + v.y * v.y + v.z * v.z);
+	}
+
+	// Zero for a zero vector
+	Vector3 UNormalize(const Vector3& v)
+	{
+		float length = ULength(v);
+		float inverseLength = length > 0.0f ? 1.0f / length : 0.0f;
+		return { v.x * inverseLength, v.y * inverseLength, v.z * inverseLength };
+	}
+
+	// Facing out of the counter-clockwise side; degenerate triangles face nowhere
+	Vector3 UTriangleNormal(const Vector3& a, const Vector3& b, const Vector3& p)
+	{
+		Vector3 ab = { b.x - a.x, b.y - a.y, b.z - a.z };
+		Vector3 ap = { p.x - a.x, p.y - a.y, p.z - a.z };
+		return UNormalize({ ab.y * ap.z - ab.z * ap.y, ab.z * ap.x - ab.x * ap.z, ab.x * ap.y - ab.y * ap.x });
+	}
+
+	// Distinct vertices of a triangle not yet in the meshlet being filled
+	size_t UNewVertices(const std::vector<uint8_t>& slots, const uint32_t* triangle)
+	{
+		size_t count = 0;
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			uint32_t v = triangle[corner];
+			if (slots[v] == NOT_IN_MESHLET && (corner < 1 || triangle[0] != v) && (corner < 2 || triangle[1] != v))
+				++count;
+		}
+		return count;
+	}
+
+	// Fits the sphere and normal cone of the triangles at indices, the meshlet's own
+	void UComputeBounds(MeshPack::Meshlet& meshlet, const uint32_t* indices, const uint8_t* vertices, size_t stride)
+	{
+		size_t triangleCount = meshlet.indexCount / 3;
+
+		// Sphere around the middle of the box of the vertices
+		Vector3 boundsMin = UPosition(vertices, stride, indices[0]);
+		Vector3 boundsMax = boundsMin;
+		for (uint32_t i = 1; i < meshlet.indexCount; ++i)
+		{
+			Vector3 p = UPosition(vertices, stride, indices[i]);
+			boundsMin = { std::min(boundsMin.x, p.x), std::min(boundsMin.y, p.y), std::min(boundsMin.z, p.z) };
+			boundsMax = { std::max(boundsMax.x, p.x), std::max(boundsMax.y, p.y), std::max(boundsMax.z, p.z) };
+		}
+		Vector3 center = { (boundsMin.x + boundsMax.x) * 0.5f, (boundsMin.y + boundsMax.y) * 0.5f, (boundsMin.z + boundsMax.z) * 0.5f };
+		float radius = 0.0f;
+		for (uint32_t i = 0; i < meshlet.indexCount; ++i)
+		{
+			Vector3 p = UPosition(vertices, stride, indices[i]);
+			radius = std::max(radius, ULength({ p.x - center.x, p.y - center.y, p.z - center.z }));
+		}
+
+		// The cone axis is the average of the triangle normals, and opens just wide enough
+		// for the one furthest from it
+		Vector3 normals[Meshlets::MAX_TRIANGLES];
+		Vector3 sum = { 0.0f, 0.0f, 0.0f };
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			normals[t] = UTriangleNormal(UPosition(vertices, stride, indices[t * 3]), UPosition(vertices, stride, indices[t * 3 + 1]),
+				UPosition(vertices, stride, indices[t * 3 + 2]));
+			sum = { sum.x + normals[t].x, sum.y + normals[t].y, sum.z + normals[t].z };
+		}
+		Vector3 axis = UNormalize(sum);
+
+		float minDot = 1.0f;
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			const Vector3& n = normals[t];
+			if (n.x != 0.0f || n.y != 0.0f || n.z != 0.0f)
+				minDot = std::min(minDot, n.x * axis.x + n.y * axis.y + n.z * axis.z);
+		}
+
+		memcpy(meshlet.center, &center, sizeof(meshlet.center));
+		meshlet.radius = radius;
+		memcpy(meshlet.coneAxis, &axis, sizeof(meshlet.coneAxis));
+		// Normals spread over a half space or more leave no side of the meshlet that is all
+		// back faces; a cutoff of 1 makes the facing test fail for any camera
+		meshlet.coneCutoff = ULength(sum) > 0.0f && minDot > 0.0f ? sqrtf(1.0f - minDot * minDot) : 1.0f;
+	}
+}
+
+namespace Meshlets
+{
+	void Build(std::vector<MeshPack::Meshlet>& meshlets, uint32_t* destination, const uint32_t* indices, size_t indexCount,
+		const void* vertices, size_t vertexCount, size_t stride)
+	{
+		static_assert(MAX_VERTICES < NOT_IN_MESHLET, "meshlet vertex slots must fit below the marker");
+
+		const uint8_t* data = (const uint8_t*)vertices;
+		size_t triangleCount = indexCount / 3;
+		meshlets.clear();
+
+		// Triangles of every vertex: those of vertex v are vertexTriangles[firstTriangle[v]] up to vertexTriangles[firstTriangle[v + 1]]
+		std::vector<uint32_t> firstTriangle(vertexCount + 1, 0);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+			++firstTriangle[indices[i] + 1];
+		for (size_t v = 0; v < vertexCount; ++v)
+			firstTriangle[v + 1] += firstTriangle[v];
+		std::vector<uint32_t> vertexTriangles(triangleCount * 3);
+		std::vector<uint32_t> filled(firstTriangle.begin(), firstTriangle.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+			vertexTriangles[filled[indices[i]]++] = (uint32_t)(i / 3);
+
+		// Centroid and unit normal of every triangle
+		std::vector<Vector3> centroids(triangleCount);
+		std::vector<Vector3> normals(triangleCount);
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			Vector3 a = UPosition(data, stride, indices[t * 3]);
+			Vector3 b = UPosition(data, stride, indices[t * 3 + 1]);
+			Vector3 p = UPosition(data, stride, indices[t * 3 + 2]);
+			centroids[t] = { (a.x + b.x + p.x) / 3.0f, (a.y + b.y + p.y) / 3.0f, (a.z + b.z + p.z) / 3.0f };
+			normals[t] = UTriangleNormal(a, b, p);
+		}
+
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<uint8_t> slots(vertexCount, NOT_IN_MESHLET);
+		uint32_t meshletVertices[MAX_VERTICES];
+		size_t meshletVertexCount = 0;
+		MeshPack::Meshlet current = {};
+		Vector3 centroidSum = { 0.0f, 0.0f, 0.0f };
+		Vector3 normalSum = { 0.0f, 0.0f, 0.0f };
+		size_t written = 0;
+		size_t nextSeed = 0;
+
+		for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+		{
+			// The next triangle is the one around the meshlet's vertices that adds the fewest
+			// new vertices, then the closest to its middle and the most in line with its normals
+			uint32_t best = NO_TRIANGLE;
+			size_t bestNew = 3;
+			float bestScore = FLT_MAX;
+			float inverseCount = current.indexCount > 0 ? 3.0f / (float)current.indexCount : 0.0f;
+			Vector3 middle = { centroidSum.x * inverseCount, centroidSum.y * inverseCount, centroidSum.z * inverseCount };
+			Vector3 axis = UNormalize(normalSum);
+			for (size_t v = 0; v < meshletVertexCount; ++v)
+			{
+				uint32_t vertex = meshletVertices[v];
+				for (uint32_t k = firstTriangle[vertex]; k < firstTriangle[vertex + 1]; ++k)
+				{
+					uint32_t t = vertexTriangles[k];
+					if (emitted[t])
+						continue;
+					size_t newVertices = UNewVertices(slots, indices + t * 3);
+					const Vector3& c = centroids[t];
+					float distance = ULength({ c.x - middle.x, c.y - middle.y, c.z - middle.z });
+					float spread = 1.0f - (normals[t].x * axis.x + normals[t].y * axis.y + normals[t].z * axis.z);
+					float score = distance * (1.0f + spread);
+					if (newVertices < bestNew || (newVertices == bestNew && score < bestScore))
+					{
+						best = t;
+						bestNew = newVertices;
+						bestScore = score;
+					}
+				}
+			}
+
+			// A full meshlet, or one with nothing left around it, is closed
+			if (best != NO_TRIANGLE && (meshletVertexCount + bestNew > MAX_VERTICES || current.indexCount / 3 == MAX_TRIANGLES))
+				best = NO_TRIANGLE;
+			if (best == NO_TRIANGLE && current.indexCount > 0)
+			{
+				UComputeBounds(current, destination + current.firstIndex, data, stride);
+				meshlets.push_back(current);
+				for (size_t v = 0; v < meshletVertexCount; ++v)
+					slots[meshletVertices[v]] = NOT_IN_MESHLET;
+				meshletVertexCount = 0;
+				current = {};
+				current.firstIndex = (uint32_t)written;
+				centroidSum = { 0.0f, 0.0f, 0.0f };
+				normalSum = { 0.0f, 0.0f, 0.0f };
+			}
+
+			// New meshlets start from the earliest triangle left in list order
+			if (best == NO_TRIANGLE)
+			{
+				while (emitted[nextSeed])
+					++nextSeed;
+				best = (uint32_t)nextSeed;
+			}
+
+			emitted[best] = true;
+			for (int corner = 0; corner < 3; ++corner)
+			{
+				uint32_t v = indices[best * 3 + corner];
+				if (slots[v] == NOT_IN_MESHLET)
+				{
+					slots[v] = (uint8_t)meshletVertexCount;
+					meshletVertices[meshletVertexCount++] = v;
+				}
+				destination[written++] = v;
+			}
+			current.indexCount += 3;
+			centroidSum = { centroidSum.x + centroids[best].x, centroidSum.y + centroids[best].y, centroidSum.z + centroids[best].z };
+			normalSum = { normalSum.x + normals[best].x, normalSum.y + normals[best].y, normalSum.z + normals[best].z };
+		}
+
+		if (current.indexCount > 0)
+		{
+			UComputeBounds(current, destination + current.firstIndex, data, stride);
+			meshlets.push_back(current);
+		}
+	}
+
+	bool IsBackFacing(const MeshPack::Meshlet& meshlet, const float viewPosition[3])
+	{
+		float toCenter[3];
+		for (int axis = 0; axis < 3; ++axis)
+			toCenter[axis] = meshlet.center[axis] - viewPosition[axis];
+		float distance = sqrtf(toCenter[0] * toCenter[0] + toCenter[1] * toCenter[1] + toCenter[2] * toCenter[2]);
+		float along = toCenter[0] * meshlet.coneAxis[0] + toCenter[1] * meshlet.coneAxis[1] + toCenter[2] * meshlet.coneAxis[2];
+		return along >= meshlet.coneCutoff * distance + meshlet.radius;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "meshpack.h"
+
+// Splits a triangle list into meshlets, small clusters of triangles over few
+// vertices, that can be culled on their own when only part of a dense mesh is
+// visible. A meshlet grows from a seed triangle by taking, of the triangles
+// around its vertices, the one adding the fewest vertices, then the closest and
+// most in line with the normals so far, until the next would take it past
+// MAX_VERTICES distinct vertices or MAX_TRIANGLES. Compact patches that face one
+// way cull best; a meshlet taking triangles in list order would follow the rings
+// of a sphere all the way round and never face away from the camera.
+//
+// Every meshlet gets a sphere around its vertices and a cone around the normals
+// of its triangles, so a meshlet can be skipped when
+//   the sphere is outside a frustum plane, or
+//   dot(center - camera, axis) >= cutoff * |center - camera| + radius,
+// where the camera sees every one of its triangles from behind. That test assumes
+// counter-clockwise front faces and closed meshes, where a back face is always
+// hidden behind a front face.
+namespace Meshlets
+{
+	const size_t MAX_VERTICES = 64;
+	const size_t MAX_TRIANGLES = 124;
+
+	// Replaces meshlets with those of a triangle list, and writes the list to destination
+	// regrouped by meshlet, one after the other; the meshlets' index ranges are into
+	// destination, which needs room for indexCount indices. Positions are three floats
+	// at the start of each vertex.
+	void Build(std::vector<MeshPack::Meshlet>& meshlets, uint32_t* destination, const uint32_t* indices, size_t indexCount,
+		const void* vertices, size_t vertexCount, size_t stride);
+
+	// Whether every triangle of the meshlet faces away from a camera at viewPosition,
+	// both in the space the meshlet was built in
+	bool IsBackFacing(const MeshPack::Meshlet& meshlet, const float viewPosition[3]);
+}
@@ -0,0 +1,523 @@
+#include "meshoptimize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+	const uint32_t NO_TRIANGLE = 0xFFFFFFFFu;
+
+	// Cache modelled by the vertex cache optimization; larger than the FIFO of real
+	// hardware, but its LRU scoring is what the method was tuned with
+	const int SCORE_CACHE_SIZE = 32;
+
+	// Cache simulated to split clusters for the overdraw pass
+	const int OVERDRAW_CACHE_SIZE = 16;
+
+	// Strips only take triangles this far ahead of the earliest one left in list order;
+	// following the mesh further makes longer strips but undoes the vertex cache order
+	const size_t STRIP_WINDOW = 16;
+
+	const size_t FETCH_LINE_SIZE = 64;
+	const int FETCH_CACHE_LINES = 256;  // 16 KB, about a shader core's L1
+
+	// Hashes and compares vertices of the source buffer by index
+	struct VertexHasher
+	{
+		const uint8_t* data;
+		size_t stride;
+
+		size_t operator()(uint32_t vertex) const
+		{
+			// FNV-1a
+			const uint8_t* bytes = data + vertex * stride;
+			uint64_t hash = 14695981039346656037ull;
+			for (size_t i = 0; i < stride; ++i)
+				hash = (hash ^ bytes[i]) * 1099511628211ull;
+			return (size_t)hash;
+		}
+	};
+
+	struct VertexEqual
+	{
+		const uint8_t* data;
+		size_t stride;
+
+		bool operator()(uint32_t a, uint32_t b) const
+		{
+			return memcmp(data + a * stride, data + b * stride, stride) == 0;
+		}
+	};
+
+	// Forsyth's vertex score: recently used vertices score high, except that the three of
+	// the last triangle score a little less to discourage strips that bounce back and
+	// forth; vertices with few triangles left score high so they get finished off
+	float UVertexScore(int cachePosition, uint32_t liveTriangles)
+	{
+		if (liveTriangles == 0)
+			return -1.0f;
+
+		float score = 0.0f;
+		if (cachePosition >= 0)
+		{
+			if (cachePosition < 3)
+				score = 0.75f;
+			else
+				score = powf(1.0f - (float)(cachePosition - 3) / (float)(SCORE_CACHE_SIZE - 3), 1.5f);
+		}
+		return score + 2.0f * powf((float)liveTriangles, -0.5f);
+	}
+
+	// FIFO cache simulated with insertion timestamps: a vertex is cached while fewer
+	// than cacheSize vertices were inserted after it. Returns the misses of a triangle.
+	int USimulateTriangle(const uint32_t* triangle, std::vector<uint32_t>& insertedAt, uint32_t& time, int cacheSize)
+	{
+		int misses = 0;
+		for (int k = 0; k < 3; ++k)
+		{
+			uint32_t vertex = triangle[k];
+			if (time - insertedAt[vertex] > (uint32_t)cacheSize)
+			{
+				insertedAt[vertex] = time++;
+				++misses;
+			}
+		}
+		return misses;
+	}
+
+	// Triangles of every vertex: those of vertex v are triangles[first[v]] up to triangles[first[v + 1]]
+	void UBuildVertexTriangles(const uint32_t* indices, size_t triangleCount, size_t vertexCount, std::vector<uint32_t>& first, std::vector<uint32_t>& triangles)
+	{
+		first.assign(vertexCount + 1, 0);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+			++first[indices[i] + 1];
+		for (size_t v = 0; v < vertexCount; ++v)
+			first[v + 1] += first[v];
+		triangles.resize(triangleCount * 3);
+		std::vector<uint32_t> filled(first.begin(), first.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+			triangles[filled[indices[i]]++] = (uint32_t)(i / 3);
+	}
+
+	struct Vector3
+	{
+		float x, y, z;
+	};
+
+	Vector3 UPosition(const uint8_t* vertices, size_t stride, uint32_t vertex)
+	{
+		Vector3 position;
+		memcpy(&position, vertices + vertex * stride, sizeof(position));
+		return position;
+	}
+}
+
+namespace MeshOptimize
+{
+	size_t IndexTriangleList(const void* vertices, size_t vertexCount, size_t stride, std::vector<uint32_t>& indices, std::vector<uint8_t>& uniqueVertices)
+	{
+		const uint8_t* data = (const uint8_t*)vertices;
+		size_t usedCount = vertexCount / 3 * 3; // a trailing partial triangle is never drawn
+
+		VertexHasher hasher = { data, stride };
+		VertexEqual equal = { data, stride };
+		std::unordered_map<uint32_t, uint32_t, VertexHasher, VertexEqual> firstOf(usedCount, hasher, equal);
+
+		indices.resize(usedCount);
+		uniqueVertices.clear();
+		uniqueVertices.reserve(usedCount * stride);
+		uint32_t uniqueCount = 0;
+		for (size_t v = 0; v < usedCount; ++v)
+		{
+			auto inserted = firstOf.emplace((uint32_t)v, uniqueCount);
+			if (inserted.second)
+			{
+				uniqueVertices.insert(uniqueVertices.end(), data + v * stride, data + (v + 1) * stride);
+				++uniqueCount;
+			}
+			indices[v] = inserted.first->second;
+		}
+		return uniqueCount;
+	}
+
+	void OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount)
+	{
+		size_t triangleCount = indexCount / 3;
+		if (triangleCount == 0)
+			return;
+		std::vector<uint32_t> source(indices, indices + triangleCount * 3);
+
+		// Triangles of every vertex; the first liveCount of each list are not emitted yet
+		std::vector<uint32_t> firstTriangle;
+		std::vector<uint32_t> adjacency;
+		UBuildVertexTriangles(source.data(), triangleCount, vertexCount, firstTriangle, adjacency);
+		std::vector<uint32_t> liveCount(vertexCount);
+		for (size_t v = 0; v < vertexCount; ++v)
+			liveCount[v] = firstTriangle[v + 1] - firstTriangle[v];
+
+		std::vector<int> cachePosition(vertexCount, -1);
+		std::vector<float> vertexScore(vertexCount);
+		for (size_t v = 0; v < vertexCount; ++v)
+			vertexScore[v] = UVertexScore(-1, liveCount[v]);
+
+		std::vector<float> triangleScore(triangleCount);
+		uint32_t best = NO_TRIANGLE;
+		float bestScore = -1.0f;
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			triangleScore[t] = vertexScore[source[t * 3]] + vertexScore[source[t * 3 + 1]] + vertexScore[source[t * 3 + 2]];
+			if (triangleScore[t] > bestScore)
+			{
+				bestScore = triangleScore[t];
+				best = (uint32_t)t;
+			}
+		}
+
+		std::vector<uint8_t> emitted(triangleCount, 0);
+		uint32_t cache[SCORE_CACHE_SIZE + 3];
+		int cacheCount = 0;
+		size_t cursor = 0;
+		for (size_t output = 0; output < triangleCount; ++output)
+		{
+			// Nothing in the cache has triangles left: continue with the next one in input order
+			if (best == NO_TRIANGLE)
+			{
+				while (emitted[cursor])
+					++cursor;
+				best = (uint32_t)cursor;
+			}
+
+			const uint32_t* triangle = &source[best * 3];
+			memcpy(indices + output * 3, triangle, sizeof(uint32_t) * 3);
+			emitted[best] = 1;
+
+			for (int k = 0; k < 3; ++k)
+			{
+				uint32_t vertex = triangle[k];
+				uint32_t* triangles = &adjacency[firstTriangle[vertex]];
+				uint32_t count = liveCount[vertex];
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					if (triangles[i] == best)
+					{
+						triangles[i] = triangles[count - 1];
+						triangles[count - 1] = best;
+						break;
+					}
+				}
+				--liveCount[vertex];
+			}
+
+			// The triangle's vertices move to the front, the rest shift back and the last fall out
+			uint32_t newCache[SCORE_CACHE_SIZE + 6];
+			int newCount = 0;
+			for (int k = 0; k < 3; ++k)
+				newCache[newCount++] = triangle[k];
+			for (int i = 0; i < cacheCount; ++i)
+			{
+				uint32_t vertex = cache[i];
+				if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+					newCache[newCount++] = vertex;
+			}
+
+			for (int i = 0; i < newCount; ++i)
+			{
+				uint32_t vertex = newCache[i];
+				cachePosition[vertex] = i < SCORE_CACHE_SIZE ? i : -1;
+				float score = UVertexScore(cachePosition[vertex], liveCount[vertex]);
+				float delta = score - vertexScore[vertex];
+				vertexScore[vertex] = score;
+				const uint32_t* triangles = &adjacency[firstTriangle[vertex]];
+				for (uint32_t j = 0; j < liveCount[vertex]; ++j)
+					triangleScore[triangles[j]] += delta;
+			}
+
+			// The next triangle is the best one touching the cache
+			cacheCount = std::min(newCount, SCORE_CACHE_SIZE);
+			memcpy(cache, newCache, sizeof(uint32_t) * cacheCount);
+			best = NO_TRIANGLE;
+			bestScore = -1.0f;
+			for (int i = 0; i < cacheCount; ++i)
+			{
+				uint32_t vertex = cache[i];
+				const uint32_t* triangles = &adjacency[firstTriangle[vertex]];
+				for (uint32_t j = 0; j < liveCount[vertex]; ++j)
+				{
+					if (triangleScore[triangles[j]] > bestScore)
+					{
+						bestScore = triangleScore[triangles[j]];
+						best = triangles[j];
+					}
+				}
+			}
+		}
+	}
+
+	// After Sander, Nehab and Barczak, "Fast Triangle Reordering for Vertex Locality and
+	// Reduced Overdraw": the cache-optimized order is cut into clusters wherever the cache
+	// starts over anyway, or where the miss ratio so far is within threshold of the
+	// cluster's, and the clusters are drawn in order of how far they face outward.
+	void OptimizeOverdraw(uint32_t* indices, size_t indexCount, const void* vertices, size_t vertexCount, size_t stride, float threshold)
+	{
+		size_t triangleCount = indexCount / 3;
+		if (triangleCount < 2)
+			return;
+		const uint8_t* data = (const uint8_t*)vertices;
+
+		// A time gap larger than the cache size empties the simulated cache
+		std::vector<uint32_t> insertedAt(vertexCount, 0);
+		uint32_t time = OVERDRAW_CACHE_SIZE + 1;
+
+		// Hard boundaries: triangles that miss on all three vertices
+		std::vector<uint32_t> hardStarts;
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			if (USimulateTriangle(indices + t * 3, insertedAt, time, OVERDRAW_CACHE_SIZE) == 3 || t == 0)
+				hardStarts.push_back((uint32_t)t);
+		}
+		hardStarts.push_back((uint32_t)triangleCount);
+
+		// Soft boundaries inside each hard cluster
+		std::vector<uint32_t> clusterStarts;
+		for (size_t h = 0; h + 1 < hardStarts.size(); ++h)
+		{
+			uint32_t start = hardStarts[h];
+			uint32_t end = hardStarts[h + 1];
+
+			time += OVERDRAW_CACHE_SIZE + 1;
+			int clusterMisses = 0;
+			for (uint32_t t = start; t < end; ++t)
+				clusterMisses += USimulateTriangle(indices + t * 3, insertedAt, time, OVERDRAW_CACHE_SIZE);
+			float targetRatio = threshold * (float)clusterMisses / (float)(end - start);
+
+			size_t firstOfCluster = clusterStarts.size();
+			clusterStarts.push_back(start);
+			time += OVERDRAW_CACHE_SIZE + 1;
+			int misses = 0;
+			int faces = 0;
+			for (uint32_t t = start; t < end; ++t)
+			{
+				misses += USimulateTriangle(indices + t * 3, insertedAt, time, OVERDRAW_CACHE_SIZE);
+				++faces;
+				if ((float)misses / (float)faces <= targetRatio && t + 1 < end)
+				{
+					clusterStarts.push_back(t + 1);
+					time += OVERDRAW_CACHE_SIZE + 1;
+					misses = 0;
+					faces = 0;
+				}
+			}
+
+			// The tail after the last split can miss more than the target; it joins the cluster before it
+			if (faces > 0 && clusterStarts.size() > firstOfCluster + 1)
+				clusterStarts.pop_back();
+		}
+		size_t clusterCount = clusterStarts.size();
+		clusterStarts.push_back((uint32_t)triangleCount);
+
+		// Area-weighted centroids and normals
+		std::vector<Vector3> centroids(clusterCount);
+		std::vector<Vector3> normals(clusterCount);
+		Vector3 meshCentroid = { 0.0f, 0.0f, 0.0f };
+		float meshArea = 0.0f;
+		for (size_t c = 0; c < clusterCount; ++c)
+		{
+			Vector3 centroid = { 0.0f, 0.0f, 0.0f };
+			Vector3 normal = { 0.0f, 0.0f, 0.0f };
+			float area = 0.0f;
+			for (uint32_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t)
+			{
+				Vector3 a = UPosition(data, stride, indices[t * 3]);
+				Vector3 b = UPosition(data, stride, indices[t * 3 + 1]);
+				Vector3 p = UPosition(data, stride, indices[t * 3 + 2]);
+				Vector3 ab = { b.x - a.x, b.y - a.y, b.z - a.z };
+				Vector3 ap = { p.x - a.x, p.y - a.y, p.z - a.z };
+				Vector3 cross = { ab.y * ap.z - ab.z * ap.y, ab.z * ap.x - ab.x * ap.z, ab.x * ap.y - ab.y * ap.x };
+				float triangleArea = sqrtf(cross.x * cross.x + cross.y * cross.y + cross.z * cross.z);
+
+				centroid.x += (a.x + b.x + p.x) / 3.0f * triangleArea;
+				centroid.y += (a.y + b.y + p.y) / 3.0f * triangleArea;
+				centroid.z += (a.z + b.z + p.z) / 3.0f * triangleArea;
+				normal.x += cross.x;
+				normal.y += cross.y;
+				normal.z += cross.z;
+				area += triangleArea;
+			}
+
+			meshCentroid.x += centroid.x;
+			meshCentroid.y += centroid.y;
+			meshCentroid.z += centroid.z;
+			meshArea += area;
+
+			float inverseArea = area > 0.0f ? 1.0f / area : 0.0f;
+			centroids[c] = { centroid.x * inverseArea, centroid.y * inverseArea, centroid.z * inverseArea };
+			float length = sqrtf(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+			float inverseLength = length > 0.0f ? 1.0f / length : 0.0f;
+			normals[c] = { normal.x * inverseLength, normal.y * inverseLength, normal.z * inverseLength };
+		}
+		float inverseMeshArea = meshArea > 0.0f ? 1.0f / meshArea : 0.0f;
+		meshCentroid = { meshCentroid.x * inverseMeshArea, meshCentroid.y * inverseMeshArea, meshCentroid.z * inverseMeshArea };
+
+		// Clusters further out along their own normal are more likely to hide the others
+		std::vector<float> sortKey(clusterCount);
+		std::vector<uint32_t> order(clusterCount);
+		for (size_t c = 0; c < clusterCount; ++c)
+		{
+			Vector3 offset = { centroids[c].x - meshCentroid.x, centroids[c].y - meshCentroid.y, centroids[c].z - meshCentroid.z };
+			sortKey[c] = offset.x * normals[c].x + offset.y * normals[c].y + offset.z * normals[c].z;
+			order[c] = (uint32_t)c;
+		}
+		std::stable_sort(order.begin(), order.end(), [&sortKey](uint32_t a, uint32_t b) { return sortKey[a] > sortKey[b]; });
+
+		std::vector<uint32_t> source(indices, indices + triangleCount * 3);
+		size_t output = 0;
+		for (size_t i = 0; i < clusterCount; ++i)
+		{
+			uint32_t cluster = order[i];
+			size_t count = (size_t)(clusterStarts[cluster + 1] - clusterStarts[cluster]) * 3;
+			memcpy(indices + output, &source[(size_t)clusterStarts[cluster] * 3], sizeof(uint32_t) * count);
+			output += count;
+		}
+	}
+
+	size_t OptimizeVertexFetch(void* vertices, uint32_t* indices, size_t indexCount, size_t vertexCount, size_t stride)
+	{
+		std::vector<uint32_t> remap(vertexCount, 0xFFFFFFFFu);
+		std::vector<uint8_t> source((const uint8_t*)vertices, (const uint8_t*)vertices + vertexCount * stride);
+		uint8_t* destination = (uint8_t*)vertices;
+		uint32_t next = 0;
+		for (size_t i = 0; i < indexCount; ++i)
+		{
+			uint32_t vertex = indices[i];
+			if (remap[vertex] == 0xFFFFFFFFu)
+			{
+				memcpy(destination + (size_t)next * stride, &source[vertex * stride], stride);
+				remap[vertex] = next++;
+			}
+			indices[i] = remap[vertex];
+		}
+		return next;
+	}
+
+	size_t Stripify(uint32_t* strip, const uint32_t* indices, size_t indexCount, size_t vertexCount)
+	{
+		size_t triangleCount = indexCount / 3;
+		std::vector<uint32_t> firstTriangle;
+		std::vector<uint32_t> adjacency;
+		UBuildVertexTriangles(indices, triangleCount, vertexCount, firstTriangle, adjacency);
+		std::vector<uint8_t> emitted(triangleCount, 0);
+		size_t cursor = 0;
+
+		// A triangle left with the edge from -> to in its winding; third is its other vertex
+		auto findNext = [&](uint32_t from, uint32_t to, uint32_t& third) -> uint32_t
+		{
+			for (uint32_t i = firstTriangle[from]; i < firstTriangle[from + 1]; ++i)
+			{
+				uint32_t triangle = adjacency[i];
+				if (emitted[triangle] || triangle >= cursor + STRIP_WINDOW)
+					continue;
+				const uint32_t* vertices = indices + triangle * 3;
+				for (int k = 0; k < 3; ++k)
+				{
+					if (vertices[k] == from && vertices[(k + 1) % 3] == to)
+					{
+						third = vertices[(k + 2) % 3];
+						return triangle;
+					}
+				}
+			}
+			return NO_TRIANGLE;
+		};
+
+		// Triangle n of a strip is drawn from strip[n], strip[n + 1] and strip[n + 2],
+		// with the first two swapped on odd n to keep the winding
+		size_t output = 0;
+		for (;;)
+		{
+			while (cursor < triangleCount && emitted[cursor])
+				++cursor;
+			if (cursor == triangleCount)
+				break;
+
+			// Start on the rotation whose second triangle, drawn c, b, x, exists
+			const uint32_t* start = indices + cursor * 3;
+			emitted[cursor] = 1;
+			int rotation = 0;
+			for (int r = 0; r < 3; ++r)
+			{
+				uint32_t third;
+				if (findNext(start[(r + 2) % 3], start[(r + 1) % 3], third) != NO_TRIANGLE)
+				{
+					rotation = r;
+					break;
+				}
+			}
+
+			if (output > 0)
+				strip[output++] = RESTART_INDEX;
+			strip[output++] = start[rotation];
+			strip[output++] = start[(rotation + 1) % 3];
+			strip[output++] = start[(rotation + 2) % 3];
+
+			uint32_t previous = start[(rotation + 1) % 3];
+			uint32_t last = start[(rotation + 2) % 3];
+			for (size_t n = 1;; ++n)
+			{
+				uint32_t third;
+				uint32_t next = (n & 1) ? findNext(last, previous, third) : findNext(previous, last, third);
+				if (next == NO_TRIANGLE)
+					break;
+				emitted[next] = 1;
+				strip[output++] = third;
+				previous = last;
+				last = third;
+			}
+		}
+		return output;
+	}
+
+	VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, int cacheSize)
+	{
+		VertexCacheStats stats = { 0.0f, 0.0f };
+		size_t triangleCount = indexCount / 3;
+		if (triangleCount == 0 || vertexCount == 0)
+			return stats;
+
+		std::vector<uint32_t> insertedAt(vertexCount, 0);
+		uint32_t time = (uint32_t)cacheSize + 1;
+		size_t transformed = 0;
+		for (size_t t = 0; t < triangleCount; ++t)
+			transformed += USimulateTriangle(indices + t * 3, insertedAt, time, cacheSize);
+
+		stats.acmr = (float)transformed / (float)triangleCount;
+		stats.atvr = (float)transformed / (float)vertexCount;
+		return stats;
+	}
+
+	float AnalyzeVertexFetch(const uint32_t* indices, size_t indexCount, size_t vertexCount, size_t stride)
+	{
+		size_t bufferBytes = vertexCount * stride;
+		if (bufferBytes == 0)
+			return 0.0f;
+
+		std::vector<uint32_t> insertedAt(bufferBytes / FETCH_LINE_SIZE + 1, 0);
+		uint32_t time = FETCH_CACHE_LINES + 1;
+		size_t fetched = 0;
+		for (size_t i = 0; i < indexCount; ++i)
+		{
+			size_t first = indices[i] * stride / FETCH_LINE_SIZE;
+			size_t last = (indices[i] * stride + stride - 1) / FETCH_LINE_SIZE;
+			for (size_t line = first; line <= last; ++line)
+			{
+				if (time - insertedAt[line] > (uint32_t)FETCH_CACHE_LINES)
+				{
+					insertedAt[line] = time++;
+					fetched += FETCH_LINE_SIZE;
+				}
+			}
+		}
+		return (float)fetched / (float)bufferBytes;
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Index and vertex order optimization for triangle lists, run on every mesh
+// before it is baked. The passes are meant to run in this order, on a list
+// MeshProcess::Weld has indexed:
+//   OptimizeVertexCache  reorders triangles for post-transform cache reuse
+//                        (Forsyth's linear-speed algorithm)
+//   OptimizeOverdraw     reorders clusters of those triangles so outward
+//                        facing ones come first, keeping most of the reuse
+//   OptimizeVertexFetch  reorders vertices in first-use order so fetches walk
+//                        the vertex buffer forward
+//   Stripify             rewrites the list as restart-separated strips
+// None of them change the rendered triangles, only their order.
+namespace MeshOptimize
+{
+	// Builds an index buffer for an unindexed triangle list, with vertices compared
+	// byte by byte. The distinct vertices are written to uniqueVertices in order
+	// of first appearance; returns their count. The bake welds with MeshProcess::Weld
+	// instead; this is kept as the baseline MeshProcess::RunBenchmark compares with.
+	size_t IndexTriangleList(const void* vertices, size_t vertexCount, size_t stride, std::vector<uint32_t>& indices, std::vector<uint8_t>& uniqueVertices);
+
+	void OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+	// Expects indices already optimized for the vertex cache. threshold is how much
+	// worse the cache miss ratio of a cluster may get to allow splitting it further,
+	// 1.05 allows 5%. Positions are three floats at the start of each vertex.
+	void OptimizeOverdraw(uint32_t* indices, size_t indexCount, const void* vertices, size_t vertexCount, size_t stride, float threshold);
+
+	// Restart index of GL_PRIMITIVE_RESTART_FIXED_INDEX for 32-bit indices
+	const uint32_t RESTART_INDEX = 0xFFFFFFFFu;
+
+	// Turns a triangle list into triangle strips separated by RESTART_INDEX, with the
+	// same triangles facing the same way. Strips start from the earliest triangle left
+	// in list order, so a cache-optimized order stays mostly intact. Returns the index
+	// count written to strip, which needs room for indexCount / 3 * 4 indices.
+	size_t Stripify(uint32_t* strip, const uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+	// Reorders vertices in place and drops unreferenced ones; returns the new vertex count
+	size_t OptimizeVertexFetch(void* vertices, uint32_t* indices, size_t indexCount, size_t vertexCount, size_t stride);
+
+	struct VertexCacheStats
+	{
+		float acmr;     // vertices transformed per triangle, 0.5 at best and 3 at worst
+		float atvr;     // vertices transformed per vertex, 1 at best
+	};
+
+	// Simulates a FIFO post-transform cache of cacheSize entries
+	VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, int cacheSize);
+
+	// Bytes fetched through a 16 KB cache of 64-byte lines over the size of the vertex
+	// buffer, 1 at best
+	float AnalyzeVertexFetch(const uint32_t* indices, size_t indexCount, size_t vertexCount, size_t stride);
+}
@@ -0,0 +1,290 @@
+#include "meshpack.h"
+
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	uint64_t UAlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	void UWritePadding(std::ofstream& file, uint64_t& position, uint64_t alignment)
+	{
+		static const char zeros[MeshPack::BLOB_ALIGNMENT] = {};
+		uint64_t aligned = UAlignUp(position, alignment);
+		file.write(zeros, (std::streamsize)(aligned - position));
+		position = aligned;
+	}
+
+	// The blob [offset, offset + bytes) lies inside the file and starts aligned
+	bool UIsBlobValid(uint64_t offset, uint64_t bytes, uint64_t fileSize)
+	{
+		if (bytes == 0)
+			return true;
+		return offset % MeshPack::BLOB_ALIGNMENT == 0 && offset <= fileSize && bytes <= fileSize - offset;
+	}
+}
+
+namespace MeshPack
+{
+	void Writer::Add(const MeshView& mesh)
+	{
+		mMeshes.push_back(mesh);
+	}
+
+	bool Writer::Write(const char* filename) const
+	{
+		// Lay the file out first so the records can be written before the blobs they point to
+		std::vector<MeshRecord> records(mMeshes.size());
+		uint64_t position = sizeof(FileHeader) + sizeof(MeshRecord) * records.size();
+		for (size_t i = 0; i < mMeshes.size(); ++i)
+		{
+			const MeshView& mesh = mMeshes[i];
+			MeshRecord& record = records[i];
+			memset(&record, 0, sizeof(record));
+			strncpy(record.name, mesh.name, MAX_NAME - 1);
+			record.format = mesh.format;
+			record.vertexCount = mesh.vertexCount;
+			record.indexCount = mesh.indexCount;
+			record.indexMode = mesh.indexMode;
+			record.vertexBytes = (uint64_t)mesh.vertexCount * mesh.format.stride;
+			record.indexBytes = (uint64_t)mesh.indexCount * sizeof(uint32_t);
+			position = UAlignUp(position, BLOB_ALIGNMENT);
+			record.vertexOffset = position;
+			position += record.vertexBytes;
+			if (record.indexBytes > 0)
+			{
+				position = UAlignUp(position, BLOB_ALIGNMENT);
+				record.indexOffset = position;
+				position += record.indexBytes;
+			}
+			memcpy(record.boundsMin, mesh.boundsMin, sizeof(record.boundsMin));
+			memcpy(record.boundsMax, mesh.boundsMax, sizeof(record.boundsMax));
+			record.lodCount = mesh.lodCount;
+			memcpy(record.lods, mesh.lods, sizeof(MeshLod) * mesh.lodCount);
+			record.meshletCount = mesh.meshletCount;
+			record.meshletBytes = (uint64_t)mesh.meshletCount * sizeof(Meshlet);
+			if (record.meshletBytes > 0)
+			{
+				position = UAlignUp(position, BLOB_ALIGNMENT);
+				record.meshletOffset = position;
+				position += record.meshletBytes;
+			}
+		}
+
+		FileHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.headerSize = sizeof(FileHeader) + sizeof(MeshRecord);
+		header.meshCount = (uint32_t)records.size();
+		header.fileSize = position;
+
+		std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return false;
+
+		file.write((const char*)&header, sizeof(header));
+		if (!records.empty())
+			file.write((const char*)records.data(), (std::streamsize)(sizeof(MeshRecord) * records.size()));
+		position = sizeof(FileHeader) + sizeof(MeshRecord) * records.size();
+		for (size_t i = 0; i < mMeshes.size(); ++i)
+		{
+			UWritePadding(file, position, BLOB_ALIGNMENT);
+			file.write((const char*)mMeshes[i].vertices, (std::streamsize)records[i].vertexBytes);
+			position += records[i].vertexBytes;
+			if (records[i].indexBytes > 0)
+			{
+				UWritePadding(file, position, BLOB_ALIGNMENT);
+				file.write((const char*)mMeshes[i].indices, (std::streamsize)records[i].indexBytes);
+				position += records[i].indexBytes;
+			}
+			if (records[i].meshletBytes > 0)
+			{
+				UWritePadding(file, position, BLOB_ALIGNMENT);
+				file.write((const char*)mMeshes[i].meshlets, (std::streamsize)records[i].meshletBytes);
+				position += records[i].meshletBytes;
+			}
+		}
+		return (bool)file;
+	}
+
+#ifdef _WIN32
+	MappedPack::MappedPack()
+		: mData(nullptr), mSize(0), mFile(INVALID_HANDLE_VALUE), mMapping(nullptr)
+	{
+	}
+#else
+	MappedPack::MappedPack()
+		: mData(nullptr), mSize(0), mFile(-1)
+	{
+	}
+#endif
+
+	MappedPack::~MappedPack()
+	{
+		Close();
+	}
+
+	bool MappedPack::Open(const char* filename)
+	{
+		Close();
+
+#ifdef _WIN32
+		mFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (mFile == INVALID_HANDLE_VALUE)
+			return false;
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(mFile, &size) || size.QuadPart < (LONGLONG)sizeof(FileHeader))
+		{
+			Close();
+			return false;
+		}
+		mMapping = CreateFileMappingA(mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (!mMapping)
+		{
+			Close();
+			return false;
+		}
+		mData = (const uint8_t*)MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+		mSize = (uint64_t)size.QuadPart;
+#else
+		mFile = open(filename, O_RDONLY);
+		if (mFile < 0)
+			return false;
+		struct stat status;
+		if (fstat(mFile, &status) != 0 || status.st_size < (off_t)sizeof(FileHeader))
+		{
+			Close();
+			return false;
+		}
+		void* data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, mFile, 0);
+		mData = data == MAP_FAILED ? nullptr : (const uint8_t*)data;
+		mSize = (uint64_t)status.st_size;
+		if (mData)
+			madvise(data, (size_t)mSize, MADV_WILLNEED);
+#endif
+
+		if (!mData || !Validate())
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	void MappedPack::Close()
+	{
+#ifdef _WIN32
+		if (mData)
+			UnmapViewOfFile(mData);
+		if (mMapping)
+			CloseHandle(mMapping);
+		if (mFile != INVALID_HANDLE_VALUE)
+			CloseHandle(mFile);
+		mMapping = nullptr;
+		mFile = INVALID_HANDLE_VALUE;
+#else
+		if (mData)
+			munmap((void*)mData, (size_t)mSize);
+		if (mFile >= 0)
+			close(mFile);
+		mFile = -1;
+#endif
+		mData = nullptr;
+		mSize = 0;
+	}
+
+	bool MappedPack::Validate() const
+	{
+		const FileHeader* header = (const FileHeader*)mData;
+		if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+			header->headerSize != sizeof(FileHeader) + sizeof(MeshRecord) || header->fileSize != mSize)
+			return false;
+		if (header->meshCount > (mSize - sizeof(FileHeader)) / sizeof(MeshRecord))
+			return false;
+
+		const MeshRecord* records = (const MeshRecord*)(mData + sizeof(FileHeader));
+		for (uint32_t i = 0; i < header->meshCount; ++i)
+		{
+			const MeshRecord& record = records[i];
+			const VertexFormat& format = record.format;
+			if (record.name[MAX_NAME - 1] != '\0' || format.attributeCount > (uint32_t)MAX_ATTRIBUTES)
+				return false;
+			if (record.vertexBytes != (uint64_t)record.vertexCount * format.stride || record.indexBytes != (uint64_t)record.indexCount * sizeof(uint32_t))
+				return false;
+			if (!UIsBlobValid(record.vertexOffset, record.vertexBytes, mSize) || !UIsBlobValid(record.indexOffset, record.indexBytes, mSize))
+				return false;
+			if (record.lodCount > (uint32_t)MAX_LODS)
+				return false;
+			for (uint32_t lod = 0; lod < record.lodCount; ++lod)
+			{
+				if (record.lods[lod].firstIndex > record.indexCount || record.lods[lod].indexCount > record.indexCount - record.lods[lod].firstIndex)
+					return false;
+			}
+			if (record.meshletBytes != (uint64_t)record.meshletCount * sizeof(Meshlet) || !UIsBlobValid(record.meshletOffset, record.meshletBytes, mSize))
+				return false;
+			const Meshlet* meshlets = (const Meshlet*)(mData + record.meshletOffset);
+			for (uint32_t m = 0; m < record.meshletCount; ++m)
+			{
+				if (meshlets[m].firstIndex > record.indexCount || meshlets[m].indexCount > record.indexCount - meshlets[m].firstIndex)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	int MappedPack::MeshCount() const
+	{
+		return mData ? (int)((const FileHeader*)mData)->meshCount : 0;
+	}
+
+	MeshView MappedPack::GetMesh(int index) const
+	{
+		const MeshRecord& record = ((const MeshRecord*)(mData + sizeof(FileHeader)))[index];
+		MeshView mesh;
+		mesh.name = record.name;
+		mesh.format = record.format;
+		mesh.vertices = mData + record.vertexOffset;
+		mesh.vertexCount = record.vertexCount;
+		mesh.indices = record.indexCount > 0 ? (const uint32_t*)(mData + record.indexOffset) : nullptr;
+		mesh.indexCount = record.indexCount;
+		mesh.indexMode = record.indexMode;
+		memcpy(mesh.boundsMin, record.boundsMin, sizeof(mesh.boundsMin));
+		memcpy(mesh.boundsMax, record.boundsMax, sizeof(mesh.boundsMax));
+		mesh.lodCount = record.lodCount;
+		memcpy(mesh.lods, record.lods, sizeof(mesh.lods));
+		mesh.meshlets = record.meshletCount > 0 ? (const Meshlet*)(mData + record.meshletOffset) : nullptr;
+		mesh.meshletCount = record.meshletCount;
+		return mesh;
+	}
+
+	bool MappedPack::Find(const char* name, MeshView& mesh) const
+	{
+		for (int i = 0; i < MeshCount(); ++i)
+		{
+			mesh = GetMesh(i);
+			if (strcmp(mesh.name, name) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	uint64_t MappedPack::Size() const
+	{
+		return mSize;
+	}
+}
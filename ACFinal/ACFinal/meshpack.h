@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Binary mesh pack. Meshes are generated once and baked to a single file that
+// later starts memory map instead of regenerating:
+//
+//   FileHeader
+//   MeshRecord[meshCount]
+//   vertex, index and meshlet blobs, each starting on a BLOB_ALIGNMENT boundary
+//
+// Offsets are from the start of the file and everything is stored in the
+// byte order of the machine that baked it (little endian on every target).
+// A blob is exactly what GL expects in a buffer, so a mapped pack's blobs are
+// copied straight from the mapping into GL buffers and nothing is parsed.
+namespace MeshPack
+{
+	const char MAGIC[4] = { 'A', 'C', 'M', 'P' };
+	const uint32_t VERSION = 6;
+	const uint32_t BLOB_ALIGNMENT = 64;
+	const int MAX_ATTRIBUTES = 4;
+	const int MAX_NAME = 32;
+	const int MAX_LODS = 4;
+
+	// One vertex attribute, as passed to glVertexAttribPointer
+	struct VertexAttribute
+	{
+		uint32_t location;
+		uint32_t components;
+		uint32_t type;          // GL_FLOAT, GL_SHORT, ...
+		uint32_t normalized;
+		uint32_t offset;        // bytes from the start of the vertex
+	};
+
+	struct VertexFormat
+	{
+		uint32_t stride;
+		uint32_t attributeCount;
+		VertexAttribute attributes[MAX_ATTRIBUTES];
+	};
+
+	// One level of detail: a range of the mesh's indices over the vertices all levels share
+	struct MeshLod
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		float error;            // object-space distance the level may be off the full mesh by
+	};
+
+	// A cluster of a mesh's triangles, culled on its own: a range of triangle list indices,
+	// with an object-space sphere around its vertices and a cone around its normals
+	struct Meshlet
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		float center[3];
+		float radius;
+		float coneAxis[3];
+		float coneCutoff;       // sine of the cone's half angle, 1 for meshlets never culled by facing
+	};
+
+	struct FileHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t headerSize;    // sizeof(FileHeader) + sizeof(MeshRecord), catches layout changes without a version bump
+		uint32_t meshCount;
+		uint64_t fileSize;
+	};
+
+	struct MeshRecord
+	{
+		char name[MAX_NAME];
+		VertexFormat format;
+		uint32_t vertexCount;
+		uint32_t indexCount;    // 32-bit indices, 0 for meshes drawn without
+		uint32_t indexMode;     // GL_TRIANGLES, or GL_TRIANGLE_STRIP with 0xFFFFFFFF between strips
+		uint64_t vertexOffset;
+		uint64_t vertexBytes;
+		uint64_t indexOffset;
+		uint64_t indexBytes;
+		float boundsMin[3];     // object-space box around the positions
+		float boundsMax[3];
+		uint32_t lodCount;      // 0 for meshes drawn without indices, level 0 is the full mesh
+		MeshLod lods[MAX_LODS];
+		uint32_t meshletCount;  // 0 for meshes too small to be worth culling in parts
+		uint64_t meshletOffset;
+		uint64_t meshletBytes;
+	};
+
+	// Geometry of one mesh. The data is owned by whoever made the view: a
+	// generator, or a mapped pack for as long as it stays open.
+	struct MeshView
+	{
+		const char* name;
+		VertexFormat format;
+		const void* vertices;
+		uint32_t vertexCount;
+		const uint32_t* indices;
+		uint32_t indexCount;
+		uint32_t indexMode;
+		float boundsMin[3];
+		float boundsMax[3];
+		uint32_t lodCount;
+		MeshLod lods[MAX_LODS];
+		const Meshlet* meshlets;    // ranges of GL_TRIANGLES indices whatever the index mode
+		uint32_t meshletCount;
+	};
+
+	// Collects meshes and writes them as one pack. The data of added views must
+	// stay valid until Write.
+	class Writer
+	{
+	public:
+		void Add(const MeshView& mesh);
+		bool Write(const char* filename) const;
+
+	private:
+		std::vector<MeshView> mMeshes;
+	};
+
+	// A pack mapped read-only into memory. Open checks that every record and
+	// blob lies inside the file, so a truncated or stale pack is rejected as a
+	// whole and the caller can fall back to generating.
+	class MappedPack
+	{
+	public:
+		MappedPack();
+		~MappedPack();
+
+		MappedPack(const MappedPack&) = delete;
+		MappedPack& operator=(const MappedPack&) = delete;
+
+		bool Open(const char* filename);
+		void Close();
+
+		int MeshCount() const;
+		MeshView GetMesh(int index) const;
+
+		// Looks a mesh up by name, returns false when the pack has none by that name
+		bool Find(const char* name, MeshView& mesh) const;
+
+		uint64_t Size() const;
+
+	private:
+		bool Validate() const;
+
+		const uint8_t* mData;
+		uint64_t mSize;
+#ifdef _WIN32
+		void* mFile;
+		void* mMapping;
+#else
+		int mFile;
+#endif
+	};
+}
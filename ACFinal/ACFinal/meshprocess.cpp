@@ -0,0 +1,430 @@
+#include "meshprocess.h"
+
+#include "meshoptimize.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+	const uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+	const float PI = 3.14159265358979f;
+
+	struct Vector3
+	{
+		float x, y, z;
+	};
+
+	Vector3 URead(const uint8_t* vertices, size_t stride, uint32_t vertex, size_t offset)
+	{
+		Vector3 v;
+		memcpy(&v, vertices + vertex * stride + offset, sizeof(v));
+		return v;
+	}
+
+	Vector3 USubtract(const Vector3& a, const Vector3& b)
+	{
+		return { a.x - b.x, a.y - b.y, a.z - b.z };
+	}
+
+	Vector3 UScale(const Vector3& v, float s)
+	{
+		return { v.x * s, v.y * s, v.z * s };
+	}
+
+	float UDot(const Vector3& a, const Vector3& b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	Vector3 UCross(const Vector3& a, const Vector3& b)
+	{
+		return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	}
+
+	// Zero for a zero vector
+	Vector3 UNormalize(const Vector3& v)
+	{
+		float length = sqrtf(UDot(v, v));
+		return UScale(v, length > 0.0f ? 1.0f / length : 0.0f);
+	}
+
+	// Angle between two unit vectors, clamped so rounding cannot leave acos's domain
+	float UAngle(const Vector3& a, const Vector3& b)
+	{
+		return acosf(std::max(-1.0f, std::min(1.0f, UDot(a, b))));
+	}
+
+	// What a float is compared by: the multiple of the tolerance it rounds to, or its
+	// bits with -0 turned into 0 when there is no tolerance
+	int64_t UComponentKey(float value, float inverseTolerance)
+	{
+		if (inverseTolerance > 0.0f)
+			return (int64_t)floor((double)value * inverseTolerance + 0.5);
+		uint32_t bits;
+		value += 0.0f;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	struct ComponentKeys
+	{
+		const uint8_t* data;
+		size_t stride;
+		size_t floatCount;
+		float inverseTolerance;
+
+		int64_t Key(uint32_t vertex, size_t component) const
+		{
+			float value;
+			memcpy(&value, data + vertex * stride + component * sizeof(float), sizeof(value));
+			return UComponentKey(value, inverseTolerance);
+		}
+
+		uint32_t Hash(uint32_t vertex) const
+		{
+			// FNV-1a over the keys, folded to 32 bits
+			uint64_t hash = 14695981039346656037ull;
+			for (size_t i = 0; i < floatCount; ++i)
+				hash = (hash ^ (uint64_t)Key(vertex, i)) * 1099511628211ull;
+			return (uint32_t)(hash ^ (hash >> 32));
+		}
+
+		bool Equal(uint32_t a, uint32_t b) const
+		{
+			for (size_t i = 0; i < floatCount; ++i)
+				if (Key(a, i) != Key(b, i))
+					return false;
+			return true;
+		}
+	};
+
+	// Writes to first the earliest vertex every vertex is equal to, itself for the first
+	// of a set. The table is open-addressed with linear probing and at most half full;
+	// slots keep the hash next to the vertex so most mismatches cost no key comparison.
+	void UFindDuplicates(const ComponentKeys& keys, size_t vertexCount, uint32_t* first)
+	{
+		size_t capacity = 16;
+		while (capacity < vertexCount * 2)
+			capacity *= 2;
+		const size_t mask = capacity - 1;
+
+		struct Slot
+		{
+			uint32_t vertex;
+			uint32_t hash;
+		};
+		std::vector<Slot> table(capacity, { EMPTY_SLOT, 0 });
+
+		for (uint32_t v = 0; v < (uint32_t)vertexCount; ++v)
+		{
+			uint32_t hash = keys.Hash(v);
+			size_t slot = hash & mask;
+			while (table[slot].vertex != EMPTY_SLOT && (table[slot].hash != hash || !keys.Equal(table[slot].vertex, v)))
+				slot = (slot + 1) & mask;
+			if (table[slot].vertex == EMPTY_SLOT)
+				table[slot] = { v, hash };
+			first[v] = table[slot].vertex;
+		}
+	}
+
+	// Any unit vector perpendicular to n, for tangents no triangle with a UV area gave a direction
+	Vector3 UPerpendicular(const Vector3& n)
+	{
+		Vector3 axis = fabsf(n.x) < 0.9f ? Vector3{ 1.0f, 0.0f, 0.0f } : Vector3{ 0.0f, 1.0f, 0.0f };
+		return UNormalize(USubtract(axis, UScale(n, UDot(n, axis))));
+	}
+
+	// Benchmark grid: a rippled square in the XZ plane, facing up, with UV following X and Z
+	const float RIPPLE_HEIGHT = 0.05f;
+	const float RIPPLE_FREQUENCY = 6.0f;
+	const size_t GRID_FLOATS = 8;
+	const size_t GRID_STRIDE = GRID_FLOATS * sizeof(float);
+	const size_t GRID_NORMAL_OFFSET = 3 * sizeof(float);
+	const size_t GRID_UV_OFFSET = 6 * sizeof(float);
+
+	float URippleHeight(float x, float z)
+	{
+		return RIPPLE_HEIGHT * sinf(RIPPLE_FREQUENCY * x) * cosf(RIPPLE_FREQUENCY * z);
+	}
+
+	// Derivatives of the height along x and z
+	void URippleSlope(float x, float z, float& dx, float& dz)
+	{
+		dx = RIPPLE_HEIGHT * RIPPLE_FREQUENCY * cosf(RIPPLE_FREQUENCY * x) * cosf(RIPPLE_FREQUENCY * z);
+		dz = -RIPPLE_HEIGHT * RIPPLE_FREQUENCY * sinf(RIPPLE_FREQUENCY * x) * sinf(RIPPLE_FREQUENCY * z);
+	}
+
+	// Unindexed, six vertices per quad with zeroed normals, the way a hand-written table
+	// or a triangle soup importer hands a mesh over
+	void UBuildGrid(size_t quads, std::vector<float>& vertices)
+	{
+		vertices.clear();
+		vertices.reserve(quads * quads * 6 * GRID_FLOATS);
+		const int CORNERS[6][2] = { { 0, 0 }, { 0, 1 }, { 1, 1 }, { 0, 0 }, { 1, 1 }, { 1, 0 } };
+		for (size_t row = 0; row < quads; ++row)
+		{
+			for (size_t column = 0; column < quads; ++column)
+			{
+				for (const int* corner : CORNERS)
+				{
+					float u = (float)(column + corner[0]) / (float)quads;
+					float v = (float)(row + corner[1]) / (float)quads;
+					float x = u * 2.0f - 1.0f;
+					float z = v * 2.0f - 1.0f;
+					const float vertex[GRID_FLOATS] = { x, URippleHeight(x, z), z, 0.0f, 0.0f, 0.0f, u, v };
+					vertices.insert(vertices.end(), vertex, vertex + GRID_FLOATS);
+				}
+			}
+		}
+	}
+
+	// Largest angle in degrees between the computed normals and tangents of the grid and
+	// those of the surface it samples
+	void UMeasureGridError(const std::vector<float>& vertices, const std::vector<float>& tangents, size_t vertexCount,
+		float& normalDegrees, float& tangentDegrees)
+	{
+		normalDegrees = 0.0f;
+		tangentDegrees = 0.0f;
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			const float* vertex = vertices.data() + v * GRID_FLOATS;
+			float dx, dz;
+			URippleSlope(vertex[0], vertex[2], dx, dz);
+			Vector3 normal = UNormalize({ -dx, 1.0f, -dz });
+			Vector3 tangent = UNormalize({ 1.0f, dx, 0.0f });
+			tangent = UNormalize(USubtract(tangent, UScale(normal, UDot(normal, tangent))));
+			normalDegrees = std::max(normalDegrees, UAngle(normal, UNormalize({ vertex[3], vertex[4], vertex[5] })) * 180.0f / PI);
+			const float* t = tangents.data() + v * 4;
+			tangentDegrees = std::max(tangentDegrees, UAngle(tangent, UNormalize({ t[0], t[1], t[2] })) * 180.0f / PI);
+		}
+	}
+
+	// Best of three runs in milliseconds; prepare resets the input outside the timing
+	template <typename Prepare, typename Run>
+	double UBestMs(Prepare prepare, Run run)
+	{
+		double best = 1.0e30;
+		for (int attempt = 0; attempt < 3; ++attempt)
+		{
+			prepare();
+			auto start = std::chrono::steady_clock::now();
+			run();
+			best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		}
+		return best;
+	}
+}
+
+namespace MeshProcess
+{
+	size_t Weld(void* vertices, uint32_t* indices, size_t indexCount, size_t vertexCount, size_t stride, float tolerance)
+	{
+		uint8_t* data = (uint8_t*)vertices;
+		ComponentKeys keys = { data, stride, stride / sizeof(float), tolerance > 0.0f ? 1.0f / tolerance : 0.0f };
+		std::vector<uint32_t> remap(vertexCount);
+		UFindDuplicates(keys, vertexCount, remap.data());
+
+		// The first of every set moves down to the next free place; its duplicates come
+		// later, so remap of their first is already its new index
+		size_t uniqueCount = 0;
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			if (remap[v] != v)
+			{
+				remap[v] = remap[remap[v]];
+				continue;
+			}
+			if (uniqueCount != v)
+				memcpy(data + uniqueCount * stride, data + v * stride, stride);
+			remap[v] = (uint32_t)uniqueCount++;
+		}
+
+		for (size_t i = 0; i < indexCount; ++i)
+			indices[i] = remap[indices[i]];
+		return uniqueCount;
+	}
+
+	void ComputeNormals(void* vertices, size_t vertexCount, size_t stride, size_t normalOffset, const uint32_t* indices, size_t indexCount,
+		NormalWeighting weighting, bool acrossSeams)
+	{
+		uint8_t* data = (uint8_t*)vertices;
+
+		// Sums go to the first vertex at every position, which all of them read back
+		std::vector<uint32_t> owner(vertexCount);
+		if (acrossSeams)
+			UFindDuplicates({ data, stride, 3, 0.0f }, vertexCount, owner.data());
+		else
+			std::iota(owner.begin(), owner.end(), 0u);
+
+		std::vector<Vector3> sums(vertexCount, { 0.0f, 0.0f, 0.0f });
+		for (size_t i = 0; i + 2 < indexCount; i += 3)
+		{
+			const uint32_t* triangle = indices + i;
+			Vector3 p[3];
+			for (int corner = 0; corner < 3; ++corner)
+				p[corner] = URead(data, stride, triangle[corner], 0);
+
+			// Twice the area times the unit normal
+			Vector3 cross = UCross(USubtract(p[1], p[0]), USubtract(p[2], p[0]));
+			if (cross.x == 0.0f && cross.y == 0.0f && cross.z == 0.0f)
+				continue;
+
+			Vector3 weighted[3] = { cross, cross, cross };
+			if (weighting == WEIGHT_ANGLE)
+			{
+				Vector3 normal = UNormalize(cross);
+				for (int corner = 0; corner < 3; ++corner)
+				{
+					Vector3 toNext = UNormalize(USubtract(p[(corner + 1) % 3], p[corner]));
+					Vector3 toPrevious = UNormalize(USubtract(p[(corner + 2) % 3], p[corner]));
+					weighted[corner] = UScale(normal, UAngle(toNext, toPrevious));
+				}
+			}
+
+			for (int corner = 0; corner < 3; ++corner)
+			{
+				Vector3& sum = sums[owner[triangle[corner]]];
+				sum = { sum.x + weighted[corner].x, sum.y + weighted[corner].y, sum.z + weighted[corner].z };
+			}
+		}
+
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			Vector3 normal = UNormalize(sums[owner[v]]);
+			if (normal.x != 0.0f || normal.y != 0.0f || normal.z != 0.0f)
+				memcpy(data + v * stride + normalOffset, &normal, sizeof(normal));
+		}
+	}
+
+	size_t ComputeTangents(float* tangents, const void* vertices, size_t vertexCount, size_t stride, size_t normalOffset, size_t uvOffset,
+		const uint32_t* indices, size_t indexCount)
+	{
+		const uint8_t* data = (const uint8_t*)vertices;
+
+		// Weighted directions of every vertex, kept apart by the handedness of the
+		// triangles they come from: [v * 2] for mirrored UVs, [v * 2 + 1] for the rest
+		struct TangentSum
+		{
+			Vector3 direction;
+			float weight;
+		};
+		std::vector<TangentSum> sums(vertexCount * 2, { { 0.0f, 0.0f, 0.0f }, 0.0f });
+
+		for (size_t i = 0; i + 2 < indexCount; i += 3)
+		{
+			const uint32_t* triangle = indices + i;
+			Vector3 p[3];
+			float uv[3][2];
+			for (int corner = 0; corner < 3; ++corner)
+			{
+				p[corner] = URead(data, stride, triangle[corner], 0);
+				memcpy(uv[corner], data + triangle[corner] * stride + uvOffset, sizeof(uv[corner]));
+			}
+
+			// The triangle's direction of increasing U, as MikkTSpace finds it: the
+			// combination of its edges along which V stays the same, flipped for mirrored UVs
+			Vector3 edge1 = USubtract(p[1], p[0]);
+			Vector3 edge2 = USubtract(p[2], p[0]);
+			float s1 = uv[1][0] - uv[0][0], t1 = uv[1][1] - uv[0][1];
+			float s2 = uv[2][0] - uv[0][0], t2 = uv[2][1] - uv[0][1];
+			float signedArea = s1 * t2 - s2 * t1;
+			if (signedArea == 0.0f)
+				continue;
+			Vector3 direction = UNormalize(USubtract(UScale(edge1, t2), UScale(edge2, t1)));
+			if (signedArea < 0.0f)
+				direction = UScale(direction, -1.0f);
+			int side = signedArea > 0.0f ? 1 : 0;
+
+			for (int corner = 0; corner < 3; ++corner)
+			{
+				// Everything is made perpendicular to the vertex normal first, tangent and
+				// edges alike, so the corner angle is the one seen along the normal
+				Vector3 normal = UNormalize(URead(data, stride, triangle[corner], normalOffset));
+				Vector3 tangent = UNormalize(USubtract(direction, UScale(normal, UDot(normal, direction))));
+				Vector3 toNext = USubtract(p[(corner + 1) % 3], p[corner]);
+				Vector3 toPrevious = USubtract(p[(corner + 2) % 3], p[corner]);
+				toNext = UNormalize(USubtract(toNext, UScale(normal, UDot(normal, toNext))));
+				toPrevious = UNormalize(USubtract(toPrevious, UScale(normal, UDot(normal, toPrevious))));
+				float angle = UAngle(toNext, toPrevious);
+
+				TangentSum& sum = sums[triangle[corner] * 2 + side];
+				sum.direction = { sum.direction.x + tangent.x * angle, sum.direction.y + tangent.y * angle, sum.direction.z + tangent.z * angle };
+				sum.weight += angle;
+			}
+		}
+
+		size_t splitCount = 0;
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			const TangentSum& mirrored = sums[v * 2];
+			const TangentSum& kept = sums[v * 2 + 1];
+			if (mirrored.weight > 0.0f && kept.weight > 0.0f)
+				++splitCount;
+			int side = kept.weight >= mirrored.weight ? 1 : 0;
+
+			Vector3 tangent = UNormalize(sums[v * 2 + side].direction);
+			if (tangent.x == 0.0f && tangent.y == 0.0f && tangent.z == 0.0f)
+				tangent = UPerpendicular(UNormalize(URead(data, stride, (uint32_t)v, normalOffset)));
+			tangents[v * 4] = tangent.x;
+			tangents[v * 4 + 1] = tangent.y;
+			tangents[v * 4 + 2] = tangent.z;
+			tangents[v * 4 + 3] = side == 1 ? 1.0f : -1.0f;
+		}
+		return splitCount;
+	}
+
+	void RunBenchmark()
+	{
+		// Quads per side of the grid, for about 10k, 100k and 1M triangles
+		const size_t SIZES[] = { 71, 224, 708 };
+
+		std::cout << "Mesh processing benchmark, unindexed rippled grids" << std::endl;
+		std::cout << "triangles   index list ms   weld ms  area normals ms  angle normals ms  tangents ms  normal error  tangent error" << std::endl;
+
+		for (size_t quads : SIZES)
+		{
+			std::vector<float> soup;
+			UBuildGrid(quads, soup);
+			const size_t soupCount = soup.size() / GRID_FLOATS;
+			const size_t triangleCount = soupCount / 3;
+
+			std::vector<uint32_t> indices;
+			std::vector<uint8_t> uniqueVertices;
+			double indexMs = UBestMs([&] { indices.clear(); uniqueVertices.clear(); },
+				[&] { MeshOptimize::IndexTriangleList(soup.data(), soupCount, GRID_STRIDE, indices, uniqueVertices); });
+
+			std::vector<float> vertices;
+			size_t vertexCount = 0;
+			double weldMs = UBestMs([&] { vertices = soup; indices.resize(soupCount); std::iota(indices.begin(), indices.end(), 0u); },
+				[&] { vertexCount = MeshProcess::Weld(vertices.data(), indices.data(), indices.size(), soupCount, GRID_STRIDE, 0.0f); });
+			vertices.resize(vertexCount * GRID_FLOATS);
+
+			double areaMs = UBestMs([] {}, [&] { MeshProcess::ComputeNormals(vertices.data(), vertexCount, GRID_STRIDE, GRID_NORMAL_OFFSET,
+				indices.data(), indices.size(), MeshProcess::WEIGHT_AREA, true); });
+			double angleMs = UBestMs([] {}, [&] { MeshProcess::ComputeNormals(vertices.data(), vertexCount, GRID_STRIDE, GRID_NORMAL_OFFSET,
+				indices.data(), indices.size(), MeshProcess::WEIGHT_ANGLE, true); });
+
+			std::vector<float> tangents(vertexCount * 4);
+			size_t splitCount = 0;
+			double tangentMs = UBestMs([] {}, [&] { splitCount = MeshProcess::ComputeTangents(tangents.data(), vertices.data(), vertexCount, GRID_STRIDE,
+				GRID_NORMAL_OFFSET, GRID_UV_OFFSET, indices.data(), indices.size()); });
+
+			float normalDegrees, tangentDegrees;
+			UMeasureGridError(vertices, tangents, vertexCount, normalDegrees, tangentDegrees);
+
+			char line[200];
+			snprintf(line, sizeof(line), "%9zu  %14.2f  %8.2f  %15.2f  %16.2f  %11.2f  %10.3f deg  %9.3f deg",
+				triangleCount, indexMs, weldMs, areaMs, angleMs, tangentMs, normalDegrees, tangentDegrees);
+			std::cout << line << std::endl;
+			if (vertexCount != (quads + 1) * (quads + 1) || splitCount != 0)
+				std::cout << "Failed to weld the grid: " << vertexCount << " vertices, " << splitCount << " with both handedness" << std::endl;
+		}
+	}
+}
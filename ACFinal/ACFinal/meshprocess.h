@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Vertex data cleanup for indexed triangle meshes of any origin, generated or
+// imported, run before the optimization passes of MeshOptimize:
+//   Weld             merges duplicate vertices, found through an open-addressing
+//                    hash of their components, and compacts the vertex buffer
+//   ComputeNormals   smooth vertex normals from the triangles around every
+//                    vertex, weighted by triangle area or by corner angle
+//   ComputeTangents  per-vertex tangents with the handedness of the UV mapping,
+//                    following the MikkTSpace conventions
+// Vertices are interleaved floats with the position first, as the VertexLayout
+// float layouts have them; other attributes are found by their byte offset.
+// Triangles face out of their counter-clockwise side.
+namespace MeshProcess
+{
+	// Merges vertices whose floats all round to the same multiple of tolerance, or that
+	// are equal when tolerance is 0 (with -0 and 0 the same), keeping the first of every
+	// set in place and rewriting indices to it. An unindexed list is welded by passing
+	// the indices 0 to vertexCount - 1. Returns the new vertex count.
+	size_t Weld(void* vertices, uint32_t* indices, size_t indexCount, size_t vertexCount, size_t stride, float tolerance);
+
+	enum NormalWeighting
+	{
+		// Larger triangles pull harder; cheap, and right for evenly tessellated surfaces
+		WEIGHT_AREA,
+		// Every triangle counts by its angle at the vertex, so the normal does not depend
+		// on how the faces around it happen to be split into triangles
+		WEIGHT_ANGLE
+	};
+
+	// Writes the normal of every vertex to normalOffset bytes into it. With acrossSeams
+	// set, vertices at the same position share one normal, which keeps shading smooth
+	// across UV seams; otherwise every vertex only sees its own triangles, and vertices
+	// split per face get flat normals. Vertices no triangle with an area touches keep
+	// the normal they had.
+	void ComputeNormals(void* vertices, size_t vertexCount, size_t stride, size_t normalOffset, const uint32_t* indices, size_t indexCount,
+		NormalWeighting weighting, bool acrossSeams);
+
+	// Writes four floats per vertex to tangents: the direction U increases in, made
+	// perpendicular to the vertex normal, and in w the sign of the bitangent, which
+	// is w * cross(normal, tangent). Corners are weighted by angle as in MikkTSpace,
+	// and triangles with mirrored UVs are kept apart from the rest. MikkTSpace splits
+	// a vertex whose triangles disagree on handedness; here the side with more weight
+	// wins, and the vertices that would split are counted in the return value, so a
+	// caller can tell whether its mesh needs them split.
+	size_t ComputeTangents(float* tangents, const void* vertices, size_t vertexCount, size_t stride, size_t normalOffset, size_t uvOffset,
+		const uint32_t* indices, size_t indexCount);
+
+	// Times welding, normals and tangents on grids of 10k to 1M triangles against the
+	// analytic surface, and MeshOptimize::IndexTriangleList for comparison; prints a table
+	void RunBenchmark();
+}
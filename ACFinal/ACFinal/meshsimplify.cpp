@@ -0,0 +1,331 @@
+#include "meshsimplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	struct Vector3
+	{
+		float x, y, z;
+	};
+
+	Vector3 USubtract(const Vector3& a, const Vector3& b)
+	{
+		return { a.x - b.x, a.y - b.y, a.z - b.z };
+	}
+
+	Vector3 UCross(const Vector3& a, const Vector3& b)
+	{
+		return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	}
+
+	float UDot(const Vector3& a, const Vector3& b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	// Sum of squared distances to a set of planes, weighted by the area of the
+	// triangles they came from; divided by the weight it is a mean squared distance
+	struct Quadric
+	{
+		double a2, b2, c2, ab, ac, bc, ad, bd, cd, d2;
+		double weight;
+	};
+
+	void UAddPlane(Quadric& q, double a, double b, double c, double d, double weight)
+	{
+		q.a2 += a * a * weight;
+		q.b2 += b * b * weight;
+		q.c2 += c * c * weight;
+		q.ab += a * b * weight;
+		q.ac += a * c * weight;
+		q.bc += b * c * weight;
+		q.ad += a * d * weight;
+		q.bd += b * d * weight;
+		q.cd += c * d * weight;
+		q.d2 += d * d * weight;
+		q.weight += weight;
+	}
+
+	void UAddQuadric(Quadric& q, const Quadric& other)
+	{
+		q.a2 += other.a2;
+		q.b2 += other.b2;
+		q.c2 += other.c2;
+		q.ab += other.ab;
+		q.ac += other.ac;
+		q.bc += other.bc;
+		q.ad += other.ad;
+		q.bd += other.bd;
+		q.cd += other.cd;
+		q.d2 += other.d2;
+		q.weight += other.weight;
+	}
+
+	double UEvaluate(const Quadric& q, const Vector3& p)
+	{
+		if (q.weight <= 0.0)
+			return 0.0;
+		double x = p.x, y = p.y, z = p.z;
+		double sum = q.a2 * x * x + q.b2 * y * y + q.c2 * z * z +
+			2.0 * (q.ab * x * y + q.ac * x * z + q.bc * y * z) +
+			2.0 * (q.ad * x + q.bd * y + q.cd * z) + q.d2;
+		return fabs(sum) / q.weight;
+	}
+
+	struct Collapse
+	{
+		uint32_t from;
+		uint32_t to;
+		double cost;    // mean squared distance after the collapse
+	};
+
+	// Triangles of every vertex, rebuilt after each pass of collapses
+	struct Adjacency
+	{
+		std::vector<uint32_t> first;        // vertexCount + 1 offsets into triangles
+		std::vector<uint32_t> triangles;
+
+		void Build(const std::vector<uint32_t>& indices, size_t vertexCount)
+		{
+			first.assign(vertexCount + 1, 0);
+			for (size_t i = 0; i < indices.size(); ++i)
+				++first[indices[i] + 1];
+			for (size_t v = 0; v < vertexCount; ++v)
+				first[v + 1] += first[v];
+			triangles.resize(indices.size());
+			std::vector<uint32_t> filled(first.begin(), first.end() - 1);
+			for (size_t i = 0; i < indices.size(); ++i)
+				triangles[filled[indices[i]]++] = (uint32_t)(i / 3);
+		}
+	};
+
+	// Vertices sharing a triangle with vertex, other than exclude, sorted
+	void UNeighbours(uint32_t vertex, uint32_t exclude, const std::vector<uint32_t>& indices, const Adjacency& adjacency, std::vector<uint32_t>& neighbours)
+	{
+		neighbours.clear();
+		for (uint32_t i = adjacency.first[vertex]; i < adjacency.first[vertex + 1]; ++i)
+		{
+			const uint32_t* triangle = &indices[adjacency.triangles[i] * 3];
+			for (int k = 0; k < 3; ++k)
+			{
+				if (triangle[k] != vertex && triangle[k] != exclude)
+					neighbours.push_back(triangle[k]);
+			}
+		}
+		std::sort(neighbours.begin(), neighbours.end());
+		neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+	}
+
+	// Collapsing an edge is only safe when its ends share no neighbours other than
+	// the two across the edge; more means the mesh would fold onto itself
+	bool UKeepsManifold(const Collapse& collapse, const std::vector<uint32_t>& indices, const Adjacency& adjacency,
+		std::vector<uint32_t>& fromNeighbours, std::vector<uint32_t>& toNeighbours)
+	{
+		UNeighbours(collapse.from, collapse.to, indices, adjacency, fromNeighbours);
+		UNeighbours(collapse.to, collapse.from, indices, adjacency, toNeighbours);
+		size_t shared = 0;
+		for (uint32_t vertex : fromNeighbours)
+		{
+			if (std::binary_search(toNeighbours.begin(), toNeighbours.end(), vertex))
+				++shared;
+		}
+		return shared <= 2;
+	}
+
+	// A triangle that stays after the collapse must not turn over
+	bool UFlips(const Collapse& collapse, const std::vector<uint32_t>& indices, const Adjacency& adjacency, const std::vector<Vector3>& positions)
+	{
+		for (uint32_t i = adjacency.first[collapse.from]; i < adjacency.first[collapse.from + 1]; ++i)
+		{
+			const uint32_t* triangle = &indices[adjacency.triangles[i] * 3];
+			if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+				continue;
+
+			Vector3 before[3];
+			Vector3 after[3];
+			for (int k = 0; k < 3; ++k)
+			{
+				before[k] = positions[triangle[k]];
+				after[k] = triangle[k] == collapse.from ? positions[collapse.to] : before[k];
+			}
+			Vector3 normalBefore = UCross(USubtract(before[1], before[0]), USubtract(before[2], before[0]));
+			Vector3 normalAfter = UCross(USubtract(after[1], after[0]), USubtract(after[2], after[0]));
+			if (UDot(normalBefore, normalAfter) <= 0.0f)
+				return true;
+		}
+		return false;
+	}
+
+	uint64_t UEdgeKey(uint32_t from, uint32_t to)
+	{
+		return ((uint64_t)from << 32) | to;
+	}
+
+	struct PositionHasher
+	{
+		const std::vector<Vector3>* positions;
+
+		size_t operator()(uint32_t vertex) const
+		{
+			uint32_t bits[3];
+			memcpy(bits, &(*positions)[vertex], sizeof(bits));
+			return (size_t)(bits[0] * 73856093u ^ bits[1] * 19349663u ^ bits[2] * 83492791u);
+		}
+	};
+
+	struct PositionEqual
+	{
+		const std::vector<Vector3>* positions;
+
+		bool operator()(uint32_t a, uint32_t b) const
+		{
+			return memcmp(&(*positions)[a], &(*positions)[b], sizeof(Vector3)) == 0;
+		}
+	};
+}
+
+namespace MeshSimplify
+{
+	size_t Simplify(uint32_t* destination, const uint32_t* indices, size_t indexCount, const void* vertices, size_t vertexCount, size_t stride,
+		size_t targetIndexCount, float targetError, float& error)
+	{
+		error = 0.0f;
+		std::vector<uint32_t> result(indices, indices + indexCount / 3 * 3);
+
+		std::vector<Vector3> positions(vertexCount);
+		for (size_t v = 0; v < vertexCount; ++v)
+			memcpy(&positions[v], (const uint8_t*)vertices + v * stride, sizeof(Vector3));
+
+		// Seams: vertices that share their position with another one
+		std::vector<uint8_t> locked(vertexCount, 0);
+		PositionHasher hasher = { &positions };
+		PositionEqual equal = { &positions };
+		std::unordered_map<uint32_t, uint32_t, PositionHasher, PositionEqual> firstAt(vertexCount, hasher, equal);
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			auto inserted = firstAt.emplace((uint32_t)v, (uint32_t)v);
+			if (!inserted.second)
+				locked[v] = locked[inserted.first->second] = 1;
+		}
+
+		// Borders: edges no other triangle runs along the other way
+		std::unordered_set<uint64_t> edges(result.size());
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			for (int k = 0; k < 3; ++k)
+				edges.insert(UEdgeKey(result[i + k], result[i + (k + 1) % 3]));
+		}
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				uint32_t a = result[i + k];
+				uint32_t b = result[i + (k + 1) % 3];
+				if (edges.find(UEdgeKey(b, a)) == edges.end())
+					locked[a] = locked[b] = 1;
+			}
+		}
+
+		std::vector<Quadric> quadrics(vertexCount);
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			const Vector3& p0 = positions[result[i]];
+			Vector3 normal = UCross(USubtract(positions[result[i + 1]], p0), USubtract(positions[result[i + 2]], p0));
+			double length = sqrt((double)UDot(normal, normal));
+			if (length <= 0.0)
+				continue;
+			double a = normal.x / length, b = normal.y / length, c = normal.z / length;
+			double d = -(a * p0.x + b * p0.y + c * p0.z);
+			for (int k = 0; k < 3; ++k)
+				UAddPlane(quadrics[result[i + k]], a, b, c, d, length * 0.5);
+		}
+
+		const double errorLimit = (double)targetError * targetError;
+		double largestCost = 0.0;
+		Adjacency adjacency;
+		std::vector<Collapse> collapses;
+		std::vector<uint32_t> remap(vertexCount);
+		std::vector<uint8_t> touched(vertexCount);
+		std::vector<uint32_t> fromNeighbours;
+		std::vector<uint32_t> toNeighbours;
+		while (result.size() > targetIndexCount)
+		{
+			adjacency.Build(result, vertexCount);
+
+			collapses.clear();
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				for (int k = 0; k < 3; ++k)
+				{
+					uint32_t a = result[i + k];
+					uint32_t b = result[i + (k + 1) % 3];
+					for (int direction = 0; direction < 2; ++direction)
+					{
+						Collapse collapse = { direction ? b : a, direction ? a : b, 0.0 };
+						if (locked[collapse.from])
+							continue;
+						Quadric combined = quadrics[collapse.from];
+						UAddQuadric(combined, quadrics[collapse.to]);
+						collapse.cost = UEvaluate(combined, positions[collapse.to]);
+						collapses.push_back(collapse);
+					}
+				}
+			}
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+			// Cheapest first. A collapse changes the triangles around from, so no other
+			// collapse in the same pass may touch from or its neighbours.
+			for (size_t v = 0; v < vertexCount; ++v)
+				remap[v] = (uint32_t)v;
+			std::fill(touched.begin(), touched.end(), (uint8_t)0);
+			size_t removable = (result.size() - targetIndexCount) / 3;
+			size_t removed = 0;
+			for (const Collapse& collapse : collapses)
+			{
+				if (collapse.cost > errorLimit || removed >= removable)
+					break;
+				if (touched[collapse.from] || touched[collapse.to])
+					continue;
+				if (!UKeepsManifold(collapse, result, adjacency, fromNeighbours, toNeighbours) || UFlips(collapse, result, adjacency, positions))
+					continue;
+
+				remap[collapse.from] = collapse.to;
+				UAddQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+				largestCost = std::max(largestCost, collapse.cost);
+				for (uint32_t i = adjacency.first[collapse.from]; i < adjacency.first[collapse.from + 1]; ++i)
+				{
+					const uint32_t* triangle = &result[adjacency.triangles[i] * 3];
+					touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = 1;
+				}
+				removed += 2; // an interior edge has a triangle on each side
+			}
+			if (removed == 0)
+				break;
+
+			// Triangles that lost their collapsed edge are gone
+			size_t kept = 0;
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				uint32_t a = remap[result[i]];
+				uint32_t b = remap[result[i + 1]];
+				uint32_t c = remap[result[i + 2]];
+				if (a == b || b == c || c == a)
+					continue;
+				result[kept++] = a;
+				result[kept++] = b;
+				result[kept++] = c;
+			}
+			result.resize(kept);
+		}
+
+		memcpy(destination, result.data(), sizeof(uint32_t) * result.size());
+		error = (float)sqrt(largestCost);
+		return result.size();
+	}
+}
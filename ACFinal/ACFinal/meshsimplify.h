@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Quadric error simplification for level-of-detail chains (Garland and Heckbert,
+// "Surface Simplification Using Quadric Error Metrics"). Edges are collapsed
+// onto one of their two vertices, so a simplified index list still indexes the
+// original vertex buffer and every level of a mesh can share it. Vertices on
+// open borders and on attribute seams, where several vertices share a
+// position, never move, which keeps silhouettes and UV seams intact.
+namespace MeshSimplify
+{
+	// Writes a simplified copy of an indexed triangle list to destination, which
+	// must hold indexCount indices. Positions are three floats at the start of each
+	// vertex. Returns the index count written.
+	//
+	// The error of a collapse is the root mean square distance from the vertex it
+	// keeps to the planes of the original triangles merged into that vertex, weighted
+	// by their area, in the units of the positions. Simplification stops at
+	// targetIndexCount indices or when the next collapse would have an error above
+	// targetError, whichever comes first, and error is set to the largest error of the
+	// collapses made. It estimates how far the surface moved but does not bound it: a
+	// point can move further than the average over the planes, and points between
+	// vertices are not measured at all.
+	size_t Simplify(uint32_t* destination, const uint32_t* indices, size_t indexCount, const void* vertices, size_t vertexCount, size_t stride,
+		size_t targetIndexCount, float targetError, float& error);
+}
@@ -0,0 +1,207 @@
+#include "primitives.h"
+
+#include <cmath>
+
+namespace
+{
+	const float TWO_PI = 6.28318530718f;
+	const float HALF_PI = 1.57079632679f;
+
+	// Counts what it is given and writes it where there is memory to; without any
+	// it only measures, so sizes always agree with what is generated
+	struct MeshWriter
+	{
+		float* vertices;
+		uint32_t* indices;
+		uint32_t baseVertex;
+		uint32_t vertexCount;
+		uint32_t indexCount;
+
+		uint32_t Vertex(float x, float y, float z, float nx, float ny, float nz, float u, float v)
+		{
+			if (vertices)
+			{
+				float* out = vertices + (size_t)vertexCount * Primitives::FLOATS_PER_VERTEX;
+				out[0] = x;
+				out[1] = y;
+				out[2] = z;
+				out[3] = nx;
+				out[4] = ny;
+				out[5] = nz;
+				out[6] = u;
+				out[7] = v;
+			}
+			return vertexCount++;
+		}
+
+		void Triangle(uint32_t a, uint32_t b, uint32_t c)
+		{
+			if (indices)
+			{
+				indices[indexCount] = baseVertex + a;
+				indices[indexCount + 1] = baseVertex + b;
+				indices[indexCount + 2] = baseVertex + c;
+			}
+			indexCount += 3;
+		}
+	};
+
+	// One ring of a surface of revolution, with the normal given in the plane of the axis
+	struct ProfileRing
+	{
+		float radius;
+		float y;
+		float normalRadial;
+		float normalY;
+		float v;
+	};
+
+	// Sweeps the rings ringAt(0) up to ringAt(ringCount - 1) around the axis. Every ring
+	// gets a seam vertex at both ends so U runs from 0 to 1; quads next to a ring of
+	// radius 0 lose their degenerate half.
+	template <typename RingAt>
+	void ULathe(MeshWriter& writer, int ringCount, int radialSegments, RingAt ringAt)
+	{
+		uint32_t first = writer.vertexCount;
+		for (int ring = 0; ring < ringCount; ++ring)
+		{
+			ProfileRing profile = ringAt(ring);
+			for (int i = 0; i <= radialSegments; ++i)
+			{
+				float u = (float)i / (float)radialSegments;
+				float c = cosf(u * TWO_PI);
+				float s = -sinf(u * TWO_PI);
+				writer.Vertex(c * profile.radius, profile.y, s * profile.radius, c * profile.normalRadial, profile.normalY, s * profile.normalRadial, u, profile.v);
+			}
+		}
+
+		uint32_t columns = (uint32_t)radialSegments + 1;
+		for (int ring = 0; ring + 1 < ringCount; ++ring)
+		{
+			for (int i = 0; i < radialSegments; ++i)
+			{
+				uint32_t b0 = first + ring * columns + i;
+				uint32_t b1 = b0 + 1;
+				uint32_t t0 = b0 + columns;
+				uint32_t t1 = t0 + 1;
+				if (ringAt(ring).radius > 0.0f)
+					writer.Triangle(b0, b1, t1);
+				if (ringAt(ring + 1).radius > 0.0f)
+					writer.Triangle(b0, t1, t0);
+			}
+		}
+	}
+
+	// A flat disc facing up or down, UVs mapped straight down onto it
+	void UCap(MeshWriter& writer, float radius, float y, bool facingUp, int radialSegments)
+	{
+		float normalY = facingUp ? 1.0f : -1.0f;
+		uint32_t center = writer.Vertex(0.0f, y, 0.0f, 0.0f, normalY, 0.0f, 0.5f, 0.5f);
+		for (int i = 0; i < radialSegments; ++i)
+		{
+			float angle = (float)i / (float)radialSegments * TWO_PI;
+			float c = cosf(angle);
+			float s = -sinf(angle);
+			writer.Vertex(c * radius, y, s * radius, 0.0f, normalY, 0.0f, 0.5f + 0.5f * c, 0.5f - 0.5f * s);
+		}
+
+		for (int i = 0; i < radialSegments; ++i)
+		{
+			uint32_t a = center + 1 + i;
+			uint32_t b = center + 1 + (i + 1) % radialSegments;
+			if (facingUp)
+				writer.Triangle(center, a, b);
+			else
+				writer.Triangle(center, b, a);
+		}
+	}
+
+	void UWriteCylinder(MeshWriter& writer, const Primitives::Cylinder& cylinder)
+	{
+		// The side normal tilts by how much the radius shrinks over the height
+		float slope = cylinder.bottomRadius - cylinder.topRadius;
+		float length = sqrtf(cylinder.height * cylinder.height + slope * slope);
+		float normalRadial = length > 0.0f ? cylinder.height / length : 1.0f;
+		float normalY = length > 0.0f ? slope / length : 0.0f;
+
+		ULathe(writer, cylinder.heightSegments + 1, cylinder.radialSegments, [&](int ring)
+		{
+			float t = (float)ring / (float)cylinder.heightSegments;
+			ProfileRing profile = { cylinder.bottomRadius + (cylinder.topRadius - cylinder.bottomRadius) * t, cylinder.height * t, normalRadial, normalY, t };
+			return profile;
+		});
+
+		if (cylinder.bottomCap && cylinder.bottomRadius > 0.0f)
+			UCap(writer, cylinder.bottomRadius, 0.0f, false, cylinder.radialSegments);
+		if (cylinder.topCap && cylinder.topRadius > 0.0f)
+			UCap(writer, cylinder.topRadius, cylinder.height, true, cylinder.radialSegments);
+	}
+
+	void UWriteCapsule(MeshWriter& writer, const Primitives::Capsule& capsule)
+	{
+		// Rings from the bottom pole to the equator, along the cylinder, then on to the top pole
+		float radius = capsule.radius;
+		float totalHeight = 2.0f * radius + capsule.height;
+		int capSegments = capsule.capSegments;
+		int ringCount = 2 * capSegments + capsule.heightSegments + 1;
+		ULathe(writer, ringCount, capsule.radialSegments, [&](int ring)
+		{
+			float normalRadial = 1.0f;
+			float normalY = 0.0f;
+			float y;
+			if (ring <= capSegments)
+			{
+				float angle = HALF_PI * (float)(ring - capSegments) / (float)capSegments;
+				normalRadial = cosf(angle);
+				normalY = sinf(angle);
+				y = radius + radius * normalY;
+			}
+			else if (ring < capSegments + capsule.heightSegments)
+			{
+				y = radius + capsule.height * (float)(ring - capSegments) / (float)capsule.heightSegments;
+			}
+			else
+			{
+				float angle = HALF_PI * (float)(ring - capSegments - capsule.heightSegments) / (float)capSegments;
+				normalRadial = cosf(angle);
+				normalY = sinf(angle);
+				y = radius + capsule.height + radius * normalY;
+			}
+
+			// The poles are exactly on the axis
+			if (ring == 0 || ring == ringCount - 1)
+				normalRadial = 0.0f;
+			ProfileRing profile = { radius * normalRadial, y, normalRadial, normalY, totalHeight > 0.0f ? y / totalHeight : 0.0f };
+			return profile;
+		});
+	}
+}
+
+namespace Primitives
+{
+	MeshSize CylinderSize(const Cylinder& cylinder)
+	{
+		MeshWriter writer = { nullptr, nullptr, 0, 0, 0 };
+		UWriteCylinder(writer, cylinder);
+		return { writer.vertexCount, writer.indexCount };
+	}
+
+	void GenerateCylinder(const Cylinder& cylinder, float* vertices, uint32_t* indices, uint32_t baseVertex)
+	{
+		MeshWriter writer = { vertices, indices, baseVertex, 0, 0 };
+		UWriteCylinder(writer, cylinder);
+	}
+
+	MeshSize CapsuleSize(const Capsule& capsule)
+	{
+		MeshWriter writer = { nullptr, nullptr, 0, 0, 0 };
+		UWriteCapsule(writer, capsule);
+		return { writer.vertexCount, writer.indexCount };
+	}
+
+	void GenerateCapsule(const Capsule& capsule, float* vertices, uint32_t* indices, uint32_t baseVertex)
+	{
+		MeshWriter writer = { vertices, indices, baseVertex, 0, 0 };
+		UWriteCapsule(writer, capsule);
+	}
+}
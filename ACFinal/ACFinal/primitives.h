@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+// Parametric solids of revolution around +y, standing on y = 0: cylinders,
+// cones and frustums, and capsules. Vertices are interleaved position, normal
+// and UV floats, the layout the mesh generators use, with the triangles
+// indexed and wound counter-clockwise seen from outside.
+//
+// Nothing is allocated: the caller asks for the size, then passes memory of
+// its own to write into, such as a slice of a shared buffer or a mapped GL
+// buffer. Indices are offset by baseVertex so a mesh can sit after others
+// in the same vertex buffer.
+namespace Primitives
+{
+	const int FLOATS_PER_VERTEX = 8;
+
+	struct MeshSize
+	{
+		uint32_t vertexCount;
+		uint32_t indexCount;
+	};
+
+	// A cone has a top radius of 0; a cap on a radius of 0 is left out
+	struct Cylinder
+	{
+		float bottomRadius;
+		float topRadius;
+		float height;
+		int radialSegments;     // at least 3
+		int heightSegments;     // at least 1
+		bool bottomCap;
+		bool topCap;
+	};
+
+	// A cylinder of height between two hemispheres, 2 * radius + height tall
+	struct Capsule
+	{
+		float radius;
+		float height;
+		int radialSegments;     // at least 3
+		int capSegments;        // rings of each hemisphere, at least 1
+		int heightSegments;     // 0 when height is 0, which makes a sphere
+	};
+
+	MeshSize CylinderSize(const Cylinder& cylinder);
+	void GenerateCylinder(const Cylinder& cylinder, float* vertices, uint32_t* indices, uint32_t baseVertex);
+
+	MeshSize CapsuleSize(const Capsule& capsule);
+	void GenerateCapsule(const Capsule& capsule, float* vertices, uint32_t* indices, uint32_t baseVertex);
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Unit primitives generated entirely at compile time. Each generator is a
+// constexpr function templated on its resolution and vertex format, returning
+// fixed-size std::array tables; bound to a constexpr variable they are baked
+// into the read-only data of the executable, so no trigonometry or allocation
+// happens at startup and the arrays can be handed to GL as they are.
+//
+// The trigonometry is a Taylor series evaluated in double, which the compiler
+// can run where std::sin and std::cos are not yet constexpr. Only one sine and
+// cosine per ring is computed; every vertex combines them.
+namespace PrimitiveTables
+{
+	// Vertex formats, laid out as the interleaved floats the mesh generators use
+	struct PositionVertex
+	{
+		static constexpr int FLOATS_PER_POSITION = 3;
+		static constexpr int FLOATS_PER_NORMAL = 0;
+		static constexpr int FLOATS_PER_UV = 0;
+
+		float position[3];
+	};
+
+	struct SurfaceVertex
+	{
+		static constexpr int FLOATS_PER_POSITION = 3;
+		static constexpr int FLOATS_PER_NORMAL = 3;
+		static constexpr int FLOATS_PER_UV = 2;
+
+		float position[3];
+		float normal[3];
+		float uv[2];
+	};
+
+	static_assert(sizeof(PositionVertex) == 3 * sizeof(float), "vertex formats must be tightly packed floats");
+	static_assert(sizeof(SurfaceVertex) == 8 * sizeof(float), "vertex formats must be tightly packed floats");
+
+	template <typename Vertex, size_t VertexCount, size_t IndexCount>
+	struct Table
+	{
+		std::array<Vertex, VertexCount> vertices;
+		std::array<uint32_t, IndexCount> indices;
+	};
+
+	namespace Detail
+	{
+		constexpr double PI = 3.14159265358979323846;
+
+		constexpr double USin(double x)
+		{
+			while (x > PI)
+				x -= 2.0 * PI;
+			while (x < -PI)
+				x += 2.0 * PI;
+
+			// Within [-pi, pi] the terms past x^29 are below double precision
+			double term = x;
+			double sum = x;
+			for (int n = 1; n < 15; ++n)
+			{
+				term *= -x * x / (double)((2 * n) * (2 * n + 1));
+				sum += term;
+			}
+			return sum;
+		}
+
+		constexpr double UCos(double x)
+		{
+			return USin(x + 0.5 * PI);
+		}
+
+		// Sine and cosine of Count even steps around a full turn, plus the end of
+		// the turn again so the vertices on both sides of a seam match exactly
+		template <int Count>
+		struct Turn
+		{
+			double sine[Count + 1];
+			double cosine[Count + 1];
+
+			constexpr Turn() : sine(), cosine()
+			{
+				for (int i = 0; i < Count; ++i)
+				{
+					double angle = 2.0 * PI * (double)i / (double)Count;
+					sine[i] = USin(angle);
+					cosine[i] = UCos(angle);
+				}
+				sine[Count] = sine[0];
+				cosine[Count] = cosine[0];
+			}
+		};
+
+		// Fills in whatever the vertex format has room for
+		template <typename Vertex>
+		constexpr Vertex UMakeVertex(double x, double y, double z, double nx, double ny, double nz, double u, double v)
+		{
+			Vertex vertex = {};
+			vertex.position[0] = (float)x;
+			vertex.position[1] = (float)y;
+			vertex.position[2] = (float)z;
+			if constexpr (Vertex::FLOATS_PER_NORMAL > 0)
+			{
+				vertex.normal[0] = (float)nx;
+				vertex.normal[1] = (float)ny;
+				vertex.normal[2] = (float)nz;
+			}
+			if constexpr (Vertex::FLOATS_PER_UV > 0)
+			{
+				vertex.uv[0] = (float)u;
+				vertex.uv[1] = (float)v;
+			}
+			return vertex;
+		}
+	}
+
+	template <int Slices, int Stacks>
+	constexpr size_t SPHERE_VERTEX_COUNT = (size_t)(Slices + 1) * (Stacks + 1);
+	template <int Slices, int Stacks>
+	constexpr size_t SPHERE_INDEX_COUNT = (size_t)Slices * (Stacks - 1) * 6;
+
+	// A UV sphere around the origin with its poles on y. Slices run around y,
+	// stacks from the bottom pole to the top; both ends of every ring have a
+	// vertex so U runs from 0 to 1 across the seam, and the triangles touching
+	// a pole are single rather than degenerate quads.
+	template <int Slices, int Stacks, typename Vertex>
+	constexpr Table<Vertex, SPHERE_VERTEX_COUNT<Slices, Stacks>, SPHERE_INDEX_COUNT<Slices, Stacks>> MakeSphere(double radius)
+	{
+		static_assert(Slices >= 3 && Stacks >= 2, "a sphere needs at least 3 slices and 2 stacks");
+
+		Table<Vertex, SPHERE_VERTEX_COUNT<Slices, Stacks>, SPHERE_INDEX_COUNT<Slices, Stacks>> table = {};
+		const Detail::Turn<Slices> around;
+
+		size_t vertex = 0;
+		for (int stack = 0; stack <= Stacks; ++stack)
+		{
+			// The poles are exactly on the axis
+			double latitude = Detail::PI * ((double)stack / Stacks - 0.5);
+			double ringRadius = stack == 0 || stack == Stacks ? 0.0 : Detail::UCos(latitude);
+			double y = stack == 0 ? -1.0 : stack == Stacks ? 1.0 : Detail::USin(latitude);
+			for (int slice = 0; slice <= Slices; ++slice)
+			{
+				double nx = around.cosine[slice] * ringRadius;
+				double nz = -around.sine[slice] * ringRadius;
+				table.vertices[vertex++] = Detail::UMakeVertex<Vertex>(nx * radius, y * radius, nz * radius, nx, y, nz,
+					(double)slice / Slices, (double)stack / Stacks);
+			}
+		}
+
+		size_t index = 0;
+		const uint32_t columns = Slices + 1;
+		for (int stack = 0; stack < Stacks; ++stack)
+		{
+			for (int slice = 0; slice < Slices; ++slice)
+			{
+				uint32_t b0 = stack * columns + slice;
+				uint32_t b1 = b0 + 1;
+				uint32_t t0 = b0 + columns;
+				uint32_t t1 = t0 + 1;
+				if (stack > 0)
+				{
+					table.indices[index++] = b0;
+					table.indices[index++] = b1;
+					table.indices[index++] = t1;
+				}
+				if (stack + 1 < Stacks)
+				{
+					table.indices[index++] = b0;
+					table.indices[index++] = t1;
+					table.indices[index++] = t0;
+				}
+			}
+		}
+		return table;
+	}
+
+	template <int MainSegments, int TubeSegments>
+	constexpr size_t TORUS_VERTEX_COUNT = (size_t)(MainSegments + 1) * (TubeSegments + 1);
+	template <int MainSegments, int TubeSegments>
+	constexpr size_t TORUS_INDEX_COUNT = (size_t)MainSegments * TubeSegments * 6;
+
+	// A torus around the z axis: a tube of tubeRadius swept along a circle of
+	// mainRadius in the xy plane. U follows the main circle and V goes around
+	// the tube, with seam vertices at the ends of both.
+	template <int MainSegments, int TubeSegments, typename Vertex>
+	constexpr Table<Vertex, TORUS_VERTEX_COUNT<MainSegments, TubeSegments>, TORUS_INDEX_COUNT<MainSegments, TubeSegments>> MakeTorus(double mainRadius, double tubeRadius)
+	{
+		static_assert(MainSegments >= 3 && TubeSegments >= 3, "a torus needs at least 3 segments each way");
+
+		Table<Vertex, TORUS_VERTEX_COUNT<MainSegments, TubeSegments>, TORUS_INDEX_COUNT<MainSegments, TubeSegments>> table = {};
+		const Detail::Turn<MainSegments> main;
+		const Detail::Turn<TubeSegments> tube;
+
+		size_t vertex = 0;
+		for (int i = 0; i <= MainSegments; ++i)
+		{
+			for (int j = 0; j <= TubeSegments; ++j)
+			{
+				// The normal points from the center of the tube, out along its cross section
+				double nx = tube.cosine[j] * main.cosine[i];
+				double ny = tube.cosine[j] * main.sine[i];
+				double nz = tube.sine[j];
+				table.vertices[vertex++] = Detail::UMakeVertex<Vertex>(mainRadius * main.cosine[i] + tubeRadius * nx, mainRadius * main.sine[i] + tubeRadius * ny, tubeRadius * nz,
+					nx, ny, nz, (double)i / MainSegments, (double)j / TubeSegments);
+			}
+		}
+
+		size_t index = 0;
+		const uint32_t columns = TubeSegments + 1;
+		for (int i = 0; i < MainSegments; ++i)
+		{
+			for (int j = 0; j < TubeSegments; ++j)
+			{
+				uint32_t a = i * columns + j;
+				uint32_t b = a + columns;
+				table.indices[index++] = a;
+				table.indices[index++] = b;
+				table.indices[index++] = b + 1;
+				table.indices[index++] = a;
+				table.indices[index++] = b + 1;
+				table.indices[index++] = a + 1;
+			}
+		}
+		return table;
+	}
+}
@@ -0,0 +1,159 @@
+#include "scenegraph.h"
+
+#include <utility>
+
+const SceneGraph::NodeId SceneGraph::ROOT;
+
+SceneGraph::SceneGraph()
+	: mSorted(true)
+{
+	mParentSlot.push_back(-1);
+	mLocal.PushBack(Transform());
+	mLocalMatrix.push_back(glm::mat4(1.0f));
+	mWorld.push_back(glm::mat4(1.0f));
+	mDirty.push_back(0);
+	mNodeOfSlot.push_back(ROOT);
+	mSlotOfNode.push_back(0);
+}
+
+SceneGraph::NodeId SceneGraph::AddNode(NodeId parent, const Transform& local)
+{
+	NodeId node = (NodeId)mSlotOfNode.size();
+	int slot = (int)mNodeOfSlot.size();
+
+	// Appending keeps the order breadth-first only if no node deeper than the new one exists yet
+	int parentSlot = mSlotOfNode[parent];
+	if (slot > 0)
+	{
+		int lastParentSlot = mParentSlot[slot - 1];
+		if (parentSlot < lastParentSlot)
+			mSorted = false;
+	}
+
+	mParentSlot.push_back(parentSlot);
+	mLocal.PushBack(local);
+	mLocalMatrix.push_back(glm::mat4(1.0f));
+	mWorld.push_back(glm::mat4(1.0f));
+	mDirty.push_back(1);
+	mNodeOfSlot.push_back(node);
+	mSlotOfNode.push_back(slot);
+	return node;
+}
+
+void SceneGraph::SetLocal(NodeId node, const Transform& local)
+{
+	int slot = mSlotOfNode[node];
+	mLocal.Set(slot, local);
+	mDirty[slot] = 1;
+}
+
+Transform SceneGraph::GetLocal(NodeId node) const
+{
+	return mLocal.Get(mSlotOfNode[node]);
+}
+
+const glm::mat4& SceneGraph::GetWorld(NodeId node) const
+{
+	return mWorld[mSlotOfNode[node]];
+}
+
+int SceneGraph::Update()
+{
+	if (!mSorted)
+		SortBreadthFirst();
+
+	// Parents come first, so a dirty flag reaches the whole subtree in the same pass
+	int updated = 0;
+	int count = (int)mNodeOfSlot.size();
+	for (int slot = 1; slot < count; ++slot)
+	{
+		if (mDirty[mParentSlot[slot]])
+			mDirty[slot] = 1;
+		updated += mDirty[slot];
+	}
+	if (updated == 0)
+		return 0;
+
+	// Batching pays off once a good part of the graph changed, otherwise only
+	// the changed nodes are composed one at a time
+	bool batched = updated * 4 >= count;
+	if (batched)
+		Transforms::ComposeMatrices(mLocal, 1, count, mLocalMatrix.data());
+
+	for (int slot = 1; slot < count; ++slot)
+	{
+		if (!mDirty[slot])
+			continue;
+		if (!batched)
+			Transforms::ComposeMatrices(mLocal, slot, slot + 1, mLocalMatrix.data(), Transforms::PATH_SCALAR);
+		mWorld[slot] = mWorld[mParentSlot[slot]] * mLocalMatrix[slot];
+	}
+
+	// Flags are cleared in a second pass since children read their parent's flag above
+	for (int slot = 0; slot < count; ++slot)
+		mDirty[slot] = 0;
+
+	return updated;
+}
+
+int SceneGraph::NodeCount() const
+{
+	return (int)mNodeOfSlot.size();
+}
+
+void SceneGraph::SortBreadthFirst()
+{
+	int count = (int)mNodeOfSlot.size();
+
+	// Children of every slot, in the order they were added
+	std::vector<int> firstChild(count, -1);
+	std::vector<int> nextSibling(count, -1);
+	std::vector<int> lastChild(count, -1);
+	for (int slot = 1; slot < count; ++slot)
+	{
+		int parent = mParentSlot[slot];
+		if (lastChild[parent] < 0)
+			firstChild[parent] = slot;
+		else
+			nextSibling[lastChild[parent]] = slot;
+		lastChild[parent] = slot;
+	}
+
+	// Breadth-first walk from the root gives the new slot order
+	std::vector<int> order;
+	order.reserve(count);
+	order.push_back(0);
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		for (int child = firstChild[order[i]]; child >= 0; child = nextSibling[child])
+			order.push_back(child);
+	}
+
+	std::vector<int> newSlot(count);
+	for (int i = 0; i < count; ++i)
+		newSlot[order[i]] = i;
+
+	std::vector<int> parentSlot(count);
+	Transforms::TransformSoA local;
+	local.Resize(count);
+	std::vector<glm::mat4> world(count);
+	std::vector<uint8_t> dirty(count);
+	std::vector<NodeId> nodeOfSlot(count);
+	for (int i = 0; i < count; ++i)
+	{
+		int oldSlot = order[i];
+		parentSlot[i] = mParentSlot[oldSlot] < 0 ? -1 : newSlot[mParentSlot[oldSlot]];
+		local.Set(i, mLocal.Get(oldSlot));
+		world[i] = mWorld[oldSlot];
+		dirty[i] = mDirty[oldSlot];
+		nodeOfSlot[i] = mNodeOfSlot[oldSlot];
+		mSlotOfNode[nodeOfSlot[i]] = i;
+	}
+
+	mParentSlot.swap(parentSlot);
+	std::swap(mLocal, local);
+	mWorld.swap(world);
+	mDirty.swap(dirty);
+	mNodeOfSlot.swap(nodeOfSlot);
+	mSorted = true;
+}
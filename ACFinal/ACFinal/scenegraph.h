@@ -0,0 +1,53 @@
+#pragma once
+
+#include "transforms.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Node hierarchy with cached world matrices. Nodes are kept in breadth-first
+// order in parallel arrays, so every parent comes before its children and one
+// linear pass in Update brings all world matrices up to date. Only nodes
+// whose local transform changed, and their descendants, are recomputed.
+// When many nodes changed, local matrices are composed in SIMD batches first.
+// Node ids stay valid when nodes are reordered.
+class SceneGraph
+{
+public:
+	typedef int NodeId;
+	static const NodeId ROOT = 0;
+
+	SceneGraph();
+
+	// Adds a child of parent; a node with children can be moved as a unit through its own transform
+	NodeId AddNode(NodeId parent, const Transform& local);
+
+	void SetLocal(NodeId node, const Transform& local);
+	Transform GetLocal(NodeId node) const;
+
+	// World matrix as of the last Update
+	const glm::mat4& GetWorld(NodeId node) const;
+
+	// Recomputes the world matrices of changed subtrees, returns the number of nodes recomputed
+	int Update();
+
+	int NodeCount() const;
+
+private:
+	void SortBreadthFirst();
+
+	// Indexed by slot, in breadth-first order
+	std::vector<int> mParentSlot;       // -1 for the root
+	Transforms::TransformSoA mLocal;
+	std::vector<glm::mat4> mLocalMatrix;
+	std::vector<glm::mat4> mWorld;
+	std::vector<uint8_t> mDirty;
+	std::vector<NodeId> mNodeOfSlot;
+
+	// Indexed by node id
+	std::vector<int> mSlotOfNode;
+
+	bool mSorted;
+};
@@ -0,0 +1,103 @@
+#include "streambuffer.h"
+#include "glcounters.h"
+#include "glresources.h"
+
+#include <iostream>
+
+StreamBuffer::StreamBuffer()
+	: mBuffer(0), mMapped(nullptr), mRegionSize(0), mAlignment(256), mRegion(0), mOffset(0), mStalls(0)
+{
+	for (int i = 0; i < REGION_COUNT; ++i)
+		mFences[i] = 0;
+}
+
+bool StreamBuffer::Create(GLsizeiptr regionSize, const char* owner)
+{
+	// Bindings of both block types must start on these boundaries
+	GLint uniformAlignment = 256;
+	GLint storageAlignment = 256;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+	mAlignment = uniformAlignment > storageAlignment ? uniformAlignment : storageAlignment;
+
+	mRegionSize = (regionSize + mAlignment - 1) / mAlignment * mAlignment;
+	GLsizeiptr totalSize = mRegionSize * REGION_COUNT;
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	mBuffer = GLResources::CreateBuffer(GL_UNIFORM_BUFFER, totalSize, nullptr, flags, owner);
+	mMapped = (char*)GLResources::MapBuffer(mBuffer, 0, totalSize, flags);
+	if (!mMapped)
+	{
+		std::cout << "Failed to map stream buffer of " << totalSize << " bytes" << std::endl;
+		GLResources::DestroyBuffer(mBuffer);
+		return false;
+	}
+
+	// Starts on the last region so the first BeginFrame lands on region 0
+	mRegion = REGION_COUNT - 1;
+	mOffset = 0;
+	return true;
+}
+
+void StreamBuffer::Destroy()
+{
+	for (int i = 0; i < REGION_COUNT; ++i)
+	{
+		if (mFences[i])
+			glDeleteSync(mFences[i]);
+		mFences[i] = 0;
+	}
+	// A persistent mapping is released together with the buffer
+	GLResources::DestroyBuffer(mBuffer);
+	mMapped = nullptr;
+}
+
+void StreamBuffer::BeginFrame()
+{
+	mRegion = (mRegion + 1) % REGION_COUNT;
+	mOffset = 0;
+
+	GLsync fence = mFences[mRegion];
+	if (!fence)
+		return;
+
+	// Polled first so only real waits count as stalls; the blocking wait flushes so the fence reaches the GPU
+	GLenum result = glClientWaitSync(fence, 0, 0);
+	if (result == GL_TIMEOUT_EXPIRED)
+	{
+		++mStalls;
+		do
+		{
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+		} while (result == GL_TIMEOUT_EXPIRED);
+	}
+	glDeleteSync(fence);
+	mFences[mRegion] = 0;
+}
+
+void* StreamBuffer::Allocate(GLsizeiptr size, GLintptr& offset)
+{
+	GLintptr aligned = (mOffset + mAlignment - 1) / mAlignment * mAlignment;
+	if (aligned + size > mRegionSize)
+		return nullptr;
+
+	mOffset = aligned + size;
+	offset = mRegion * mRegionSize + aligned;
+	return mMapped + offset;
+}
+
+void StreamBuffer::EndFrame()
+{
+	mFences[mRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	GLCounters::AddStreamBytes((uint64_t)mOffset);
+}
+
+GLuint StreamBuffer::Buffer() const
+{
+	return mBuffer;
+}
+
+int StreamBuffer::StallCount() const
+{
+	return mStalls;
+}
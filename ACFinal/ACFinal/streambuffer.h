@@ -0,0 +1,52 @@
+#pragma once
+
+#include <GL/glew.h>
+
+// Ring of per-frame regions in one persistently mapped buffer. The CPU writes
+// uniform and storage block contents straight into the mapping; there is no
+// glBufferSubData and no copy in the driver. Each region is fenced when the
+// frame that filled it has been submitted, and BeginFrame waits on that fence
+// before the region is written again, so with three regions the CPU can run
+// up to two frames ahead of the GPU without overwriting data in use.
+//
+// All calls must be made on the thread that owns the GL context.
+class StreamBuffer
+{
+public:
+	static const int REGION_COUNT = 3;
+
+	StreamBuffer();
+
+	StreamBuffer(const StreamBuffer&) = delete;
+	StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+	// Creates the buffer with REGION_COUNT regions of regionSize bytes each
+	bool Create(GLsizeiptr regionSize, const char* owner);
+	void Destroy();
+
+	// Moves to the next region, waiting for the GPU to finish with it if needed
+	void BeginFrame();
+
+	// Space for size bytes in the current region, aligned for uniform and storage
+	// block bindings; returns nullptr when the region is full
+	void* Allocate(GLsizeiptr size, GLintptr& offset);
+
+	// Fences the current region after the draws that read it were submitted, and
+	// reports the bytes allocated from it to GLCounters as streamed bytes
+	void EndFrame();
+
+	GLuint Buffer() const;
+
+	// Frames BeginFrame had to wait on the GPU for, since creation
+	int StallCount() const;
+
+private:
+	GLuint mBuffer;
+	char* mMapped;
+	GLsizeiptr mRegionSize;
+	GLintptr mAlignment;
+	int mRegion;
+	GLintptr mOffset;  // within the current region
+	GLsync mFences[REGION_COUNT];
+	int mStalls;
+};
@@ -0,0 +1,203 @@
+#include "trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+	// Number of events each thread keeps before the oldest are overwritten (power of two)
+	const uint64_t RING_SIZE = 1 << 16;
+
+	struct TraceEvent
+	{
+		const char* name;
+		const char* detail;
+		uint64_t timestamp; // nanoseconds since the trace clock started
+		char phase;         // 'B' or 'E'
+	};
+
+	// Single-producer ring owned by one thread; the exporter only reads it
+	struct ThreadRing
+	{
+		TraceEvent events[RING_SIZE];
+		std::atomic<uint64_t> head{ 0 };
+		std::atomic<const char*> threadName{ nullptr };
+		uint32_t threadId = 0;
+	};
+
+	std::atomic<bool> gTraceEnabled(false);
+	const std::chrono::steady_clock::time_point gTraceStart = std::chrono::steady_clock::now();
+
+	// Rings are registered once per thread and never freed, so a thread exiting
+	// before the dump does not lose its events
+	std::mutex gRingsMutex;
+	std::vector<std::unique_ptr<ThreadRing>> gRings;
+
+	thread_local ThreadRing* tRing = nullptr;
+
+	ThreadRing* UGetThreadRing()
+	{
+		if (tRing == nullptr)
+		{
+			std::unique_ptr<ThreadRing> ring(new ThreadRing());
+			std::lock_guard<std::mutex> lock(gRingsMutex);
+			ring->threadId = (uint32_t)gRings.size() + 1;
+			tRing = ring.get();
+			gRings.push_back(std::move(ring));
+		}
+		return tRing;
+	}
+
+	void URecord(char phase, const char* name, const char* detail)
+	{
+		ThreadRing* ring = UGetThreadRing();
+		uint64_t head = ring->head.load(std::memory_order_relaxed);
+
+		TraceEvent& event = ring->events[head & (RING_SIZE - 1)];
+		event.name = name;
+		event.detail = detail;
+		event.timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - gTraceStart).count();
+		event.phase = phase;
+
+		// Publish the event to the exporter
+		ring->head.store(head + 1, std::memory_order_release);
+	}
+
+	// Copies the events of one ring that are guaranteed not to have been overwritten while copying
+	void UCopyRing(ThreadRing& ring, std::vector<TraceEvent>& out)
+	{
+		uint64_t last = ring.head.load(std::memory_order_acquire);
+		uint64_t first = last > RING_SIZE ? last - RING_SIZE : 0;
+
+		std::vector<TraceEvent> copied;
+		copied.reserve((size_t)(last - first));
+		for (uint64_t i = first; i < last; ++i)
+			copied.push_back(ring.events[i & (RING_SIZE - 1)]);
+
+		// The owner may have lapped us while copying; drop anything it could have touched
+		uint64_t headAfter = ring.head.load(std::memory_order_acquire);
+		uint64_t validFirst = headAfter > RING_SIZE ? headAfter - RING_SIZE : 0;
+		if (headAfter > last)
+			validFirst += 1; // the slot being written right now
+		uint64_t skip = validFirst > first ? validFirst - first : 0;
+
+		// Drop end events whose begin was lost to wrap-around so nesting stays balanced
+		int depth = 0;
+		for (size_t i = (size_t)skip; i < copied.size(); ++i)
+		{
+			if (copied[i].phase == 'B')
+				++depth;
+			else if (depth == 0)
+				continue;
+			else
+				--depth;
+			out.push_back(copied[i]);
+		}
+	}
+
+	void UWriteJsonString(std::ofstream& file, const char* text)
+	{
+		file << '"';
+		for (const char* c = text; *c; ++c)
+		{
+			if (*c == '"' || *c == '\\')
+				file << '\\' << *c;
+			else if ((unsigned char)*c < 0x20)
+				file << ' ';
+			else
+				file << *c;
+		}
+		file << '"';
+	}
+}
+
+namespace Trace
+{
+	void SetEnabled(bool enabled)
+	{
+		gTraceEnabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool IsEnabled()
+	{
+		return gTraceEnabled.load(std::memory_order_relaxed);
+	}
+
+	void SetThreadName(const char* name)
+	{
+		UGetThreadRing()->threadName.store(name, std::memory_order_release);
+	}
+
+	void Begin(const char* name, const char* detail)
+	{
+		if (gTraceEnabled.load(std::memory_order_relaxed))
+			URecord('B', name, detail);
+	}
+
+	void End()
+	{
+		if (gTraceEnabled.load(std::memory_order_relaxed))
+			URecord('E', nullptr, nullptr);
+	}
+
+	bool WriteChromeJson(const char* filename)
+	{
+		std::ofstream file(filename);
+		if (!file)
+			return false;
+
+		std::vector<ThreadRing*> rings;
+		{
+			std::lock_guard<std::mutex> lock(gRingsMutex);
+			for (auto& ring : gRings)
+				rings.push_back(ring.get());
+		}
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"ACFinal\"}}";
+
+		std::vector<TraceEvent> events;
+		for (ThreadRing* ring : rings)
+		{
+			const char* threadName = ring->threadName.load(std::memory_order_acquire);
+			if (threadName)
+			{
+				file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadId << ",\"args\":{\"name\":";
+				UWriteJsonString(file, threadName);
+				file << "}}";
+			}
+
+			events.clear();
+			UCopyRing(*ring, events);
+			for (const TraceEvent& event : events)
+			{
+				char ts[32];
+				snprintf(ts, sizeof(ts), "%.3f", event.timestamp / 1000.0); // microseconds
+
+				file << ",\n{\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << ring->threadId << ",\"ts\":" << ts;
+				if (event.phase == 'B')
+				{
+					file << ",\"name\":";
+					UWriteJsonString(file, event.name);
+					if (event.detail)
+					{
+						file << ",\"args\":{\"detail\":";
+						UWriteJsonString(file, event.detail);
+						file << "}";
+					}
+				}
+				file << "}";
+			}
+		}
+
+		file << "\n]}\n";
+		return (bool)file;
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+// Frame timeline tracing. Every thread records begin/end events into its own
+// fixed-size ring buffer without taking a lock; WriteChromeJson dumps whatever
+// is still held in the rings as Chrome trace event JSON (Perfetto, chrome://tracing).
+//
+// Event names and details are stored by pointer, so they must be string
+// literals or otherwise outlive the trace.
+namespace Trace
+{
+	void SetEnabled(bool enabled);
+	bool IsEnabled();
+
+	// Names the calling thread in the exported timeline
+	void SetThreadName(const char* name);
+
+	void Begin(const char* name, const char* detail = nullptr);
+	void End();
+
+	// Writes all recorded events to filename, returns false if the file could not be written
+	bool WriteChromeJson(const char* filename);
+
+	// Records a begin event on construction and the matching end event on destruction
+	class Scope
+	{
+	public:
+		explicit Scope(const char* name, const char* detail = nullptr)
+		{
+			Begin(name, detail);
+		}
+		~Scope()
+		{
+			End();
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(...) Trace::Scope TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
@@ -0,0 +1,480 @@
+#include "transforms.h"
+
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TRANSFORMS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TRANSFORMS_AVX2_TARGET
+#else
+#include <cpuid.h>
+#define TRANSFORMS_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#else
+#define TRANSFORMS_X86 0
+#endif
+
+Transform Transform::FromAngleAxis(const glm::vec3& translation, float angle, const glm::vec3& axis, const glm::vec3& scale)
+{
+	Transform transform;
+	transform.translation = translation;
+	transform.rotation = glm::angleAxis(angle, glm::normalize(axis));
+	transform.scale = scale;
+	return transform;
+}
+
+glm::mat4 Transform::Matrix() const
+{
+	// translation * rotation * scale without the two full matrix products
+	glm::mat4 matrix = glm::mat4_cast(rotation);
+	matrix[0] *= scale.x;
+	matrix[1] *= scale.y;
+	matrix[2] *= scale.z;
+	matrix[3] = glm::vec4(translation, 1.0f);
+	return matrix;
+}
+
+namespace
+{
+	// All paths evaluate the same expressions in the same order, without fused
+	// multiply-adds, so they agree with each other to the last bit
+	void UComposeScalar(const Transforms::TransformSoA& t, int begin, int end, float* out)
+	{
+		for (int i = begin; i < end; ++i)
+		{
+			float x = t.qx[i], y = t.qy[i], z = t.qz[i], w = t.qw[i];
+			float xx = x * x, yy = y * y, zz = z * z;
+			float xy = x * y, xz = x * z, yz = y * z;
+			float wx = w * x, wy = w * y, wz = w * z;
+
+			float* m = out + 16 * i;
+			m[0] = (1.0f - 2.0f * (yy + zz)) * t.sx[i];
+			m[1] = 2.0f * (xy + wz) * t.sx[i];
+			m[2] = 2.0f * (xz - wy) * t.sx[i];
+			m[3] = 0.0f;
+			m[4] = 2.0f * (xy - wz) * t.sy[i];
+			m[5] = (1.0f - 2.0f * (xx + zz)) * t.sy[i];
+			m[6] = 2.0f * (yz + wx) * t.sy[i];
+			m[7] = 0.0f;
+			m[8] = 2.0f * (xz + wy) * t.sz[i];
+			m[9] = 2.0f * (yz - wx) * t.sz[i];
+			m[10] = (1.0f - 2.0f * (xx + yy)) * t.sz[i];
+			m[11] = 0.0f;
+			m[12] = t.px[i];
+			m[13] = t.py[i];
+			m[14] = t.pz[i];
+			m[15] = 1.0f;
+		}
+	}
+
+#if TRANSFORMS_X86
+	// Turns column c of 4 objects, held as one register per component, into one store per object
+	inline void UStoreColumnSse(__m128 cx, __m128 cy, __m128 cz, __m128 cw, float* out, int column)
+	{
+		_MM_TRANSPOSE4_PS(cx, cy, cz, cw);
+		_mm_storeu_ps(out + 4 * column, cx);
+		_mm_storeu_ps(out + 16 + 4 * column, cy);
+		_mm_storeu_ps(out + 32 + 4 * column, cz);
+		_mm_storeu_ps(out + 48 + 4 * column, cw);
+	}
+
+	// Composes 4 objects at a time, returns the first index it did not handle
+	int UComposeSse(const Transforms::TransformSoA& t, int begin, int end, float* out)
+	{
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 two = _mm_set1_ps(2.0f);
+		const __m128 zero = _mm_setzero_ps();
+
+		int i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(&t.qx[i]);
+			__m128 y = _mm_loadu_ps(&t.qy[i]);
+			__m128 z = _mm_loadu_ps(&t.qz[i]);
+			__m128 w = _mm_loadu_ps(&t.qw[i]);
+			__m128 sx = _mm_loadu_ps(&t.sx[i]);
+			__m128 sy = _mm_loadu_ps(&t.sy[i]);
+			__m128 sz = _mm_loadu_ps(&t.sz[i]);
+
+			__m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+			__m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+			__m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+			__m128 m00 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx);
+			__m128 m01 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx);
+			__m128 m02 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx);
+			__m128 m10 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy);
+			__m128 m11 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy);
+			__m128 m12 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy);
+			__m128 m20 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz);
+			__m128 m21 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz);
+			__m128 m22 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz);
+
+			float* m = out + 16 * i;
+			UStoreColumnSse(m00, m01, m02, zero, m, 0);
+			UStoreColumnSse(m10, m11, m12, zero, m, 1);
+			UStoreColumnSse(m20, m21, m22, zero, m, 2);
+			UStoreColumnSse(_mm_loadu_ps(&t.px[i]), _mm_loadu_ps(&t.py[i]), _mm_loadu_ps(&t.pz[i]), one, m, 3);
+		}
+		return i;
+	}
+
+	// 4x4 transposes in both 128-bit lanes: column c of objects 0-3 ends up in the low
+	// halves of the results, column c of objects 4-7 in the high halves
+	TRANSFORMS_AVX2_TARGET inline void UTransposeAvx(__m256& a, __m256& b, __m256& c, __m256& d)
+	{
+		__m256 t0 = _mm256_unpacklo_ps(a, b);
+		__m256 t1 = _mm256_unpackhi_ps(a, b);
+		__m256 t2 = _mm256_unpacklo_ps(c, d);
+		__m256 t3 = _mm256_unpackhi_ps(c, d);
+		a = _mm256_shuffle_ps(t0, t2, 0x44);
+		b = _mm256_shuffle_ps(t0, t2, 0xEE);
+		c = _mm256_shuffle_ps(t1, t3, 0x44);
+		d = _mm256_shuffle_ps(t1, t3, 0xEE);
+	}
+
+	// Stores two columns of 8 objects; each object gets its two columns in one 256-bit store
+	TRANSFORMS_AVX2_TARGET inline void UStoreColumnPairAvx(__m256 a[4], __m256 b[4], float* out, int firstColumn)
+	{
+		for (int k = 0; k < 4; ++k)
+		{
+			_mm256_storeu_ps(out + 16 * k + 4 * firstColumn, _mm256_permute2f128_ps(a[k], b[k], 0x20));
+			_mm256_storeu_ps(out + 16 * (k + 4) + 4 * firstColumn, _mm256_permute2f128_ps(a[k], b[k], 0x31));
+		}
+	}
+
+	// Composes 8 objects at a time, returns the first index it did not handle
+	TRANSFORMS_AVX2_TARGET int UComposeAvx2(const Transforms::TransformSoA& t, int begin, int end, float* out)
+	{
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 two = _mm256_set1_ps(2.0f);
+		const __m256 zero = _mm256_setzero_ps();
+
+		int i = begin;
+		for (; i + 8 <= end; i += 8)
+		{
+			__m256 x = _mm256_loadu_ps(&t.qx[i]);
+			__m256 y = _mm256_loadu_ps(&t.qy[i]);
+			__m256 z = _mm256_loadu_ps(&t.qz[i]);
+			__m256 w = _mm256_loadu_ps(&t.qw[i]);
+			__m256 sx = _mm256_loadu_ps(&t.sx[i]);
+			__m256 sy = _mm256_loadu_ps(&t.sy[i]);
+			__m256 sz = _mm256_loadu_ps(&t.sz[i]);
+
+			__m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+			__m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+			__m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+			__m256 c0[4] =
+			{
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), sx),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx),
+				zero
+			};
+			__m256 c1[4] =
+			{
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy),
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), sy),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy),
+				zero
+			};
+			__m256 c2[4] =
+			{
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz),
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))), sz),
+				zero
+			};
+			__m256 c3[4] =
+			{
+				_mm256_loadu_ps(&t.px[i]),
+				_mm256_loadu_ps(&t.py[i]),
+				_mm256_loadu_ps(&t.pz[i]),
+				one
+			};
+
+			UTransposeAvx(c0[0], c0[1], c0[2], c0[3]);
+			UTransposeAvx(c1[0], c1[1], c1[2], c1[3]);
+			UTransposeAvx(c2[0], c2[1], c2[2], c2[3]);
+			UTransposeAvx(c3[0], c3[1], c3[2], c3[3]);
+
+			float* m = out + 16 * i;
+			UStoreColumnPairAvx(c0, c1, m, 0);
+			UStoreColumnPairAvx(c2, c3, m, 2);
+		}
+		return i;
+	}
+
+	void UCpuid(int info[4], int leaf, int subleaf)
+	{
+#ifdef _MSC_VER
+		__cpuidex(info, leaf, subleaf);
+#else
+		unsigned a, b, c, d;
+		__cpuid_count(leaf, subleaf, a, b, c, d);
+		info[0] = (int)a;
+		info[1] = (int)b;
+		info[2] = (int)c;
+		info[3] = (int)d;
+#endif
+	}
+
+	// Register state the OS saves on context switches
+	unsigned long long UXgetbv()
+	{
+#ifdef _MSC_VER
+		return _xgetbv(0);
+#else
+		unsigned eax, edx;
+		__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return ((unsigned long long)edx << 32) | eax;
+#endif
+	}
+#endif
+
+	Transforms::Path UDetectPath()
+	{
+#if TRANSFORMS_X86
+		int info[4];
+		UCpuid(info, 0, 0);
+		int maxLeaf = info[0];
+
+		UCpuid(info, 1, 0);
+		bool sse2 = (info[3] & (1 << 26)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+
+		// AVX registers are only usable when the OS saves the YMM state
+		if (maxLeaf >= 7 && osxsave && avx && (UXgetbv() & 0x6) == 0x6)
+		{
+			UCpuid(info, 7, 0);
+			if (info[1] & (1 << 5))
+				return Transforms::PATH_AVX2;
+		}
+		if (sse2)
+			return Transforms::PATH_SSE;
+#endif
+		return Transforms::PATH_SCALAR;
+	}
+}
+
+namespace Transforms
+{
+	int TransformSoA::Size() const
+	{
+		return (int)px.size();
+	}
+
+	void TransformSoA::Resize(int count)
+	{
+		px.resize(count); py.resize(count); pz.resize(count);
+		qx.resize(count); qy.resize(count); qz.resize(count); qw.resize(count, 1.0f);
+		sx.resize(count, 1.0f); sy.resize(count, 1.0f); sz.resize(count, 1.0f);
+	}
+
+	void TransformSoA::PushBack(const Transform& transform)
+	{
+		Resize(Size() + 1);
+		Set(Size() - 1, transform);
+	}
+
+	void TransformSoA::Set(int index, const Transform& transform)
+	{
+		px[index] = transform.translation.x;
+		py[index] = transform.translation.y;
+		pz[index] = transform.translation.z;
+		qx[index] = transform.rotation.x;
+		qy[index] = transform.rotation.y;
+		qz[index] = transform.rotation.z;
+		qw[index] = transform.rotation.w;
+		sx[index] = transform.scale.x;
+		sy[index] = transform.scale.y;
+		sz[index] = transform.scale.z;
+	}
+
+	Transform TransformSoA::Get(int index) const
+	{
+		Transform transform;
+		transform.translation = glm::vec3(px[index], py[index], pz[index]);
+		transform.rotation = glm::quat(qw[index], qx[index], qy[index], qz[index]);
+		transform.scale = glm::vec3(sx[index], sy[index], sz[index]);
+		return transform;
+	}
+
+	bool IsSupported(Path path)
+	{
+		return path <= BestPath();
+	}
+
+	const char* PathName(Path path)
+	{
+		switch (path)
+		{
+		case PATH_SSE: return "SSE";
+		case PATH_AVX2: return "AVX2";
+		default: return "scalar";
+		}
+	}
+
+	Path BestPath()
+	{
+		static const Path path = UDetectPath();
+		return path;
+	}
+
+	void ComposeMatrices(const TransformSoA& transforms, int begin, int end, glm::mat4* matrices)
+	{
+		ComposeMatrices(transforms, begin, end, matrices, BestPath());
+	}
+
+	void ComposeMatrices(const TransformSoA& transforms, int begin, int end, glm::mat4* matrices, Path path)
+	{
+		float* out = (float*)matrices;
+
+		// Wide batches first, the remainder goes down to the narrower paths
+#if TRANSFORMS_X86
+		if (path >= PATH_AVX2 && IsSupported(PATH_AVX2))
+			begin = UComposeAvx2(transforms, begin, end, out);
+		if (path >= PATH_SSE && IsSupported(PATH_SSE))
+			begin = UComposeSse(transforms, begin, end, out);
+#endif
+		UComposeScalar(transforms, begin, end, out);
+	}
+}
+
+// Benchmark
+// ---------
+namespace
+{
+	struct BenchmarkObject
+	{
+		glm::vec3 translation;
+		float angle;
+		glm::vec3 axis;
+		glm::vec3 scale;
+	};
+
+	double UBestNsPerObject(int count, int repeats, void (*compose)(void*), void* context)
+	{
+		double best = 1.0e30;
+		for (int run = 0; run < 3; ++run)
+		{
+			auto start = std::chrono::steady_clock::now();
+			for (int repeat = 0; repeat < repeats; ++repeat)
+				compose(context);
+			double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			best = std::min(best, ns / ((double)count * repeats));
+		}
+		return best;
+	}
+
+	struct BenchmarkContext
+	{
+		const std::vector<BenchmarkObject>* objects;
+		const Transforms::TransformSoA* transforms;
+		std::vector<glm::mat4>* matrices;
+		Transforms::Path path;
+	};
+
+	// The way URender composed model matrices before the scene graph
+	void UComposeGlm(void* data)
+	{
+		BenchmarkContext* context = (BenchmarkContext*)data;
+		const std::vector<BenchmarkObject>& objects = *context->objects;
+		glm::mat4* matrices = context->matrices->data();
+		for (size_t i = 0; i < objects.size(); ++i)
+		{
+			glm::mat4 scale = glm::scale(objects[i].scale);
+			glm::mat4 rotation = glm::rotate(objects[i].angle, objects[i].axis);
+			glm::mat4 translation = glm::translate(objects[i].translation);
+			matrices[i] = translation * rotation * scale;
+		}
+	}
+
+	void UComposeBatched(void* data)
+	{
+		BenchmarkContext* context = (BenchmarkContext*)data;
+		Transforms::ComposeMatrices(*context->transforms, 0, context->transforms->Size(), context->matrices->data(), context->path);
+	}
+
+	float UMaxDifference(const std::vector<glm::mat4>& a, const std::vector<glm::mat4>& b)
+	{
+		float difference = 0.0f;
+		const float* fa = (const float*)a.data();
+		const float* fb = (const float*)b.data();
+		for (size_t i = 0; i < a.size() * 16; ++i)
+			difference = std::max(difference, std::fabs(fa[i] - fb[i]));
+		return difference;
+	}
+}
+
+namespace Transforms
+{
+	void RunBenchmark()
+	{
+		const int SIZES[] = { 1000, 10000, 100000, 1000000 };
+
+		std::cout << "Transform composition benchmark, best path " << PathName(BestPath()) << std::endl;
+		std::cout << "objects     glm ns/obj  scalar ns/obj     SSE ns/obj    AVX2 ns/obj  speedup  max error" << std::endl;
+
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> positive(0.1f, 4.0f);
+
+		for (int count : SIZES)
+		{
+			std::vector<BenchmarkObject> objects(count);
+			TransformSoA transforms;
+			transforms.Resize(count);
+			for (int i = 0; i < count; ++i)
+			{
+				BenchmarkObject& object = objects[i];
+				object.translation = glm::vec3(unit(random), unit(random), unit(random)) * 10.0f;
+				object.angle = unit(random) * 3.14159265f;
+				object.axis = glm::vec3(unit(random), unit(random), unit(random) + 2.0f);
+				object.scale = glm::vec3(positive(random), positive(random), positive(random));
+				transforms.Set(i, Transform::FromAngleAxis(object.translation, object.angle, object.axis, object.scale));
+			}
+
+			// Enough repeats that small sizes are not dominated by timer resolution
+			int repeats = std::max(1, 4000000 / count);
+
+			std::vector<glm::mat4> reference(count);
+			std::vector<glm::mat4> matrices(count);
+			BenchmarkContext context = { &objects, &transforms, &reference, PATH_SCALAR };
+			double glmNs = UBestNsPerObject(count, repeats, UComposeGlm, &context);
+
+			double pathNs[PATH_COUNT] = {};
+			float maxError = 0.0f;
+			for (int path = 0; path < PATH_COUNT; ++path)
+			{
+				if (!IsSupported((Path)path))
+					continue;
+				context.matrices = &matrices;
+				context.path = (Path)path;
+				pathNs[path] = UBestNsPerObject(count, repeats, UComposeBatched, &context);
+				maxError = std::max(maxError, UMaxDifference(reference, matrices));
+			}
+
+			char line[160];
+			char sse[16] = "n/a", avx2[16] = "n/a";
+			if (IsSupported(PATH_SSE))
+				snprintf(sse, sizeof(sse), "%.2f", pathNs[PATH_SSE]);
+			if (IsSupported(PATH_AVX2))
+				snprintf(avx2, sizeof(avx2), "%.2f", pathNs[PATH_AVX2]);
+			snprintf(line, sizeof(line), "%7d  %13.2f  %13.2f  %13s  %13s  %6.1fx  %9.2e",
+				count, glmNs, pathNs[PATH_SCALAR], sse, avx2, glmNs / pathNs[BestPath()], maxError);
+			std::cout << line << std::endl;
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+// Hands per-frame snapshots from one producer thread to one consumer thread.
+// There are three slots: one being written by the producer, one published and
+// waiting, and one being read by the consumer. Neither side ever touches a slot
+// the other is using, so a snapshot cannot change while it is being read.
+// Publishing replaces a waiting snapshot the consumer has not picked up yet, so
+// the consumer always gets the newest one.
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer()
+		: mWrite(0), mPending(1), mRead(2), mHasPending(false), mClosed(false)
+	{
+	}
+
+	TripleBuffer(const TripleBuffer&) = delete;
+	TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+	// Producer: the slot to fill in for the next publish
+	T& WriteSlot()
+	{
+		return mSlots[mWrite];
+	}
+
+	// Producer: makes the write slot the newest snapshot
+	void Publish()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			std::swap(mWrite, mPending);
+			mHasPending = true;
+		}
+		mChanged.notify_all();
+	}
+
+	// Producer: waits until the consumer has picked up the last published snapshot,
+	// which keeps the producer at most one frame ahead of the consumer
+	void WaitUntilTaken()
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mChanged.wait(lock, [this] { return !mHasPending || mClosed; });
+	}
+
+	// Consumer: waits for a snapshot newer than the one last acquired, returns
+	// nullptr once the buffer has been closed. The snapshot stays valid until
+	// the next call.
+	const T* Acquire()
+	{
+		const T* snapshot = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mChanged.wait(lock, [this] { return mHasPending || mClosed; });
+			if (mClosed)
+				return nullptr;
+
+			std::swap(mRead, mPending);
+			mHasPending = false;
+			snapshot = &mSlots[mRead];
+		}
+		mChanged.notify_all();
+		return snapshot;
+	}
+
+	// Wakes both sides and makes Acquire return nullptr from now on
+	void Close()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mClosed = true;
+		}
+		mChanged.notify_all();
+	}
+
+private:
+	T mSlots[3];
+	int mWrite;
+	int mPending;
+	int mRead;
+	bool mHasPending;
+	bool mClosed;
+	std::mutex mMutex;
+	std::condition_variable mChanged;
+};
@@ -0,0 +1,403 @@
+#include "vertexcompression.h"
+
+#include <GL/glew.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+	const float RADIANS_TO_DEGREES = 57.2957795f;
+
+	struct Attributes
+	{
+		const MeshPack::VertexAttribute* position;
+		const MeshPack::VertexAttribute* normal;
+		const MeshPack::VertexAttribute* uv;
+	};
+
+	const MeshPack::VertexAttribute* UFindAttribute(const MeshPack::VertexFormat& format, uint32_t location)
+	{
+		for (uint32_t i = 0; i < format.attributeCount; ++i)
+		{
+			if (format.attributes[i].location == location)
+				return &format.attributes[i];
+		}
+		return nullptr;
+	}
+
+	Attributes UFindAttributes(const MeshPack::VertexFormat& format)
+	{
+		Attributes attributes;
+		attributes.position = UFindAttribute(format, 0);
+		attributes.normal = UFindAttribute(format, 1);
+		attributes.uv = UFindAttribute(format, 2);
+		return attributes;
+	}
+
+	// The format Encode writes; every attribute starts on a 4 byte boundary
+	MeshPack::VertexFormat UFormatFor(bool hasNormal, bool hasUV, const VertexCompression::Encoding& encoding)
+	{
+		MeshPack::VertexFormat format = {};
+		uint32_t offset = 0;
+
+		if (encoding.position == VertexCompression::POSITION_UNORM16)
+		{
+			format.attributes[format.attributeCount++] = { 0, 3, GL_UNSIGNED_SHORT, GL_TRUE, offset };
+			offset += 8; // padded
+		}
+		else
+		{
+			format.attributes[format.attributeCount++] = { 0, 3, GL_FLOAT, GL_FALSE, offset };
+			offset += 12;
+		}
+
+		if (hasNormal)
+		{
+			if (encoding.normal == VertexCompression::NORMAL_OCTAHEDRAL16)
+			{
+				format.attributes[format.attributeCount++] = { 1, 2, GL_SHORT, GL_TRUE, offset };
+				offset += 4;
+			}
+			else if (encoding.normal == VertexCompression::NORMAL_INT_2_10_10_10)
+			{
+				format.attributes[format.attributeCount++] = { 1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offset };
+				offset += 4;
+			}
+			else
+			{
+				format.attributes[format.attributeCount++] = { 1, 3, GL_FLOAT, GL_FALSE, offset };
+				offset += 12;
+			}
+		}
+
+		if (hasUV)
+		{
+			if (encoding.uv == VertexCompression::UV_HALF)
+			{
+				format.attributes[format.attributeCount++] = { 2, 2, GL_HALF_FLOAT, GL_FALSE, offset };
+				offset += 4;
+			}
+			else
+			{
+				format.attributes[format.attributeCount++] = { 2, 2, GL_FLOAT, GL_FALSE, offset };
+				offset += 8;
+			}
+		}
+
+		format.stride = offset;
+		return format;
+	}
+
+	float UClamp(float value, float low, float high)
+	{
+		return value < low ? low : (value > high ? high : value);
+	}
+
+	// GL's signed normalized conversions: c / (2^(b-1) - 1), clamped to -1
+	int32_t UToSnorm(float value, float maximum)
+	{
+		return (int32_t)floorf(UClamp(value, -1.0f, 1.0f) * maximum + 0.5f);
+	}
+
+	float UFromSnorm(int32_t value, float maximum)
+	{
+		float result = (float)value / maximum;
+		return result < -1.0f ? -1.0f : result;
+	}
+
+	void UNormalize(float vector[3])
+	{
+		float length = sqrtf(vector[0] * vector[0] + vector[1] * vector[1] + vector[2] * vector[2]);
+		if (length > 0.0f)
+		{
+			vector[0] /= length;
+			vector[1] /= length;
+			vector[2] /= length;
+		}
+	}
+
+	// Same unfolding as the vertex shader
+	void UDecodeOctahedral(float x, float y, float normal[3])
+	{
+		normal[0] = x;
+		normal[1] = y;
+		normal[2] = 1.0f - fabsf(x) - fabsf(y);
+		float t = normal[2] < 0.0f ? -normal[2] : 0.0f;
+		normal[0] += normal[0] >= 0.0f ? -t : t;
+		normal[1] += normal[1] >= 0.0f ? -t : t;
+		UNormalize(normal);
+	}
+
+	// atan2 of the cross and dot products stays accurate for tiny angles, where acos does not
+	float UAngleDegrees(const float a[3], const float b[3])
+	{
+		float cross[3] = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+		float sine = sqrtf(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+		return atan2f(sine, a[0] * b[0] + a[1] * b[1] + a[2] * b[2]) * RADIANS_TO_DEGREES;
+	}
+
+	// Projects the unit normal onto the octahedron and folds the lower half over. Of the
+	// four quantized points around the projection, the one decoding closest is kept.
+	void UEncodeOctahedral(const float normal[3], int16_t encoded[2])
+	{
+		float length = fabsf(normal[0]) + fabsf(normal[1]) + fabsf(normal[2]);
+		if (length == 0.0f)
+		{
+			encoded[0] = 0;
+			encoded[1] = 0;
+			return;
+		}
+		float x = normal[0] / length;
+		float y = normal[1] / length;
+		if (normal[2] < 0.0f)
+		{
+			float foldedX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			float foldedY = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			x = foldedX;
+			y = foldedY;
+		}
+
+		float baseX = floorf(UClamp(x, -1.0f, 1.0f) * 32767.0f);
+		float baseY = floorf(UClamp(y, -1.0f, 1.0f) * 32767.0f);
+		float bestAngle = 1.0e9f;
+		for (int i = 0; i < 4; ++i)
+		{
+			int32_t qx = (int32_t)UClamp(baseX + (float)(i & 1), -32767.0f, 32767.0f);
+			int32_t qy = (int32_t)UClamp(baseY + (float)(i >> 1), -32767.0f, 32767.0f);
+			float decoded[3];
+			UDecodeOctahedral(UFromSnorm(qx, 32767.0f), UFromSnorm(qy, 32767.0f), decoded);
+			float angle = UAngleDegrees(normal, decoded);
+			if (angle < bestAngle)
+			{
+				bestAngle = angle;
+				encoded[0] = (int16_t)qx;
+				encoded[1] = (int16_t)qy;
+			}
+		}
+	}
+}
+
+namespace VertexCompression
+{
+	void Encode(const MeshPack::MeshView& source, const Encoding& encoding, std::vector<uint8_t>& vertices, MeshPack::MeshView& encoded, Error& error)
+	{
+		Attributes sourceAttributes = UFindAttributes(source.format);
+		bool hasNormal = sourceAttributes.normal != nullptr;
+		bool hasUV = sourceAttributes.uv != nullptr;
+
+		encoded = source;
+		encoded.format = UFormatFor(hasNormal, hasUV, encoding);
+		Attributes encodedAttributes = UFindAttributes(encoded.format);
+		vertices.assign((size_t)source.vertexCount * encoded.format.stride, 0);
+		encoded.vertices = vertices.data();
+
+		float extent[3];
+		for (int axis = 0; axis < 3; ++axis)
+			extent[axis] = source.boundsMax[axis] - source.boundsMin[axis];
+
+		error = Error();
+		double positionSquaredSum = 0.0;
+		double normalAngleSum = 0.0;
+		int normalCount = 0;
+		for (uint32_t v = 0; v < source.vertexCount; ++v)
+		{
+			const uint8_t* in = (const uint8_t*)source.vertices + (size_t)v * source.format.stride;
+			uint8_t* out = vertices.data() + (size_t)v * encoded.format.stride;
+
+			float position[3];
+			memcpy(position, in + sourceAttributes.position->offset, sizeof(position));
+			float decodedPosition[3];
+			if (encoding.position == POSITION_UNORM16)
+			{
+				uint16_t quantized[3];
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					float unit = extent[axis] > 0.0f ? (position[axis] - source.boundsMin[axis]) / extent[axis] : 0.0f;
+					quantized[axis] = (uint16_t)floorf(UClamp(unit, 0.0f, 1.0f) * 65535.0f + 0.5f);
+					decodedPosition[axis] = source.boundsMin[axis] + (float)quantized[axis] / 65535.0f * extent[axis];
+				}
+				memcpy(out + encodedAttributes.position->offset, quantized, sizeof(quantized));
+			}
+			else
+			{
+				memcpy(decodedPosition, position, sizeof(position));
+				memcpy(out + encodedAttributes.position->offset, position, sizeof(position));
+			}
+
+			float distanceSquared = 0.0f;
+			for (int axis = 0; axis < 3; ++axis)
+				distanceSquared += (decodedPosition[axis] - position[axis]) * (decodedPosition[axis] - position[axis]);
+			positionSquaredSum += distanceSquared;
+			if (sqrtf(distanceSquared) > error.positionMax)
+				error.positionMax = sqrtf(distanceSquared);
+
+			if (hasNormal)
+			{
+				float normal[3];
+				memcpy(normal, in + sourceAttributes.normal->offset, sizeof(normal));
+				float decodedNormal[3];
+				if (encoding.normal == NORMAL_OCTAHEDRAL16)
+				{
+					UNormalize(normal);
+					int16_t octahedral[2];
+					UEncodeOctahedral(normal, octahedral);
+					memcpy(out + encodedAttributes.normal->offset, octahedral, sizeof(octahedral));
+					UDecodeOctahedral(UFromSnorm(octahedral[0], 32767.0f), UFromSnorm(octahedral[1], 32767.0f), decodedNormal);
+				}
+				else if (encoding.normal == NORMAL_INT_2_10_10_10)
+				{
+					UNormalize(normal);
+					int32_t x = UToSnorm(normal[0], 511.0f);
+					int32_t y = UToSnorm(normal[1], 511.0f);
+					int32_t z = UToSnorm(normal[2], 511.0f);
+					uint32_t packed = (uint32_t)(x & 0x3FF) | ((uint32_t)(y & 0x3FF) << 10) | ((uint32_t)(z & 0x3FF) << 20);
+					memcpy(out + encodedAttributes.normal->offset, &packed, sizeof(packed));
+					decodedNormal[0] = UFromSnorm(x, 511.0f);
+					decodedNormal[1] = UFromSnorm(y, 511.0f);
+					decodedNormal[2] = UFromSnorm(z, 511.0f);
+				}
+				else
+				{
+					memcpy(out + encodedAttributes.normal->offset, normal, sizeof(normal));
+					memcpy(decodedNormal, normal, sizeof(normal));
+				}
+
+				// The fragment shader renormalizes, so only the direction counts
+				UNormalize(normal);
+				UNormalize(decodedNormal);
+				if (normal[0] != 0.0f || normal[1] != 0.0f || normal[2] != 0.0f)
+				{
+					float angle = UAngleDegrees(normal, decodedNormal);
+					normalAngleSum += angle;
+					++normalCount;
+					if (angle > error.normalMaxDegrees)
+						error.normalMaxDegrees = angle;
+				}
+			}
+
+			if (hasUV)
+			{
+				float uv[2];
+				memcpy(uv, in + sourceAttributes.uv->offset, sizeof(uv));
+				if (encoding.uv == UV_HALF)
+				{
+					uint16_t half[2] = { FloatToHalf(uv[0]), FloatToHalf(uv[1]) };
+					memcpy(out + encodedAttributes.uv->offset, half, sizeof(half));
+					for (int i = 0; i < 2; ++i)
+					{
+						float difference = fabsf(HalfToFloat(half[i]) - uv[i]);
+						if (difference > error.uvMax)
+							error.uvMax = difference;
+					}
+				}
+				else
+				{
+					memcpy(out + encodedAttributes.uv->offset, uv, sizeof(uv));
+				}
+			}
+		}
+
+		if (source.vertexCount > 0)
+			error.positionRms = (float)sqrt(positionSquaredSum / source.vertexCount);
+		if (normalCount > 0)
+			error.normalMeanDegrees = (float)(normalAngleSum / normalCount);
+	}
+
+	bool Matches(const MeshPack::VertexFormat& format, const Encoding& encoding)
+	{
+		Attributes attributes = UFindAttributes(format);
+		MeshPack::VertexFormat expected = UFormatFor(attributes.normal != nullptr, attributes.uv != nullptr, encoding);
+		if (format.stride != expected.stride || format.attributeCount != expected.attributeCount)
+			return false;
+		for (uint32_t i = 0; i < format.attributeCount; ++i)
+		{
+			const MeshPack::VertexAttribute& a = format.attributes[i];
+			const MeshPack::VertexAttribute& b = expected.attributes[i];
+			if (a.location != b.location || a.components != b.components || a.type != b.type || a.normalized != b.normalized || a.offset != b.offset)
+				return false;
+		}
+		return true;
+	}
+
+	bool HasQuantizedPositions(const MeshPack::VertexFormat& format)
+	{
+		const MeshPack::VertexAttribute* position = UFindAttribute(format, 0);
+		return position && position->type == GL_UNSIGNED_SHORT;
+	}
+
+	bool HasOctahedralNormals(const MeshPack::VertexFormat& format)
+	{
+		const MeshPack::VertexAttribute* normal = UFindAttribute(format, 1);
+		return normal && normal->type == GL_SHORT && normal->components == 2;
+	}
+
+	uint32_t FloatStride(const MeshPack::VertexFormat& format)
+	{
+		Attributes attributes = UFindAttributes(format);
+		return (uint32_t)sizeof(float) * (3 + (attributes.normal ? 3 : 0) + (attributes.uv ? 2 : 0));
+	}
+
+	const char* Describe(const Encoding& encoding)
+	{
+		static const char* const names[2][3][2] =
+		{
+			{ { "float/float/float", "float/float/half" }, { "float/oct16/float", "float/oct16/half" }, { "float/2_10_10_10/float", "float/2_10_10_10/half" } },
+			{ { "unorm16/float/float", "unorm16/float/half" }, { "unorm16/oct16/float", "unorm16/oct16/half" }, { "unorm16/2_10_10_10/float", "unorm16/2_10_10_10/half" } }
+		};
+		return names[encoding.position][encoding.normal][encoding.uv];
+	}
+
+	// Rounds to nearest even; out of range values become infinity, tiny ones subnormals or zero
+	uint16_t FloatToHalf(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		uint32_t sign = (bits >> 16) & 0x8000;
+		uint32_t floatExponent = (bits >> 23) & 0xFF;
+		uint32_t mantissa = bits & 0x7FFFFF;
+		if (floatExponent == 0xFF)
+			return (uint16_t)(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+
+		int32_t exponent = (int32_t)floatExponent - 127 + 15;
+		if (exponent >= 31)
+			return (uint16_t)(sign | 0x7C00);
+		if (exponent <= 0)
+		{
+			if (exponent < -10)
+				return (uint16_t)sign;
+			mantissa |= 0x800000;
+			uint32_t shift = (uint32_t)(14 - exponent);
+			uint32_t half = mantissa >> shift;
+			uint32_t rest = mantissa & ((1u << shift) - 1);
+			uint32_t halfway = 1u << (shift - 1);
+			if (rest > halfway || (rest == halfway && (half & 1)))
+				++half;
+			return (uint16_t)(sign | half);
+		}
+
+		// A carry out of the mantissa correctly bumps the exponent
+		uint32_t half = ((uint32_t)exponent << 10) | (mantissa >> 13);
+		uint32_t rest = mantissa & 0x1FFF;
+		if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+			++half;
+		return (uint16_t)(sign | half);
+	}
+
+	float HalfToFloat(uint16_t value)
+	{
+		uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+		uint32_t exponent = (value >> 10) & 0x1F;
+		uint32_t mantissa = value & 0x3FF;
+		if (exponent == 0)
+		{
+			float magnitude = ldexpf((float)mantissa, -24);
+			return sign ? -magnitude : magnitude;
+		}
+
+		uint32_t bits = exponent == 31 ? (sign | 0x7F800000 | (mantissa << 13)) : (sign | ((exponent - 15 + 127) << 23) | (mantissa << 13));
+		float result;
+		memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "meshpack.h"
+
+#include <cstdint>
+#include <vector>
+
+// Compact vertex formats. Generators produce float positions, normals and UVs,
+// 32 bytes a vertex; each attribute can be stored smaller instead:
+//   positions  16-bit unsigned normalized across the mesh bounds, scaled and
+//              offset back to object space in the vertex shader
+//   normals    octahedral in two 16-bit signed normalized values, unfolded in
+//              the vertex shader, or GL_INT_2_10_10_10_REV read as a vec3
+//   UVs        half floats
+// which takes a full vertex down to 16 bytes.
+namespace VertexCompression
+{
+	enum PositionEncoding
+	{
+		POSITION_FLOAT,
+		POSITION_UNORM16
+	};
+
+	enum NormalEncoding
+	{
+		NORMAL_FLOAT,
+		NORMAL_OCTAHEDRAL16,
+		NORMAL_INT_2_10_10_10
+	};
+
+	enum UVEncoding
+	{
+		UV_FLOAT,
+		UV_HALF
+	};
+
+	struct Encoding
+	{
+		PositionEncoding position;
+		NormalEncoding normal;
+		UVEncoding uv;
+	};
+
+	const Encoding FLOAT_ENCODING = { POSITION_FLOAT, NORMAL_FLOAT, UV_FLOAT };
+
+	// Differences between the source attributes and what the shader decodes
+	struct Error
+	{
+		float positionMax;          // object-space units
+		float positionRms;
+		float normalMaxDegrees;
+		float normalMeanDegrees;
+		float uvMax;
+	};
+
+	// Re-encodes a float mesh with its position at location 0 and optionally a
+	// normal at 1 and UV at 2. encoded keeps the name, indices and bounds of
+	// source and points into vertices for the re-encoded data.
+	void Encode(const MeshPack::MeshView& source, const Encoding& encoding, std::vector<uint8_t>& vertices, MeshPack::MeshView& encoded, Error& error);
+
+	// Whether format is what Encode produces with encoding for a mesh with the same attributes
+	bool Matches(const MeshPack::VertexFormat& format, const Encoding& encoding);
+
+	// Positions are 16-bit normalized
+	bool HasQuantizedPositions(const MeshPack::VertexFormat& format);
+
+	// Normals are two octahedral components to unfold in the shader
+	bool HasOctahedralNormals(const MeshPack::VertexFormat& format);
+
+	// Stride of the same attributes stored as floats
+	uint32_t FloatStride(const MeshPack::VertexFormat& format);
+
+	// Short name such as "unorm16/oct16/half"
+	const char* Describe(const Encoding& encoding);
+
+	uint16_t FloatToHalf(float value);
+	float HalfToFloat(uint16_t value);
+}
@@ -0,0 +1,75 @@
+#include "vertexlayout.h"
+#include "glresources.h"
+
+#include <vector>
+
+namespace
+{
+	struct SharedArray
+	{
+		MeshPack::VertexFormat format;
+		GLuint vao;
+	};
+
+	std::vector<SharedArray> gShared;
+
+	bool USameAttributes(const MeshPack::VertexFormat& a, const MeshPack::VertexFormat& b)
+	{
+		if (a.attributeCount != b.attributeCount)
+			return false;
+		for (uint32_t i = 0; i < a.attributeCount; ++i)
+		{
+			const MeshPack::VertexAttribute& x = a.attributes[i];
+			const MeshPack::VertexAttribute& y = b.attributes[i];
+			if (x.location != y.location || x.components != y.components || x.type != y.type || x.normalized != y.normalized || x.offset != y.offset)
+				return false;
+		}
+		return true;
+	}
+
+	// Describes the attributes to a vertex array, all read from VERTEX_BINDING
+	void UApplyAttributes(GLuint vao, const MeshPack::VertexFormat& format)
+	{
+		for (uint32_t i = 0; i < format.attributeCount; ++i)
+		{
+			const MeshPack::VertexAttribute& attribute = format.attributes[i];
+			GLResources::SetAttribFormat(vao, attribute.location, attribute.components, attribute.type, attribute.normalized ? GL_TRUE : GL_FALSE,
+				attribute.offset, VertexLayout::VERTEX_BINDING);
+		}
+	}
+}
+
+namespace VertexLayout
+{
+	void Apply(GLuint vao, const MeshPack::VertexFormat& format, GLuint vertexBuffer)
+	{
+		UApplyAttributes(vao, format);
+		GLResources::SetVertexBuffer(vao, VERTEX_BINDING, vertexBuffer, 0, format.stride, 0);
+	}
+
+	GLuint Acquire(const MeshPack::VertexFormat& format)
+	{
+		for (const SharedArray& shared : gShared)
+		{
+			if (USameAttributes(shared.format, format))
+				return shared.vao;
+		}
+
+		SharedArray shared = { format, GLResources::CreateVertexArray() };
+		UApplyAttributes(shared.vao, format);
+		gShared.push_back(shared);
+		return shared.vao;
+	}
+
+	int SharedCount()
+	{
+		return (int)gShared.size();
+	}
+
+	void DestroyShared()
+	{
+		for (SharedArray& shared : gShared)
+			GLResources::DestroyVertexArray(shared.vao);
+		gShared.clear();
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+#include "meshpack.h"
+
+// Vertex formats described at compile time, and the vertex arrays that read them.
+//
+// A Layout lists its attributes as types; the stride and every offset follow from
+// the attribute sizes, so the data a generator writes and the format GL is given
+// cannot drift apart. Layouts produce the same MeshPack::VertexFormat the pack
+// and the vertex encodings use, which is what vertex arrays are made from.
+//
+// Vertex arrays are set up with separate attribute formats (glVertexAttribFormat
+// and glVertexAttribBinding), which keeps the buffer out of the format. Meshes of
+// the same format share one vertex array and bind only their own buffers to
+// VERTEX_BINDING before drawing.
+namespace VertexLayout
+{
+	// Buffer binding point the vertex attributes read from; the ones above are free for the caller
+	const GLuint VERTEX_BINDING = 0;
+
+	template <typename Component> struct ComponentType;
+	template <> struct ComponentType<GLfloat> { static constexpr GLenum VALUE = GL_FLOAT; };
+	template <> struct ComponentType<GLbyte> { static constexpr GLenum VALUE = GL_BYTE; };
+	template <> struct ComponentType<GLubyte> { static constexpr GLenum VALUE = GL_UNSIGNED_BYTE; };
+	template <> struct ComponentType<GLshort> { static constexpr GLenum VALUE = GL_SHORT; };
+	template <> struct ComponentType<GLushort> { static constexpr GLenum VALUE = GL_UNSIGNED_SHORT; };
+	template <> struct ComponentType<GLint> { static constexpr GLenum VALUE = GL_INT; };
+	template <> struct ComponentType<GLuint> { static constexpr GLenum VALUE = GL_UNSIGNED_INT; };
+
+	// Count components of one type read by the shader input at Location
+	template <GLuint Location, typename Component, int Count, bool Normalized = false>
+	struct Attribute
+	{
+		static_assert(Count >= 1 && Count <= 4, "attributes have 1 to 4 components");
+
+		static constexpr GLuint LOCATION = Location;
+		static constexpr uint32_t COMPONENTS = Count;
+		static constexpr GLenum TYPE = ComponentType<Component>::VALUE;
+		static constexpr bool NORMALIZED = Normalized;
+		static constexpr uint32_t SIZE = sizeof(Component) * Count;
+	};
+
+	// Attributes interleaved in the order given, tightly packed
+	template <typename... Attributes>
+	struct Layout
+	{
+		static_assert(sizeof...(Attributes) >= 1 && sizeof...(Attributes) <= MeshPack::MAX_ATTRIBUTES, "too many attributes for a vertex format");
+
+		static constexpr uint32_t STRIDE = (0 + ... + Attributes::SIZE);
+
+		static constexpr MeshPack::VertexFormat Format()
+		{
+			MeshPack::VertexFormat format = {};
+			format.stride = STRIDE;
+			uint32_t offset = 0;
+			((format.attributes[format.attributeCount++] = { Attributes::LOCATION, Attributes::COMPONENTS, Attributes::TYPE, Attributes::NORMALIZED ? 1u : 0u, offset },
+				offset += Attributes::SIZE), ...);
+			return format;
+		}
+	};
+
+	// The float layouts the mesh generators write: position at location 0, normal at 1, UV at 2
+	using Position = Layout<Attribute<0, GLfloat, 3>>;
+	using PositionUV = Layout<Attribute<0, GLfloat, 3>, Attribute<2, GLfloat, 2>>;
+	using Surface = Layout<Attribute<0, GLfloat, 3>, Attribute<1, GLfloat, 3>, Attribute<2, GLfloat, 2>>;
+
+	// Sets up a vertex array for a format and points VERTEX_BINDING at a vertex buffer,
+	// for a vertex array that belongs to a single mesh
+	void Apply(GLuint vao, const MeshPack::VertexFormat& format, GLuint vertexBuffer);
+
+	// The vertex array shared by every mesh of a format, created the first time it is
+	// asked for. Formats that differ only in stride share one, since the stride is
+	// given when the buffer is bound. No buffer is bound to it.
+	GLuint Acquire(const MeshPack::VertexFormat& format);
+
+	// Number of shared vertex arrays created so far
+	int SharedCount();
+
+	// Deletes the shared vertex arrays
+	void DestroyShared();
+}